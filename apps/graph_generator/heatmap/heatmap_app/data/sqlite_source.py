@@ -37,13 +37,15 @@ class SQLiteSource:
             SELECT p.id FROM projects p
             JOIN project_tree pt ON p.parent_id = pt.id
         )
-        SELECT tr.date, SUM(tr.duration) 
+        SELECT date(2440587.5 + tr.date), SUM(tr.duration) 
         FROM time_records tr
         JOIN project_tree pt ON tr.project_id = pt.id
-        WHERE SUBSTR(tr.date, 1, 4) = ?
+        WHERE tr.date BETWEEN CAST(julianday(? || '-01-01') - 2440587.5 AS INTEGER)
+                          AND CAST(julianday(? || '-12-31') - 2440587.5 AS INTEGER)
         GROUP BY tr.date;
         """
-        params = (project_name, str(year))
+        # date 列为 1970-01-01 起的天数，按年份换算为天数区间过滤
+        params = (project_name, str(year), str(year))
         rows = self._execute_query(query, params)
         data = {}
         for row in rows:
@@ -61,8 +63,12 @@ class SQLiteSource:
         if column_name not in ["sleep", "status", "exercise"]:
             raise ValueError(f"不安全的列名: {column_name}")
         
-        query = f"SELECT date, {column_name} FROM days WHERE SUBSTR(date, 1, 4) = ?;"
-        rows = self._execute_query(query, (str(year),))
+        query = (
+            f"SELECT date(2440587.5 + date), {column_name} FROM days "
+            "WHERE date BETWEEN CAST(julianday(? || '-01-01') - 2440587.5 AS INTEGER) "
+            "AND CAST(julianday(? || '-12-31') - 2440587.5 AS INTEGER);"
+        )
+        rows = self._execute_query(query, (str(year), str(year)))
         data = {}
         for row in rows:
             try:
@@ -41,7 +41,7 @@ class TimelineSQLiteSource:
                 cte.full_path 
             FROM time_records tr
             JOIN path_cte cte ON tr.project_id = cte.original_id
-            WHERE tr.date = ? 
+            WHERE tr.date = CAST(julianday(?) - 2440587.5 AS INTEGER) -- date 列为天数
               AND cte.current_parent_id IS NULL -- 只选择已经回溯到根节点的完整路径
             ORDER BY tr.logical_id ASC;
             """
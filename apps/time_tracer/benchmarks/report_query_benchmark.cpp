@@ -0,0 +1,162 @@
+﻿// benchmarks/report_query_benchmark.cpp
+// 在 10 年的合成数据上对比迁移前 (无覆盖索引) 与迁移后的报表查询延迟。
+// 用法: report_query_benchmark [db_path] [years]
+#include "common/utils/civil_time.hpp"
+#include "core/infrastructure/persistence/schema_migrator.hpp"
+#include "importer/storage/repository.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Query {
+  const char *name;
+  const char *sql;
+  int bind_count; // 1 = 单日, 2 = 区间
+  int iterations;
+};
+
+// 与 SqliteReportDataRepository 中的查询保持一致
+const Query kQueries[] = {
+    {"time_records(day)",
+     "SELECT start, end, project_id, duration, activity_remark "
+     "FROM time_records WHERE date = ? ORDER BY logical_id ASC;",
+     1, 2000},
+    {"project_stats(month)",
+     "SELECT project_id, SUM(duration) FROM time_records WHERE "
+     "date >= ? AND date <= ? GROUP BY project_id;",
+     2, 200},
+    {"active_days(month)",
+     "SELECT COUNT(DISTINCT date) FROM time_records WHERE date "
+     ">= ? AND date <= ?;",
+     2, 200},
+    {"all_months_stats",
+     "SELECT strftime('%Y-%m', 2440587.5 + date) as ym, project_id, "
+     "SUM(duration) "
+     "FROM time_records GROUP BY ym, project_id ORDER BY ym ASC;",
+     0, 5},
+};
+
+std::string make_date(int year, int month, int day) {
+  char buffer[11];
+  std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+  return buffer;
+}
+
+void build_archive(const std::string &db_path, int years) {
+  const char *projects[] = {"study_math",      "study_cs_cpp", "exercise_cardio",
+                            "recreation_game", "routine_meal", "sleep_night",
+                            "work_project_a",  "work_meeting"};
+
+  std::vector<DayData> days;
+  std::vector<TimeRecordInternal> records;
+  const int start_year = 2015;
+  for (int y = start_year; y < start_year + years; ++y) {
+    for (int m = 1; m <= 12; ++m) {
+      for (int d = 1; d <= 28; ++d) {
+        DayData day;
+        day.date_ = make_date(y, m, d);
+        day.year_ = y;
+        day.month_ = m;
+        days.push_back(day);
+
+        for (int i = 0; i < 20; ++i) {
+          TimeRecordInternal record;
+          record.logical_id_ =
+              (static_cast<long long>(y) * 10000 + m * 100 + d) * 10000 + i;
+          record.date_ = day.date_;
+          record.start_time_str_ = "08:00";
+          record.end_time_str_ = "09:00";
+          record.project_path_ = projects[(i + d) % 8];
+          record.duration_seconds_ = 1800 + i * 60;
+          records.push_back(record);
+        }
+      }
+    }
+  }
+
+  auto connection = std::make_shared<Connection>(db_path);
+  Repository repository(connection);
+  repository.import_data(days, records);
+  std::cout << "archive: " << days.size() << " days, " << records.size()
+            << " records\n";
+}
+
+double run_queries(sqlite3 *db, const Query &query, int years) {
+  sqlite3_stmt *stmt = nullptr;
+  sqlite3_prepare_v2(db, query.sql, -1, &stmt, nullptr);
+
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < query.iterations; ++i) {
+    const int y = 2015 + i % years;
+    const int m = 1 + i % 12;
+    // [修改] date 列为天数 (schema v4)
+    const long long last = TimeUtils::DaysFromCivil(y, m, 28);
+    if (query.bind_count >= 1)
+      sqlite3_bind_int64(stmt, 1, TimeUtils::DaysFromCivil(y, m, 1 + i % 28));
+    if (query.bind_count == 2) {
+      sqlite3_bind_int64(stmt, 1, TimeUtils::DaysFromCivil(y, m, 1));
+      sqlite3_bind_int64(stmt, 2, last);
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+    }
+    sqlite3_reset(stmt);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  sqlite3_finalize(stmt);
+  return std::chrono::duration<double, std::micro>(elapsed).count() /
+         query.iterations;
+}
+
+std::vector<double> run_all(sqlite3 *db, int years) {
+  std::vector<double> latencies;
+  for (const auto &query : kQueries) {
+    latencies.push_back(run_queries(db, query, years));
+  }
+  return latencies;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const std::string db_path =
+      argc > 1 ? argv[1] : "report_query_benchmark.sqlite3";
+  const int years = argc > 2 ? std::stoi(argv[2]) : 10;
+
+  std::filesystem::remove(db_path);
+  build_archive(db_path, years);
+
+  sqlite3 *db = nullptr;
+  if (sqlite3_open(db_path.c_str(), &db) != SQLITE_OK) {
+    std::cerr << "Cannot open " << db_path << std::endl;
+    return 1;
+  }
+
+  // 模拟 v0 数据库：去掉二级索引并回退版本号
+  SchemaMigrator::drop_secondary_indexes(db);
+  execute_sql(db, "PRAGMA user_version = 0;", "Reset schema version");
+  execute_sql(db, "ANALYZE;", "Analyze");
+  const auto before = run_all(db, years);
+
+  SchemaMigrator::migrate(db);
+  const auto after = run_all(db, years);
+
+  std::cout << std::fixed << std::setprecision(1) << std::left
+            << std::setw(24) << "query" << std::right << std::setw(14)
+            << "v0 (us)" << std::setw(14) << "v1 (us)" << std::setw(10)
+            << "speedup" << "\n";
+  for (size_t i = 0; i < before.size(); ++i) {
+    std::cout << std::left << std::setw(24) << kQueries[i].name << std::right
+              << std::setw(14) << before[i] << std::setw(14) << after[i]
+              << std::setw(9) << before[i] / after[i] << "x\n";
+  }
+
+  sqlite3_close(db);
+  std::filesystem::remove(db_path);
+  return 0;
+}
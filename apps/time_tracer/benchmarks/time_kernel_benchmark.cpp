@@ -0,0 +1,151 @@
+﻿// benchmarks/time_kernel_benchmark.cpp
+// 对比旧的 stringstream + get_time + mktime 时间戳路径与 civil_time 内核。
+// 用法: time_kernel_benchmark [activities] [threads]
+#include "common/utils/civil_time.hpp"
+#include "common/utils/time_utils.hpp"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Sample {
+  std::string date;
+  std::string start;
+  std::string end;
+};
+
+// --- 旧实现 (逐条活动两次 mktime + 四次 stoi) ---
+long long LegacyTimestamp(const std::string &date, const std::string &time,
+                          bool is_end_time, long long start_timestamp) {
+  if (date.length() < 10 || time.length() < 5)
+    return 0;
+  std::tm t = {};
+  std::stringstream ss(date + " " + time);
+  ss >> std::get_time(&t, "%Y-%m-%d %H:%M");
+  if (ss.fail())
+    return 0;
+  long long timestamp = std::mktime(&t);
+  if (is_end_time && timestamp < start_timestamp) {
+    timestamp += 24 * 60 * 60;
+  }
+  return timestamp;
+}
+
+int LegacyDuration(const std::string &start, const std::string &end) {
+  int start_sec =
+      (std::stoi(start.substr(0, 2)) * 60 + std::stoi(start.substr(3, 2))) * 60;
+  int end_sec =
+      (std::stoi(end.substr(0, 2)) * 60 + std::stoi(end.substr(3, 2))) * 60;
+  if (end_sec < start_sec)
+    end_sec += 24 * 60 * 60;
+  return end_sec - start_sec;
+}
+
+long long RunLegacy(const std::vector<Sample> &samples) {
+  long long checksum = 0;
+  for (const auto &s : samples) {
+    long long start = LegacyTimestamp(s.date, s.start, false, 0);
+    long long end = LegacyTimestamp(s.date, s.end, true, start);
+    checksum += start + end + LegacyDuration(s.start, s.end);
+  }
+  return checksum;
+}
+
+// --- 新实现 (与 DayStats 相同：按日缓存偏移，逐条只做定宽解析) ---
+long long RunKernel(const std::vector<Sample> &samples) {
+  long long checksum = 0;
+  std::string cached_date;
+  long long day_base = 0;
+  for (const auto &s : samples) {
+    if (s.date != cached_date) {
+      TimeUtils::CivilDate civil_date;
+      TimeUtils::ParseCivilDate(s.date, civil_date);
+      day_base = TimeUtils::CivilToTimestamp(
+          civil_date, 0, TimeUtils::ResolveUtcOffsetSeconds(civil_date, {}));
+      cached_date = s.date;
+    }
+    long long start = day_base + TimeUtils::ParseClockSeconds(s.start);
+    long long end = day_base + TimeUtils::ParseClockSeconds(s.end);
+    if (end < start)
+      end += TimeUtils::kSecondsPerDay;
+    checksum +=
+        start + end + TimeUtils::CalculateDurationSeconds(s.start, s.end);
+  }
+  return checksum;
+}
+
+std::vector<Sample> MakeSamples(size_t count) {
+  std::vector<Sample> samples;
+  samples.reserve(count);
+  const size_t per_day = 20;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t day_index = i / per_day;
+    const int month = static_cast<int>((day_index / 28) % 12) + 1;
+    const int day = static_cast<int>(day_index % 28) + 1;
+    const int slot = static_cast<int>(i % per_day);
+    const int start_min = slot * 70 % (24 * 60);
+    const int end_min = (start_min + 45) % (24 * 60);
+
+    char date[11];
+    char start[6];
+    char end[6];
+    std::snprintf(date, sizeof(date), "2025-%02d-%02d", month, day);
+    std::snprintf(start, sizeof(start), "%02d:%02d", start_min / 60,
+                  start_min % 60);
+    std::snprintf(end, sizeof(end), "%02d:%02d", end_min / 60, end_min % 60);
+    samples.push_back({date, start, end});
+  }
+  return samples;
+}
+
+template <typename Fn>
+double MeasureMs(const std::vector<Sample> &samples, size_t threads, Fn fn,
+                 long long &checksum) {
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<long long> sums(threads, 0);
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t]() { sums[t] = fn(samples); });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - begin;
+  checksum = sums.front();
+  return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  const size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+  const size_t threads = argc > 2 ? std::stoul(argv[2]) : 1;
+
+  const auto samples = MakeSamples(count);
+
+  long long legacy_sum = 0;
+  long long kernel_sum = 0;
+  const double legacy_ms = MeasureMs(samples, threads, RunLegacy, legacy_sum);
+  const double kernel_ms = MeasureMs(samples, threads, RunKernel, kernel_sum);
+
+  std::cout << "activities: " << count << " x " << threads << " thread(s)\n"
+            << std::fixed << std::setprecision(2)
+            << "legacy (get_time + mktime): " << legacy_ms << " ms\n"
+            << "civil_time kernel:          " << kernel_ms << " ms\n"
+            << "speedup:                    " << legacy_ms / kernel_ms
+            << "x\n";
+
+  if (legacy_sum != kernel_sum) {
+    std::cerr << "checksum mismatch: " << legacy_sum << " vs " << kernel_sum
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
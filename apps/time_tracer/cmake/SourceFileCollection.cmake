@@ -9,6 +9,7 @@ set(APPLICATION_SOURCES
     # Application - Pipeline
     src/application/pipeline/factory.cpp
     src/application/pipeline/runner.cpp
+    src/application/pipeline/context/source_buffer_cache.cpp
 
     # Application - Handlers (NEW - Command/Handler Pattern)
     src/application/handlers/ingest_handler.cpp
@@ -37,6 +38,7 @@ set(APPLICATION_SOURCES
 set(CORE_SOURCES
     # Infrastructure - Persistence
     src/core/infrastructure/persistence/db_manager.cpp
+    src/core/infrastructure/persistence/schema_migrator.cpp
     src/core/infrastructure/persistence/sqlite_report_repository_adapter.cpp
 
     # Infrastructure - Reporting
@@ -46,11 +48,15 @@ set(CORE_SOURCES
 
     # Infrastructure - Services
     src/core/infrastructure/services/import_service.cpp
+
+    # Infrastructure - Concurrency
+    src/core/infrastructure/concurrency/thread_pool_executor.cpp
 )
 
 # --- Common  ---
 set(COMMON_SOURCES
     "src/common/utils/time_utils.cpp"
+    "src/common/utils/log_line_tokenizer.cpp"
 )
 set(SERIALIZER_SOURCES
     "src/serializer/json_serializer.cpp"
@@ -113,8 +119,10 @@ set(REPORTS_SHARED_SOURCES
 set(REPORTS_DATA_SOURCES
     # 工具类
     "src/reports/data/utils/project_tree_builder.cpp"
+    "src/reports/data/utils/period_rollup_engine.cpp"
 
     "src/reports/infrastructure/persistence/sqlite_report_data_repository.cpp"
+    "src/reports/infrastructure/persistence/statement_cache.cpp"
 
     # Daily Queriers (保留)
     "src/reports/data/queriers/daily/day_querier.cpp"
@@ -159,6 +167,8 @@ set(IMPORTER_SOURCES
     "src/importer/storage/sqlite/project_resolver.cpp"
     "src/importer/storage/sqlite/connection.cpp"
     "src/importer/storage/sqlite/statement.cpp"
+    "src/importer/storage/sqlite/manifest_store.cpp"
+    "src/importer/storage/sqlite/rollup_store.cpp"
 )
 
 
@@ -169,6 +179,7 @@ set(CONVERTER_SOURCES
     # --- 转换模块 (Convert) ---
     "src/converter/convert/facade/converter_service.cpp"
     "src/converter/convert/core/log_linker.cpp"
+    "src/converter/convert/core/activity_dictionary.cpp"
     "src/converter/convert/core/activity_mapper.cpp"
     "src/converter/convert/core/day_processor.cpp"
     "src/converter/convert/core/day_stats.cpp"
@@ -3,7 +3,9 @@
 #define APPLICATION_INTERFACES_I_LOG_CONVERTER_HPP_
 
 #include "common/config/models/converter_config_models.hpp" // Config �?Common 层，Core 可以依赖
+#include "common/utils/log_line_tokenizer.hpp"
 #include "core/domain/model/daily_log.hpp"
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -29,6 +31,17 @@ public:
   virtual LogProcessingResult Convert(const std::string &filename,
                                       const std::string &content,
                                       const ConverterConfig &config) = 0;
+
+  // [新增] 解析器每切分出一行即回调一次 (含年份头之前的行)
+  using LineObserver = std::function<void(const LogLineToken &)>;
+
+  /**
+   * @brief 转换的同时把每一行交给 on_line (单遍验证+转换模式)
+   */
+  virtual LogProcessingResult Convert(const std::string &filename,
+                                      const std::string &content,
+                                      const ConverterConfig &config,
+                                      const LineObserver &on_line) = 0;
 };
 
 } // namespace core::interfaces
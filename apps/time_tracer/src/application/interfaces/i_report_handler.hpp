@@ -3,6 +3,7 @@
 #define APPLICATION_INTERFACES_I_REPORT_HANDLER_HPP_
 
 #include "core/domain/types/report_format.hpp"
+#include "core/domain/types/report_period.hpp"
 #include <string>
 #include <vector>
 
@@ -25,6 +26,9 @@ public:
   virtual std::string RunRangeQuery(const std::string &start_date,
                                     const std::string &end_date,
                                     ReportFormat format) = 0;
+  // [新增] 环比 / 同比，period 为 "YYYY"、"YYYY-MM" 或 "YYYY-Www"
+  virtual std::string RunComparisonQuery(const std::string &period,
+                                         ReportFormat format) = 0;
 
   // 导出方法
   virtual void RunExportSingleDayReport(const std::string &date,
@@ -46,6 +50,13 @@ public:
   RunExportAllYearlyReportsQuery(ReportFormat format) = 0; // [新增]
   virtual void RunExportAllRecentReportsQuery(const std::vector<int> &days_list,
                                               ReportFormat format) = 0;
+  // [新增] 通用周期历史报表，periods 共用一次汇总
+  virtual void
+  RunExportAllPeriodReportsQuery(const std::vector<ReportPeriod> &periods,
+                                 ReportFormat format) = 0;
+  // [新增] 导出全部日期的日报与所有周期报表，formats 共享一次数据加载
+  virtual void
+  RunExportAllFormatsQuery(const std::vector<ReportFormat> &formats) = 0;
 };
 
 #endif // APPLICATION_INTERFACES_I_REPORT_HANDLER_HPP_
@@ -22,9 +22,11 @@ public:
   virtual void RunDatabaseImport(const std::string &processed_path_str) = 0;
   virtual void RunDatabaseImportFromMemory(
       const std::map<std::string, std::vector<DailyLog>> &data_map) = 0;
+  // [修改] full_rebuild=false 时仅处理 source_manifest 中有变化的源文件
   virtual void RunIngest(const std::string &source_path,
                          DateCheckMode date_check_mode,
-                         bool save_processed = false) = 0;
+                         bool save_processed = false,
+                         bool full_rebuild = false, size_t jobs = 0) = 0;
   virtual const AppConfig &GetConfig() const = 0;
 };
 
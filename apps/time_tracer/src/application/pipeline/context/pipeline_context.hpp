@@ -5,13 +5,17 @@
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "application/pipeline/context/source_buffer_cache.hpp"
 #include "common/config/app_config.hpp"
 #include "common/config/models/converter_config_models.hpp"
 #include "core/domain/model/daily_log.hpp"
+#include "core/domain/model/source_manifest.hpp"
 #include "core/domain/ports/i_file_system.hpp"
+#include "core/domain/ports/i_task_executor.hpp"
 #include "core/domain/ports/i_user_notifier.hpp"
 
 namespace fs = std::filesystem;
@@ -24,6 +28,10 @@ struct PipelineRunConfig {
   fs::path output_root_;
   DateCheckMode date_check_mode_ = DateCheckMode::None;
   bool save_processed_output_ = false;
+  // [新增] 增量模式：仅处理相对 source_manifest 发生变化的源文件
+  bool incremental_ = false;
+  // [新增] 工作线程数 (--jobs)，0 表示使用 hardware_concurrency
+  size_t jobs_ = 0;
 
   PipelineRunConfig(const AppConfig &cfg, fs::path out)
       : app_config_(cfg), output_root_(std::move(out)) {}
@@ -33,6 +41,24 @@ struct PipelineState {
   std::vector<fs::path> source_files;
   std::vector<fs::path> generated_files;
   ConverterConfig converter_config;
+
+  // [新增] 上一次摄入时保存的清单 (仅增量模式下由调用方填充)
+  SourceManifest previous_manifest;
+  // [新增] 本次实际处理的源文件指纹，months_ 由 ConverterStep 回填；
+  // 仅 touch 过的文件也在此回写新的 size/mtime (沿用原 months_)
+  SourceManifest source_records;
+  // [新增] 仅作为跨月链接上下文读入的源文件，其产出的月份不重新入库
+  std::set<std::string> context_only_sources;
+  // [新增] 清单中存在、但已从输入目录中删除的源文件
+  std::vector<std::string> removed_sources;
+  // [新增] 变化或删除的源文件上一次产出的月份：入库时整月清除后重写，
+  // 避免文件不再产出某月时旧数据残留
+  std::set<std::string> stale_months;
+
+  // [新增] 源文件内容缓存：每个文件每次摄入只读盘一次，各步骤共享借用。
+  // 使用 shared_ptr 持有，使 PipelineContext 仍可按值移动。
+  std::shared_ptr<SourceBufferCache> source_cache =
+      std::make_shared<SourceBufferCache>();
 };
 
 struct PipelineResult {
@@ -47,6 +73,8 @@ public:
 
   std::shared_ptr<core::interfaces::IFileSystem> file_system;
   std::shared_ptr<core::interfaces::IUserNotifier> notifier;
+  // [新增] 各步骤共享的有界线程池；为空时由 PipelineRunner 按 jobs_ 创建
+  std::shared_ptr<core::interfaces::ITaskExecutor> executor;
 
   // [修改] 移除�?cached_json_outputs
   // 验证阶段不再负责序列化，序列化工作完全由 Writer 步骤负责，职责更清晰�?
@@ -0,0 +1,42 @@
+﻿// application/pipeline/context/source_buffer_cache.cpp
+#include "application/pipeline/context/source_buffer_cache.hpp"
+
+namespace core::pipeline {
+
+SourceBufferCache::Buffer
+SourceBufferCache::Acquire(core::interfaces::IFileSystem &fs,
+                           const std::filesystem::path &path) {
+  const std::string key = path.string();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = buffers_.find(key);
+    if (it != buffers_.end()) {
+      return it->second;
+    }
+  }
+
+  // 读取放在锁外，避免并行任务互相阻塞在磁盘 IO 上
+  return Store(path, fs.ReadContent(path));
+}
+
+SourceBufferCache::Buffer
+SourceBufferCache::Store(const std::filesystem::path &path,
+                         std::string content) {
+  auto buffer = std::make_shared<const std::string>(std::move(content));
+  std::lock_guard<std::mutex> lock(mutex_);
+  // 若已有其他任务先放入，保留先到者，保证所有借用方看到同一份缓冲区
+  auto [it, inserted] = buffers_.try_emplace(path.string(), std::move(buffer));
+  return it->second;
+}
+
+void SourceBufferCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.clear();
+}
+
+size_t SourceBufferCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffers_.size();
+}
+
+} // namespace core::pipeline
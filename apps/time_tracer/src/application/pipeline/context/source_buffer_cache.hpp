@@ -0,0 +1,44 @@
+﻿// application/pipeline/context/source_buffer_cache.hpp
+#ifndef APPLICATION_PIPELINE_CONTEXT_SOURCE_BUFFER_CACHE_HPP_
+#define APPLICATION_PIPELINE_CONTEXT_SOURCE_BUFFER_CACHE_HPP_
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/domain/ports/i_file_system.hpp"
+
+namespace core::pipeline {
+
+/**
+ * @class SourceBufferCache
+ * @brief 一次摄入内共享的源文件内容缓存。
+ * @details 每个文件只从磁盘读取一次，之后 FileCollector / 结构验证 / 转换
+ *          借用同一份只读缓冲区 (引用计数)。线程安全，可在并行任务中调用。
+ */
+class SourceBufferCache {
+public:
+  using Buffer = std::shared_ptr<const std::string>;
+
+  // 返回缓存的内容；未命中时通过 fs 读取并缓存。读取失败时抛出异常。
+  Buffer Acquire(core::interfaces::IFileSystem &fs,
+                 const std::filesystem::path &path);
+
+  // 直接放入已读取的内容 (例如 FileCollector 计算指纹时读到的内容)
+  Buffer Store(const std::filesystem::path &path, std::string content);
+
+  // 释放所有缓冲区 (已借出的 Buffer 在持有者释放后才真正回收)
+  void Clear();
+
+  size_t Size() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Buffer> buffers_;
+};
+
+} // namespace core::pipeline
+
+#endif // APPLICATION_PIPELINE_CONTEXT_SOURCE_BUFFER_CACHE_HPP_
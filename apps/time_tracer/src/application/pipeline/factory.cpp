@@ -29,14 +29,18 @@ std::unique_ptr<PipelineRunner> PipelineFactory::CreateIngestPipeline(
     runner->AddStep(std::make_unique<ConfigLoaderStep>());
   }
 
+  // [新增] 单遍模式：结构验证在转换过程中完成，每行只切分一次
+  const bool single_pass = options.single_pass_validation_ &&
+                           options.validate_structure_ && options.convert_;
+
   // 3. 结构验证
-  if (options.validate_structure_) {
+  if (options.validate_structure_ && !single_pass) {
     runner->AddStep(std::make_unique<StructureValidatorStep>());
   }
 
   // 4. 转换与链接
   if (options.convert_) {
-    runner->AddStep(std::make_unique<ConverterStep>(converter));
+    runner->AddStep(std::make_unique<ConverterStep>(converter, single_pass));
     runner->AddStep(std::make_unique<LogicLinkerStep>());
   }
 
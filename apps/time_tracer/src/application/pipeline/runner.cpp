@@ -1,5 +1,6 @@
 // application/pipeline/runner.cpp
 #include "application/pipeline/runner.hpp"
+#include "core/infrastructure/concurrency/thread_pool_executor.hpp"
 
 namespace core::pipeline {
 
@@ -10,6 +11,13 @@ void PipelineRunner::AddStep(std::unique_ptr<IPipelineStep> step) {
 std::optional<PipelineContext> PipelineRunner::Run(PipelineContext context) {
   context.notifier->NotifyInfo("\n=== Pipeline Start ===");
 
+  // [新增] 整条流水线共享一个固定大小的线程池
+  if (!context.executor) {
+    context.executor =
+        std::make_shared<infrastructure::concurrency::ThreadPoolExecutor>(
+            context.config.jobs_);
+  }
+
   for (const auto &step : steps_) {
     // 可在此处添加通用的耗时监控或日志
     // context.notifier->NotifyInfo("Running step: " + step->GetName());
@@ -38,6 +38,12 @@ std::string ReportGenerator::GenerateRangeReport(const std::string &start_date,
   return repository_->GetRangeReport(start_date, end_date, format);
 }
 
+std::string
+ReportGenerator::GenerateComparisonReport(const std::string &period,
+                                          ReportFormat format) {
+  return repository_->GetComparisonReport(period, format);
+}
+
 FormattedGroupedReports
 ReportGenerator::GenerateAllDailyReports(ReportFormat format) {
   return repository_->GetAllDailyReports(format);
@@ -48,6 +54,16 @@ ReportGenerator::GenerateAllMonthlyReports(ReportFormat format) {
   return repository_->GetAllMonthlyReports(format);
 }
 
+void ReportGenerator::StreamAllDailyReports(ReportFormat format,
+                                            const DailyReportBatchSink &sink) {
+  repository_->StreamAllDailyReports(format, sink);
+}
+
+void ReportGenerator::StreamAllMonthlyReports(
+    ReportFormat format, const MonthlyReportBatchSink &sink) {
+  repository_->StreamAllMonthlyReports(format, sink);
+}
+
 FormattedWeeklyReports
 ReportGenerator::GenerateAllWeeklyReports(ReportFormat format) {
   return repository_->GetAllWeeklyReports(format);
@@ -63,3 +79,21 @@ FormattedYearlyReports
 ReportGenerator::GenerateAllYearlyReports(ReportFormat format) {
   return repository_->GetAllYearlyReports(format);
 }
+
+FormattedPeriodHistory
+ReportGenerator::GenerateAllPeriodReports(
+    const std::vector<ReportPeriod> &periods, ReportFormat format) {
+  return repository_->GetAllPeriodReports(periods, format);
+}
+
+void ReportGenerator::StreamAllDailyReportsMultiFormat(
+    const std::vector<ReportFormat> &formats,
+    const MultiFormatDailyBatchSink &sink) {
+  repository_->StreamAllDailyReportsMultiFormat(formats, sink);
+}
+
+MultiFormatPeriodHistory ReportGenerator::GenerateAllPeriodReportsMultiFormat(
+    const std::vector<ReportPeriod> &periods,
+    const std::vector<ReportFormat> &formats) {
+  return repository_->GetAllPeriodReportsMultiFormat(periods, formats);
+}
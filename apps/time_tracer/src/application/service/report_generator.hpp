@@ -25,12 +25,33 @@ public:
   std::string GenerateRangeReport(const std::string &start_date,
                                   const std::string &end_date,
                                   ReportFormat format);
+  // [新增] 环比 / 同比
+  std::string GenerateComparisonReport(const std::string &period,
+                                       ReportFormat format);
 
   FormattedGroupedReports GenerateAllDailyReports(ReportFormat format);
   FormattedMonthlyReports GenerateAllMonthlyReports(ReportFormat format);
 
+  // [新增] 流式生成，每个窗口回调一次 sink
+  void StreamAllDailyReports(ReportFormat format,
+                             const DailyReportBatchSink &sink);
+  void StreamAllMonthlyReports(ReportFormat format,
+                               const MonthlyReportBatchSink &sink);
+
   FormattedWeeklyReports GenerateAllWeeklyReports(ReportFormat format);
   FormattedYearlyReports GenerateAllYearlyReports(ReportFormat format);
+  // [新增] 多个周期粒度共用一次汇总
+  FormattedPeriodHistory
+  GenerateAllPeriodReports(const std::vector<ReportPeriod> &periods,
+                           ReportFormat format);
+
+  // [新增] 多格式：数据只加载一次，同时生成 formats 中的所有格式
+  void
+  StreamAllDailyReportsMultiFormat(const std::vector<ReportFormat> &formats,
+                                   const MultiFormatDailyBatchSink &sink);
+  MultiFormatPeriodHistory
+  GenerateAllPeriodReportsMultiFormat(const std::vector<ReportPeriod> &periods,
+                                      const std::vector<ReportFormat> &formats);
 
   FormattedRecentReports
   GenerateAllRecentReports(const std::vector<int> &days_list,
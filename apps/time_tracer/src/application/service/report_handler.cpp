@@ -101,6 +101,11 @@ std::string ReportHandler::RunRangeQuery(const std::string &start_date,
   return generator_->GenerateRangeReport(start_date, end_date, format);
 }
 
+std::string ReportHandler::RunComparisonQuery(const std::string &period,
+                                              ReportFormat format) {
+  return generator_->GenerateComparisonReport(period, format);
+}
+
 std::string ReportHandler::RunRecentQueries(const std::vector<int> &days_list,
                                             ReportFormat format) {
   std::ostringstream oss;
@@ -154,9 +159,13 @@ void ReportHandler::RunExportSingleRangeReport(const std::string &start_date,
   exporter_->ExportSingleRangeReport(start_date, end_date, content, format);
 }
 
+// [修改] 流式导出：按月生成并写盘，不再一次性持有全部日报
 void ReportHandler::RunExportAllDailyReportsQuery(ReportFormat format) {
-  auto reports = generator_->GenerateAllDailyReports(format);
-  exporter_->ExportAllDailyReports(reports, format);
+  exporter_->ExportAllDailyReports(
+      [&](const DailyReportBatchSink &sink) {
+        generator_->StreamAllDailyReports(format, sink);
+      },
+      format);
 }
 
 void ReportHandler::RunExportAllWeeklyReportsQuery(ReportFormat format) {
@@ -164,9 +173,13 @@ void ReportHandler::RunExportAllWeeklyReportsQuery(ReportFormat format) {
   exporter_->ExportAllWeeklyReports(reports, format);
 }
 
+// [修改] 流式导出：按年生成并写盘
 void ReportHandler::RunExportAllMonthlyReportsQuery(ReportFormat format) {
-  auto reports = generator_->GenerateAllMonthlyReports(format);
-  exporter_->ExportAllMonthlyReports(reports, format);
+  exporter_->ExportAllMonthlyReports(
+      [&](const MonthlyReportBatchSink &sink) {
+        generator_->StreamAllMonthlyReports(format, sink);
+      },
+      format);
 }
 
 void ReportHandler::RunExportAllYearlyReportsQuery(ReportFormat format) {
@@ -174,6 +187,34 @@ void ReportHandler::RunExportAllYearlyReportsQuery(ReportFormat format) {
   exporter_->ExportAllYearlyReports(reports, format);
 }
 
+void ReportHandler::RunExportAllPeriodReportsQuery(
+    const std::vector<ReportPeriod> &periods, ReportFormat format) {
+  auto history = generator_->GenerateAllPeriodReports(periods, format);
+  for (const auto &[period, reports] : history) {
+    exporter_->ExportAllPeriodReports(period, reports, format);
+  }
+}
+
+// [新增] 日报按月流式生成并写盘；周期报表一次汇总后按格式写盘
+void ReportHandler::RunExportAllFormatsQuery(
+    const std::vector<ReportFormat> &formats) {
+  exporter_->ExportAllDailyReportsMultiFormat(
+      [&](const MultiFormatDailyBatchSink &sink) {
+        generator_->StreamAllDailyReportsMultiFormat(formats, sink);
+      },
+      formats);
+
+  auto history = generator_->GenerateAllPeriodReportsMultiFormat(
+      {ReportPeriod::Week, ReportPeriod::BiWeek, ReportPeriod::Month,
+       ReportPeriod::Quarter, ReportPeriod::HalfYear, ReportPeriod::Year},
+      formats);
+  for (const auto &[format, by_period] : history) {
+    for (const auto &[period, reports] : by_period) {
+      exporter_->ExportAllPeriodReports(period, reports, format);
+    }
+  }
+}
+
 void ReportHandler::RunExportAllRecentReportsQuery(
     const std::vector<int> &days_list, ReportFormat format) {
   auto reports = generator_->GenerateAllRecentReports(days_list, format);
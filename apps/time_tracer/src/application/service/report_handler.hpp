@@ -30,6 +30,8 @@ public:
   std::string RunRangeQuery(const std::string &start_date,
                             const std::string &end_date,
                             ReportFormat format) override;
+  std::string RunComparisonQuery(const std::string &period,
+                                 ReportFormat format) override;
 
   void RunExportSingleDayReport(const std::string &date,
                                 ReportFormat format) override;
@@ -49,6 +51,10 @@ public:
   void RunExportAllYearlyReportsQuery(ReportFormat format) override;
   void RunExportAllRecentReportsQuery(const std::vector<int> &days_list,
                                       ReportFormat format) override;
+  void RunExportAllPeriodReportsQuery(const std::vector<ReportPeriod> &periods,
+                                      ReportFormat format) override;
+  void
+  RunExportAllFormatsQuery(const std::vector<ReportFormat> &formats) override;
 
 private:
   std::unique_ptr<ReportGenerator> generator_;
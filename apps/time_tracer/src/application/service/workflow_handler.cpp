@@ -4,6 +4,7 @@
 #include "core/infrastructure/persistence/db_manager.hpp"
 // [移除] #include "serializer/json_serializer.hpp"  <-- 不需要了，只依赖接口
 // [移除] #include "converter/log_processor.hpp"     <-- 不需要了，只依赖接口
+#include <set>
 #include <stdexcept>
 
 // [修改] 构造函数实现：接收并保存所有依�?
@@ -13,14 +14,15 @@ WorkflowHandler::WorkflowHandler(
     std::shared_ptr<core::interfaces::IFileSystem> fs,
     std::shared_ptr<core::interfaces::IUserNotifier> notifier,
     std::shared_ptr<core::interfaces::ILogSerializer> serializer,
-    std::shared_ptr<core::interfaces::ILogConverter> converter)
+    std::shared_ptr<core::interfaces::ILogConverter> converter,
+    core::interfaces::ProjectCreatedCallback on_project_created)
     : app_config_(config), output_root_path_(output_root_path), fs_(fs),
       notifier_(notifier), serializer_(serializer), // 保存
       converter_(converter)                         // 保存
 {
   // [修改] 创建 ImportService 时，传递已经注入进来的 serializer_
   import_service_ = std::make_unique<core::service::ImportService>(
-      db_path, fs, notifier, serializer_);
+      db_path, fs, notifier, serializer_, std::move(on_project_created));
 }
 
 WorkflowHandler::~WorkflowHandler() = default;
@@ -32,6 +34,7 @@ void WorkflowHandler::RunConverter(const std::string &input_path,
   context.config.input_root_ = input_path;
   context.config.date_check_mode_ = options.date_check_mode_;
   context.config.save_processed_output_ = options.save_processed_output_;
+  context.config.jobs_ = options.jobs_;
 
   // [修改] 将保存的 serializer_ ?converter_ 传递给 PipelineFactory
   auto pipeline = core::pipeline::PipelineFactory::CreateIngestPipeline(
@@ -53,7 +56,8 @@ void WorkflowHandler::RunDatabaseImportFromMemory(
 
 void WorkflowHandler::RunIngest(const std::string &source_path,
                                 DateCheckMode date_check_mode,
-                                bool save_processed) {
+                                bool save_processed, bool full_rebuild,
+                                size_t jobs) {
   notifier_->NotifyInfo("\n--- 启动数据摄入 (Ingest) ---");
 
   AppOptions full_options;
@@ -62,12 +66,20 @@ void WorkflowHandler::RunIngest(const std::string &source_path,
   full_options.validate_logic_ = true;
   full_options.date_check_mode_ = date_check_mode;
   full_options.save_processed_output_ = save_processed;
+  full_options.jobs_ = jobs;
+  full_options.single_pass_validation_ = true;
 
   core::pipeline::PipelineContext context(app_config_, output_root_path_, fs_,
                                           notifier_);
   context.config.input_root_ = source_path;
   context.config.date_check_mode_ = date_check_mode;
   context.config.save_processed_output_ = save_processed;
+  context.config.jobs_ = jobs;
+
+  // [新增] 增量摄入：读取上次的源文件清单，由 FileCollector 过滤未修改文件
+  // [修改] 全量重建同样读取，用于清除已删除源文件的清单行与月份
+  context.config.incremental_ = !full_rebuild;
+  context.state.previous_manifest = import_service_->LoadSourceManifest();
 
   // [修改] 传递依赖给 PipelineFactory
   auto pipeline = core::pipeline::PipelineFactory::CreateIngestPipeline(
@@ -76,13 +88,47 @@ void WorkflowHandler::RunIngest(const std::string &source_path,
   auto result_context_opt = pipeline->Run(std::move(context));
 
   if (result_context_opt) {
-    const auto &result = result_context_opt->result;
-    if (!result.processed_data.empty()) {
-      notifier_->NotifyInfo("\n--- 流水线验证通过，准备入库 ---");
-      import_service_->ImportFromMemory(result.processed_data);
-      notifier_->NotifySuccess("\n=== Ingest 执行成功 ===");
-    } else {
+    auto &state = result_context_opt->state;
+    auto &result = result_context_opt->result;
+
+    // [修改] 仅 touch 过的文件仍需回写清单 (source_records 非空)
+    if (state.source_files.empty() && state.removed_sources.empty() &&
+        state.source_records.empty() &&
+        result_context_opt->config.incremental_) {
+      notifier_->NotifySuccess("\n=== Ingest 完成：源文件无变化 ===");
+      return;
+    }
+
+    // 仅作为链接上下文读入的月份不重新入库 (其首日依赖更早的月份)
+    std::set<std::string> import_months;
+    ManifestChanges manifest_changes;
+    for (const auto &[path, record] : state.source_records) {
+      manifest_changes.upserts_.push_back(record);
+      if (!state.context_only_sources.contains(path)) {
+        import_months.insert(record.months_.begin(), record.months_.end());
+      }
+    }
+    manifest_changes.removed_paths_ = state.removed_sources;
+    manifest_changes.stale_months_.assign(state.stale_months.begin(),
+                                          state.stale_months.end());
+    std::erase_if(result.processed_data, [&](const auto &entry) {
+      return !import_months.contains(entry.first);
+    });
+
+    // [修改] 没有数据时仍写入清单并清除失效月份，避免下次重复处理
+    if (result.processed_data.empty() && manifest_changes.empty()) {
+      notifier_->NotifyWarning("\n=== Ingest 完成但无数据产生 ===");
+      return;
+    }
+    notifier_->NotifyInfo("\n--- 流水线验证通过，准备入库 ---");
+    import_service_->ImportFromMemory(result.processed_data,
+                                      manifest_changes);
+    if (state.source_files.empty() && state.removed_sources.empty()) {
+      notifier_->NotifySuccess("\n=== Ingest 完成：源文件无变化 ===");
+    } else if (result.processed_data.empty()) {
       notifier_->NotifyWarning("\n=== Ingest 完成但无数据产生 ===");
+    } else {
+      notifier_->NotifySuccess("\n=== Ingest 执行成功 ===");
     }
   } else {
     notifier_->NotifyError("\n=== Ingest 执行失败 ===");
@@ -16,7 +16,9 @@ public:
                   std::shared_ptr<core::interfaces::IFileSystem> fs,
                   std::shared_ptr<core::interfaces::IUserNotifier> notifier,
                   std::shared_ptr<core::interfaces::ILogSerializer> serializer,
-                  std::shared_ptr<core::interfaces::ILogConverter> converter);
+                  std::shared_ptr<core::interfaces::ILogConverter> converter,
+                  core::interfaces::ProjectCreatedCallback on_project_created =
+                      {});
 
   ~WorkflowHandler() override;
 
@@ -26,7 +28,8 @@ public:
   void RunDatabaseImportFromMemory(
       const std::map<std::string, std::vector<DailyLog>> &data_map) override;
   void RunIngest(const std::string &source_path, DateCheckMode date_check_mode,
-                 bool save_processed = false) override;
+                 bool save_processed = false,
+                 bool full_rebuild = false, size_t jobs = 0) override;
   const AppConfig &GetConfig() const override;
 
 private:
@@ -1,11 +1,11 @@
 ﻿// application/steps/converter_step.cpp
 #include "application/steps/converter_step.hpp"
+#include "application/steps/structure_validator_step.hpp"
+#include "validator/txt/facade/text_validator.hpp"
 // [移除] #include "converter/log_processor.hpp" ->
 // 现在通过接口调用，不需要具体头文件
 #include <chrono>
-#include <future>
 #include <iomanip>
-#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -13,55 +13,127 @@ namespace core::pipeline {
 
 // [修改] 注入 converter
 ConverterStep::ConverterStep(
-    std::shared_ptr<core::interfaces::ILogConverter> converter)
-    : converter_(std::move(converter)) {}
+    std::shared_ptr<core::interfaces::ILogConverter> converter,
+    bool validate_structure)
+    : converter_(std::move(converter)),
+      validate_structure_(validate_structure) {}
 
 bool ConverterStep::Execute(PipelineContext &context) {
-  context.notifier->NotifyInfo("Step: Converting files (Parallel)...");
+  if (validate_structure_) {
+    context.notifier->NotifyInfo(
+        "Step: Validating Source Structure (TXT) + Converting files "
+        "(Single pass)...");
+  } else {
+    context.notifier->NotifyInfo("Step: Converting files (Parallel)...");
+  }
   auto start_time = std::chrono::steady_clock::now();
 
-  std::mutex data_mutex;
   using core::interfaces::LogProcessingResult; // 使用接口中定义的 Result
-  std::vector<std::future<LogProcessingResult>> futures;
 
   // 捕获 converter_ 指针
   auto converter = converter_;
-  // 捕获 config 副本 (ConverterConfig 是轻量级数据结构，或者引context 也可
-  auto config = context.state.converter_config;
-
-  for (const auto &file_path : context.state.source_files) {
-    futures.push_back(std::async(
-        std::launch::async,
-        [context_fs = context.file_system, converter, config,
-         file_path]() -> LogProcessingResult {
-          try {
-            std::string content = context_fs->ReadContent(file_path);
-            // [关键修改] 调用接口方法，传filename, content config
-            return converter->Convert(file_path.string(), content, config);
-          } catch (const std::exception &) {
-            return LogProcessingResult{false, {}};
-          }
-        }));
+  const auto &config = context.state.converter_config;
+  const auto &source_files = context.state.source_files;
+
+  // [修改] 使用共享的有界线程池代替每个文件一个 std::async 线程。
+  // 每个任务只写入自己的结果槽位，因此无需加锁。
+  std::vector<LogProcessingResult> results(source_files.size());
+  std::vector<FileValidation> validations(
+      validate_structure_ ? source_files.size() : 0);
+  const bool validate_structure = validate_structure_;
+
+  for (size_t i = 0; i < source_files.size(); ++i) {
+    context.executor->Submit([&context, &converter, &config, &source_files,
+                              &results, &validations, validate_structure,
+                              i]() {
+      const auto &file_path = source_files[i];
+      SourceBufferCache::Buffer content;
+      try {
+        // [修改] 借用共享缓存中的内容，不再重复读盘
+        content = context.state.source_cache->Acquire(*context.file_system,
+                                                      file_path);
+      } catch (const std::exception &e) {
+        results[i] = LogProcessingResult{false, {}};
+        if (validate_structure) {
+          validations[i].read_error = e.what();
+          validations[i].valid = false;
+        }
+        return;
+      }
+
+      try {
+        if (!validate_structure) {
+          // [关键修改] 调用接口方法，传filename, content config
+          results[i] = converter->Convert(file_path.string(), *content, config);
+          return;
+        }
+
+        // 单遍模式：解析器切分出的每一行同时交给 TextValidator
+        FileValidation &validation = validations[i];
+        validator::txt::TextValidator text_validator(config);
+        text_validator.begin();
+        bool stopped = false;
+        results[i] = converter->Convert(
+            file_path.string(), *content, config,
+            [&](const LogLineToken &token) {
+              if (!stopped) {
+                stopped =
+                    !text_validator.process_line(token, validation.errors);
+              }
+            });
+        validation.valid = !stopped && validation.errors.empty();
+      } catch (const std::exception &e) {
+        results[i] = LogProcessingResult{false, {}};
+        // [修复] 转换中途抛出时该文件不能算作验证通过
+        if (validate_structure) {
+          validations[i].convert_error = e.what();
+          validations[i].valid = false;
+        }
+      }
+    });
+  }
+  context.executor->WaitAll();
+
+  // 单遍模式下结构错误先于转换结果报告，失败时不合并任何数据，
+  // 与 StructureValidatorStep 在转换前中止流水线的语义一致
+  if (validate_structure_ &&
+      !StructureValidatorStep::ReportResults(context, validations)) {
+    context.state.source_cache->Clear();
+    return false;
   }
 
   bool all_success = true;
   int processed_count = 0;
 
-  for (size_t i = 0; i < futures.size(); ++i) {
-    LogProcessingResult result = futures[i].get();
+  // 按文件顺序合并，保证与串行执行时的结果一致
+  for (size_t i = 0; i < results.size(); ++i) {
+    LogProcessingResult &result = results[i];
     processed_count++;
 
     if (!result.success) {
       all_success = false;
-      context.notifier->NotifyError(
-          "转换失败: " + context.state.source_files[i].filename().string());
+      context.notifier->NotifyError("转换失败: " +
+                                    source_files[i].filename().string());
     } else {
-      std::lock_guard<std::mutex> lock(data_mutex);
-      context.result.processed_data.insert(result.processed_data.begin(),
-                                           result.processed_data.end());
+      // [新增] 回填该源文件产出的月份，供 source_manifest 使用
+      auto record_it =
+          context.state.source_records.find(source_files[i].string());
+      if (record_it != context.state.source_records.end()) {
+        record_it->second.months_.clear();
+        for (const auto &[month_key, days] : result.processed_data) {
+          record_it->second.months_.push_back(month_key);
+        }
+      }
+
+      // [修改] map::merge 直接转移节点，不再复制 DailyLog
+      // (与 insert 相同：已存在的月份保留先合并者)
+      context.result.processed_data.merge(result.processed_data);
     }
   }
 
+  // 转换完成后源文本不再被使用，尽早释放
+  context.state.source_cache->Clear();
+
   auto end_time = std::chrono::steady_clock::now();
   double duration =
       std::chrono::duration<double, std::milli>(end_time - start_time).count();
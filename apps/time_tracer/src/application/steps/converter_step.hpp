@@ -16,14 +16,18 @@ namespace core::pipeline {
 class ConverterStep : public IPipelineStep {
 public:
   // [修改] 构造函数注�?ILogConverter
+  // [新增] validate_structure=true 时为单遍模式：转换的同时执行结构验证，
+  // 取代独立的 StructureValidatorStep (每行只切分一次)
   explicit ConverterStep(
-      std::shared_ptr<core::interfaces::ILogConverter> converter);
+      std::shared_ptr<core::interfaces::ILogConverter> converter,
+      bool validate_structure = false);
 
   bool Execute(PipelineContext &context) override;
   std::string GetName() const override { return "Converter"; }
 
 private:
   std::shared_ptr<core::interfaces::ILogConverter> converter_; // [新增]
+  bool validate_structure_ = false;
   void printTiming(
       double ms,
       const std::shared_ptr<core::interfaces::IUserNotifier> &notifier) const;
@@ -1,9 +1,51 @@
 ﻿// application/steps/file_collector.cpp
 #include "application/steps/file_collector.hpp"
 #include <algorithm>
+#include <cstdio>
+#include <set>
 
 namespace core::pipeline {
 
+namespace {
+
+// "YYYY-MM" 按月偏移 (delta 为 +1 / -1)，格式不合法时返回空串
+std::string ShiftMonth(const std::string &month_key, int delta) {
+  if (month_key.size() != 7 || month_key[4] != '-') {
+    return "";
+  }
+  try {
+    int year = std::stoi(month_key.substr(0, 4));
+    int month = std::stoi(month_key.substr(5, 2)) + delta;
+    if (month < 1) {
+      month = 12;
+      --year;
+    } else if (month > 12) {
+      month = 1;
+      ++year;
+    }
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d", year, month);
+    return buffer;
+  } catch (...) {
+    return "";
+  }
+}
+
+// path 是否位于输入根目录之下 (单文件输入时只匹配其自身)
+bool IsUnderRoot(const std::string &path, const std::string &root) {
+  if (path.size() < root.size() || path.compare(0, root.size(), root) != 0) {
+    return false;
+  }
+  if (path.size() == root.size() || root.empty()) {
+    return true;
+  }
+  const char last = root.back();
+  const char next = path[root.size()];
+  return last == '/' || last == '\\' || next == '/' || next == '\\';
+}
+
+} // namespace
+
 bool FileCollector::Execute(PipelineContext &context) {
   context.notifier->NotifyInfo("Step: File Collector");
   const std::string extension = ".txt";
@@ -40,6 +82,167 @@ bool FileCollector::Execute(PipelineContext &context) {
   context.notifier->NotifyInfo(
       "信息: 成功收集" + std::to_string(context.state.source_files.size()) +
       " 个待处理文件 (" + extension + ").");
+
+  return FilterUnchangedSources(context);
+}
+
+bool FileCollector::FilterUnchangedSources(PipelineContext &context) {
+  const auto &previous = context.state.previous_manifest;
+  const bool incremental = context.config.incremental_;
+  context.state.source_records.clear();
+  context.state.context_only_sources.clear();
+  context.state.removed_sources.clear();
+  context.state.stale_months.clear();
+
+  std::set<std::string> changed_paths;
+  std::set<std::string> affected_months;
+  bool has_new_file = false;
+
+  // [新增] 输入目录下已删除的源文件：移除清单行，并清除其产出的月份
+  std::set<std::string> present_paths;
+  for (const auto &file_path : context.state.source_files) {
+    present_paths.insert(file_path.string());
+  }
+  const std::string root = context.config.input_root_.string();
+  for (const auto &[path, record] : previous) {
+    if (present_paths.contains(path) || !IsUnderRoot(path, root)) {
+      continue;
+    }
+    context.state.removed_sources.push_back(path);
+    context.state.stale_months.insert(record.months_.begin(),
+                                      record.months_.end());
+    affected_months.insert(record.months_.begin(), record.months_.end());
+  }
+
+  for (const auto &file_path : context.state.source_files) {
+    SourceFileRecord record;
+    record.path_ = file_path.string();
+    record.size_ = context.file_system->GetFileSize(file_path);
+    record.mtime_ = context.file_system->GetLastWriteTime(file_path);
+
+    auto prev_it = previous.find(record.path_);
+    const SourceFileRecord *prev_entry =
+        prev_it != previous.end() ? &prev_it->second : nullptr;
+    const SourceFileRecord *prev = incremental ? prev_entry : nullptr;
+
+    // 快速路径：大小与修改时间均未变化，视为未修改
+    if (prev && prev->size_ == record.size_ && prev->mtime_ == record.mtime_) {
+      continue;
+    }
+
+    try {
+      // 读到的内容放入共享缓存，后续验证/转换不再重复读盘
+      auto buffer = context.state.source_cache->Acquire(*context.file_system,
+                                                        file_path);
+      record.hash_ = ComputeContentHash(*buffer);
+    } catch (const std::exception &e) {
+      // 读取失败交由后续步骤报告，此处仅视为已变化
+      context.notifier->NotifyWarning("警告: 无法计算文件指纹: " +
+                                      record.path_ + " - " + e.what());
+    }
+
+    // 内容未变 (仅 touch 过)：不重新转换，但回写新的 size/mtime，
+    // 否则之后每次摄入都要重新读盘计算指纹
+    if (prev && !record.hash_.empty() && prev->hash_ == record.hash_) {
+      record.months_ = prev->months_;
+      context.state.source_records[record.path_] = std::move(record);
+      continue;
+    }
+
+    if (prev_entry) {
+      // [新增] 文件可能不再产出以前的某些月份，需整月清除
+      context.state.stale_months.insert(prev_entry->months_.begin(),
+                                        prev_entry->months_.end());
+    }
+    if (prev) {
+      affected_months.insert(prev->months_.begin(), prev->months_.end());
+    } else {
+      has_new_file = true;
+    }
+    changed_paths.insert(record.path_);
+    context.state.source_records[record.path_] = std::move(record);
+  }
+
+  if (!incremental) {
+    return true;
+  }
+
+  // LogLinker 用上月末日补全本月首日的睡眠记录：
+  // - 后继月份 (M+1) 的首日依赖变化月份，必须重新转换并入库；
+  // - 前驱月份 (M-1) 只作为链接上下文读入，不重新入库。
+  std::set<std::string> successor_months;
+  std::set<std::string> predecessor_months;
+  for (const auto &month : affected_months) {
+    predecessor_months.insert(ShiftMonth(month, -1));
+    successor_months.insert(ShiftMonth(month, +1));
+  }
+  if (has_new_file) {
+    // 新文件通常紧接在最新月份之后
+    std::string latest_month;
+    for (const auto &[path, record] : previous) {
+      for (const auto &month : record.months_) {
+        latest_month = std::max(latest_month, month);
+      }
+    }
+    predecessor_months.insert(latest_month);
+  }
+  successor_months.erase("");
+  predecessor_months.erase("");
+
+  auto produces_any = [](const SourceFileRecord &record,
+                         const std::set<std::string> &months) {
+    return std::any_of(
+        record.months_.begin(), record.months_.end(),
+        [&](const std::string &month) { return months.contains(month); });
+  };
+
+  std::vector<fs::path> selected_files;
+  size_t linked_count = 0;
+  for (const auto &file_path : context.state.source_files) {
+    const std::string path_str = file_path.string();
+    if (changed_paths.contains(path_str)) {
+      selected_files.push_back(file_path);
+      continue;
+    }
+
+    auto prev_it = previous.find(path_str);
+    if (prev_it == previous.end()) {
+      continue;
+    }
+    // [修改] 与被清除的月份重叠的未修改文件同样需要重新入库
+    const auto &stale_months = context.state.stale_months;
+    bool is_successor = produces_any(prev_it->second, successor_months) ||
+                        produces_any(prev_it->second, stale_months);
+    bool is_predecessor = produces_any(prev_it->second, predecessor_months);
+    if (!is_successor && !is_predecessor) {
+      continue;
+    }
+
+    // [修改] 仅 touch 过的文件已带有新的 size/mtime，保留之
+    auto &record =
+        context.state.source_records.try_emplace(path_str, prev_it->second)
+            .first->second;
+    record.months_.clear();
+    if (!is_successor) {
+      context.state.context_only_sources.insert(path_str);
+    }
+    selected_files.push_back(file_path);
+    ++linked_count;
+  }
+
+  size_t skipped_count =
+      context.state.source_files.size() - selected_files.size();
+  context.state.source_files = std::move(selected_files);
+
+  context.notifier->NotifyInfo(
+      "信息: 增量模式 - 变化 " + std::to_string(changed_paths.size()) +
+      " 个, 关联 " + std::to_string(linked_count) + " 个, 删除 " +
+      std::to_string(context.state.removed_sources.size()) + " 个, 跳过 " +
+      std::to_string(skipped_count) + " 个未修改文件.");
+
+  if (context.state.source_files.empty()) {
+    context.notifier->NotifySuccess("所有源文件均未变化，无需重新转换。");
+  }
   return true;
 }
 
@@ -14,6 +14,10 @@ public:
   bool Execute(PipelineContext &context) override;
 
   std::string GetName() const override { return "FileCollector"; }
+
+private:
+  // [新增] 计算源文件指纹；增量模式下剔除与 source_manifest 一致的文件
+  bool FilterUnchangedSources(PipelineContext &context);
 };
 
 } // namespace core::pipeline
@@ -3,6 +3,7 @@
 #include "validator/common/validator_utils.hpp"
 #include "validator/logic/facade/logic_validator.hpp" // 引入新的 LogicValidator
 #include <set>
+#include <vector>
 
 namespace core::pipeline {
 
@@ -17,28 +18,47 @@ bool LogicValidatorStep::Execute(PipelineContext &context) {
     return true;
   }
 
-  // [修复] 变量名改logic_validator，避免冲突
-  validator::logic::LogicValidator logic_validator(
-      context.config.date_check_mode_);
-  bool all_valid = true;
+  // [修改] 按月份并行验证，每个任务使用独立的 LogicValidator；
+  // 结果按月份 (map 键) 顺序汇报，保证输出与串行执行一致。
+  struct MonthValidation {
+    const std::string *month_key = nullptr;
+    const std::vector<DailyLog> *days = nullptr;
+    std::set<validator::Error> errors;
+    bool valid = true;
+  };
 
-  // 遍历处理后的数据 (按月分组)
+  std::vector<MonthValidation> results;
+  results.reserve(context.result.processed_data.size());
   for (const auto &[month_key, days] : context.result.processed_data) {
     if (days.empty())
       continue;
+    MonthValidation item;
+    item.month_key = &month_key;
+    item.days = &days;
+    results.push_back(std::move(item));
+  }
 
-    // 执行验证 (直接传入 DailyLog 列表)
-    std::set<validator::Error> errors;
+  const DateCheckMode date_check_mode = context.config.date_check_mode_;
+  for (auto &item : results) {
+    context.executor->Submit([&item, date_check_mode]() {
+      validator::logic::LogicValidator logic_validator(date_check_mode);
+      // month_key 通常"YYYY-MM"，用作上下文名称
+      item.valid =
+          logic_validator.validate(*item.month_key, *item.days, item.errors);
+    });
+  }
+  context.executor->WaitAll();
 
-    // month_key 通常"YYYY-MM"，用作上下文名称
-    if (!logic_validator.validate(month_key, days, errors)) {
+  bool all_valid = true;
+  for (const auto &item : results) {
+    if (!item.valid) {
       all_valid = false;
 
       // 报告错误
-      std::string context_name = "DataGroup[" + month_key + "]";
+      std::string context_name = "DataGroup[" + *item.month_key + "]";
       // [修复] 正确调用命名空间函数
       std::string error_report =
-          validator::format_error_report(context_name, errors);
+          validator::format_error_report(context_name, item.errors);
       context.notifier->NotifyError(error_report);
     }
   }
@@ -3,43 +3,78 @@
 #include "validator/common/validator_utils.hpp" // 用于调用 format_error_report
 #include "validator/txt/facade/text_validator.hpp"
 #include <set>
+#include <vector>
 
 namespace core::pipeline {
 
 bool StructureValidatorStep::Execute(PipelineContext &context) {
   context.notifier->NotifyInfo("Step: Validating Source Structure (TXT)...");
 
-  // [修复] 变量名改?text_validator，避免与 namespace validator 冲突
-  validator::txt::TextValidator text_validator(context.state.converter_config);
+  // [修改] 按文件并行验证。每个任务持有独立的 TextValidator
+  // (各自的 LineRules / StructureRules 状态)，结果写入各自槽位，
+  // 最后按文件顺序输出报告，保证输出与串行执行一致。
+  const auto &source_files = context.state.source_files;
+  const auto &converter_config = context.state.converter_config;
+  std::vector<FileValidation> results(source_files.size());
 
+  for (size_t i = 0; i < source_files.size(); ++i) {
+    context.executor->Submit([&context, &source_files, &converter_config,
+                              &results, i]() {
+      FileValidation &result = results[i];
+      const auto &file_path = source_files[i];
+
+      // [修改] 从共享缓存借用文件内容 (FileCollector 已读入时不再读盘)
+      SourceBufferCache::Buffer content;
+      try {
+        content = context.state.source_cache->Acquire(*context.file_system,
+                                                      file_path);
+      } catch (const std::exception &e) {
+        result.read_error = e.what();
+        result.valid = false;
+        return;
+      }
+
+      validator::txt::TextValidator text_validator(converter_config);
+      result.valid = text_validator.validate(file_path.filename().string(),
+                                             *content, result.errors);
+    });
+  }
+  context.executor->WaitAll();
+
+  return ReportResults(context, results);
+}
+
+bool StructureValidatorStep::ReportResults(
+    PipelineContext &context, const std::vector<FileValidation> &results) {
+  const auto &source_files = context.state.source_files;
   bool all_valid = true;
   int files_checked = 0;
 
-  for (const auto &file_path : context.state.source_files) {
+  for (size_t i = 0; i < results.size(); ++i) {
     files_checked++;
-    std::string filename = file_path.filename().string();
+    const FileValidation &result = results[i];
+    std::string filename = source_files[i].filename().string();
 
-    // 读取文件内容
-    std::string content;
-    try {
-      content = context.file_system->ReadContent(file_path);
-    } catch (const std::exception &e) {
+    if (!result.read_error.empty()) {
       context.notifier->NotifyError("Failed to read file: " + filename + " - " +
-                                    e.what());
+                                    result.read_error);
       all_valid = false;
       continue;
     }
 
-    std::set<validator::Error> errors;
-
-    // [修复] 使用 text_validator 实例调用
-    if (!text_validator.validate(filename, content, errors)) {
+    if (!result.valid) {
       all_valid = false;
 
-      // [修复] 正确调用命名空间函数 validator::format_error_report
-      std::string error_report =
-          validator::format_error_report(filename, errors);
-      context.notifier->NotifyError(error_report);
+      if (!result.errors.empty() || result.convert_error.empty()) {
+        // [修复] 正确调用命名空间函数 validator::format_error_report
+        std::string error_report =
+            validator::format_error_report(filename, result.errors);
+        context.notifier->NotifyError(error_report);
+      }
+      if (!result.convert_error.empty()) {
+        context.notifier->NotifyError("Failed to convert file: " + filename +
+                                      " - " + result.convert_error);
+      }
     }
   }
 
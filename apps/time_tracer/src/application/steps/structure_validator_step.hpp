@@ -3,13 +3,31 @@
 #define APPLICATION_STEPS_STRUCTURE_VALIDATOR_STEP_HPP_
 
 #include "application/pipeline/interfaces/i_pipeline_step.hpp"
+#include "validator/common/validator_utils.hpp"
+#include <set>
+#include <string>
+#include <vector>
 
 namespace core::pipeline {
 
+// 单个源文件的结构验证结果
+struct FileValidation {
+  std::string read_error;
+  // [新增] 单遍模式下转换抛出的异常；已收集的结构错误照常报告
+  std::string convert_error;
+  std::set<validator::Error> errors;
+  bool valid = true;
+};
+
 class StructureValidatorStep : public IPipelineStep {
 public:
   bool Execute(PipelineContext &context) override;
   std::string GetName() const override { return "StructureValidator"; }
+
+  // [新增] 按 source_files 顺序输出验证报告，返回是否全部通过。
+  // 单遍模式 (ConverterStep) 复用此函数，保证报告格式一致。
+  static bool ReportResults(PipelineContext &context,
+                            const std::vector<FileValidation> &results);
 };
 
 } // namespace core::pipeline
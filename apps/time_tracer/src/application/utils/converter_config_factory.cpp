@@ -1,6 +1,7 @@
 ﻿// application/utils/converter_config_factory.cpp
 #include "application/utils/converter_config_factory.hpp"
 #include "config/loaders/converter_loader.hpp"
+#include "converter/convert/core/activity_dictionary.hpp"
 #include <iostream>
 
 namespace fs = std::filesystem;
@@ -25,6 +26,10 @@ ConverterConfigFactory::Create(core::interfaces::IFileSystem &fs,
         path_val.string();
   }
 
+  // 3. [新增] 映射表定型后编译一次驻留字典，所有文件/线程共享
+  config.mapper_config_.compiled_dictionary_ =
+      std::make_shared<const ActivityDictionary>(config.mapper_config_);
+
   return config;
 }
 
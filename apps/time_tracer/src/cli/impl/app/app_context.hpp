@@ -3,6 +3,7 @@
 #define CLI_IMPL_APP_APP_CONTEXT_HPP_
 
 #include "common/config/app_config.hpp"
+#include <functional>
 #include <memory>
 
 class IWorkflowHandler;
@@ -17,6 +18,10 @@ class ILogConverter; // [新增] 前向声明 Converter 接口
 struct AppContext {
   std::shared_ptr<IWorkflowHandler> workflow_handler_;
   std::shared_ptr<IReportHandler> report_handler_;
+  // [新增] 延迟创建 ReportHandler：先导入再导出的命令在导入完成后才打开数据库
+  std::function<std::shared_ptr<IReportHandler>()> report_handler_factory_;
+  // [新增] 显式升级数据库模式；数据库不存在或失败时返回 false
+  std::function<bool()> schema_migrator_;
 
   std::shared_ptr<core::interfaces::IFileSystem> file_system_;
   std::shared_ptr<core::interfaces::IUserNotifier> user_notifier_;
@@ -2,7 +2,9 @@
 #include "cli/impl/app/cli_application.hpp"
 #include "cli/framework/console_io.hpp"
 #include "cli/impl/app/app_context.hpp"
+#include "cli/impl/utils/arg_utils.hpp"
 #include "cli/impl/utils/help_formatter.hpp"
+#include "core/infrastructure/concurrency/thread_pool_executor.hpp"
 #include "core/infrastructure/persistence/sqlite_report_repository_adapter.hpp"
 #include "io/disk_file_system.hpp"
 
@@ -15,6 +17,7 @@
 #include "converter/log_processor.hpp"
 #include "core/infrastructure/persistence/db_manager.hpp"
 #include "core/infrastructure/reporting/exporter.hpp"
+#include "reports/data/cache/project_name_cache.hpp"
 #include "serializer/json_serializer.hpp"
 
 namespace fs = std::filesystem;
@@ -22,8 +25,8 @@ const std::string DATABASE_FILENAME = "time_data.sqlite3";
 
 static ParserConfig get_app_parser_config() {
   return {{"-o", "--output", "-f", "--format", "--date-check", "--db",
-           "--database"},
-          {"--save-processed", "--no-save", "--no-date-check"}};
+           "--database", "-j", "--jobs"},
+          {"--save-processed", "--no-save", "--no-date-check", "--full"}};
 }
 
 CliApplication::CliApplication(const std::vector<std::string> &args)
@@ -86,16 +89,26 @@ CliApplication::CliApplication(const std::vector<std::string> &args)
   db_manager_ = std::make_unique<DBManager>(db_path.string());
 
   // 7. 初始Core Service (WorkflowHandler)
+  // [修改] 导入新建的项目节点同步到报表侧的项目名缓存 (未加载时为空操作)，
+  // 导入层因此不依赖报表模块
+  auto on_project_created = [](long long id, const std::string &name,
+                               long long parent_id) {
+    ProjectNameCache::instance().register_project(id, name, parent_id);
+  };
   auto workflow_impl = std::make_shared<WorkflowHandler>(
       db_path.string(), app_config_, output_root_path_, disk_fs, notifier,
-      serializer, converter);
+      serializer, converter, on_project_created);
   app_context_->workflow_handler_ = workflow_impl;
 
   // 8. 准备报表相关的依    // [核心修复]
   // 仅当命令需要查导出时，才打开数据库并初始ReportRepository
   const std::string command = parser_.GetCommand();
 
-  if (command == "query" || command == "export") {
+  // [修改] 打开数据库并组装 ReportHandler 的过程提取为 lambda，
+  // 以便 ingest-export 在导入完成 (数据库已建立) 之后再调用
+  const bool is_export = command == "export" || command == "ingest-export";
+  auto open_report_handler = [this, db_path, disk_fs, notifier,
+                              is_export]() -> std::shared_ptr<IReportHandler> {
     try {
       // 尝试打开数据库
       if (!db_manager_->CheckAndOpen()) {
@@ -106,26 +119,49 @@ CliApplication::CliApplication(const std::vector<std::string> &args)
       // 获取连接（此时非空）
       sqlite3 *db_connection = db_manager_->GetDbConnection();
 
+      // [新增] 导出命令共享一个线程池 (--jobs，0 表示自动)；
+      // 查询只生成单份报表，不创建线程池
+      std::shared_ptr<core::interfaces::ITaskExecutor> executor;
+      if (is_export) {
+        size_t jobs = 0;
+        if (auto jobs_opt = parser_.GetOption({"-j", "--jobs"})) {
+          jobs = ArgUtils::ParseJobCount(*jobs_opt);
+        }
+        executor =
+            std::make_shared<infrastructure::concurrency::ThreadPoolExecutor>(
+                jobs);
+      }
+
       // 初始Repository
       auto report_repo = std::make_shared<
           infrastructure::persistence::SqliteReportRepositoryAdapter>(
-          db_connection, app_config_.loaded_reports_);
+          db_connection, app_config_.loaded_reports_, executor);
 
       auto report_generator = std::make_unique<ReportGenerator>(report_repo);
-      auto exporter =
-          std::make_unique<Exporter>(exported_files_path_, disk_fs, notifier);
+      auto exporter = std::make_unique<Exporter>(exported_files_path_, disk_fs,
+                                                 notifier, executor);
 
       // [核心修改] 传入 app_config_.exe_dir_path_.string()
-      auto report_impl = std::make_shared<ReportHandler>(
+      return std::make_shared<ReportHandler>(
           std::move(report_generator), std::move(exporter),
           app_config_.exe_dir_path_.string() // <--- 新增参数
       );
-      app_context_->report_handler_ = report_impl;
 
     } catch (const std::exception &e) {
       notifier->NotifyError("Database Error: " + std::string(e.what()));
       throw;
     }
+  };
+
+  // [新增] migrate 命令：显式执行打开数据库时的同一模式升级
+  app_context_->schema_migrator_ = [this]() {
+    return db_manager_->MigrateSchema();
+  };
+
+  if (command == "query" || command == "export") {
+    app_context_->report_handler_ = open_report_handler();
+  } else if (command == "ingest-export") {
+    app_context_->report_handler_factory_ = open_report_handler;
   }
 }
 
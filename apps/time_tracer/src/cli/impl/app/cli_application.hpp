@@ -27,8 +27,10 @@ private:
   CommandParser parser_;
   AppConfig app_config_;
 
-  std::shared_ptr<AppContext> app_context_;
+  // [修改] 成员按声明逆序析构：db_manager_ 须声明在 app_context_ 之前，
+  // 以便报表仓库 (StatementCache) 先 finalize 预编译语句，再关闭数据库
   std::unique_ptr<DBManager> db_manager_;
+  std::shared_ptr<AppContext> app_context_;
 
   std::filesystem::path output_root_path_;
   std::filesystem::path exported_files_path_;
@@ -10,6 +10,7 @@
 #include "cli/impl/utils/arg_utils.hpp"
 #include "common/app_options.hpp"
 #include "common/utils/time_utils.hpp"
+#include <format>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -41,6 +42,14 @@
       return std::make_unique<IngestCommand>(*ctx.workflow_handler_);
     });
 
+[[maybe_unused]] static CommandRegistrar<AppContext>
+    reg_ingest_export("ingest-export", [](AppContext &ctx) {
+      if (!ctx.workflow_handler_)
+        throw std::runtime_error("WorkflowHandler not initialized");
+      return std::make_unique<IngestExportCommand>(
+          *ctx.workflow_handler_, ctx.report_handler_factory_);
+    });
+
 [[maybe_unused]] static CommandRegistrar<AppContext>
     reg_val_logic("validate-logic", [](AppContext &ctx) {
       if (!ctx.serializer_ || !ctx.log_converter_)
@@ -61,6 +70,12 @@
           ctx.log_converter_);
     });
 
+[[maybe_unused]] static CommandRegistrar<AppContext>
+    reg_migrate("migrate", [](AppContext &ctx) {
+      return std::make_unique<MigrateCommand>(ctx.schema_migrator_,
+                                              ctx.user_notifier_);
+    });
+
 [[maybe_unused]] static CommandRegistrar<AppContext>
     reg_export("export", [](AppContext &ctx) {
       return std::make_unique<ExportCommand>(ctx.report_handler_);
@@ -79,7 +94,13 @@ ConvertCommand::ConvertCommand(IWorkflowHandler &workflow_handler)
     : workflow_handler_(workflow_handler) {}
 
 std::vector<ArgDef> ConvertCommand::GetDefinitions() const {
-  return {{"path", ArgType::Positional, {}, "Source file path", true, "", 0}};
+  return {{"path", ArgType::Positional, {}, "Source file path", true, "", 0},
+          {"jobs",
+           ArgType::Option,
+           {"-j", "--jobs"},
+           "Worker threads (0 = hardware concurrency)",
+           false,
+           "0"}};
 }
 
 std::string ConvertCommand::GetHelp() const {
@@ -94,6 +115,7 @@ void ConvertCommand::Execute(const CommandParser &parser) {
   options.save_processed_output_ = true;
   options.validate_logic_ = true;
   options.date_check_mode_ = DateCheckMode::Continuity;
+  options.jobs_ = ArgUtils::ParseJobCount(args.Get("jobs"));
   workflow_handler_.RunConverter(args.Get("path"), options);
 }
 
@@ -131,10 +153,8 @@ void ImportCommand::Execute(const CommandParser &parser) {
 // IngestCommand 实现
 // ============================================================================
 
-IngestCommand::IngestCommand(IWorkflowHandler &workflow_handler)
-    : workflow_handler_(workflow_handler) {}
-
-std::vector<ArgDef> IngestCommand::GetDefinitions() const {
+// [新增] ingest 与 ingest-export 共用的参数定义及日期检查模式解析
+static std::vector<ArgDef> GetIngestDefinitions() {
   return {{"path", ArgType::Positional, {}, "Source directory", true, "", 0},
           {"date_check",
            ArgType::Option,
@@ -159,7 +179,34 @@ std::vector<ArgDef> IngestCommand::GetDefinitions() const {
            {"--no-save"},
            "Do not save processed JSON",
            false,
-           ""}};
+           ""},
+          {"full",
+           ArgType::Flag,
+           {"--full"},
+           "Ignore the source manifest and re-ingest every file",
+           false,
+           ""},
+          {"jobs",
+           ArgType::Option,
+           {"-j", "--jobs"},
+           "Worker threads (0 = hardware concurrency)",
+           false,
+           "0"}};
+}
+
+static DateCheckMode ParseIngestDateCheck(const ParsedArgs &args) {
+  if (args.Has("date_check")) {
+    return ArgUtils::ParseDateCheckMode(args.Get("date_check"));
+  }
+  return args.Has("no_date_check") ? DateCheckMode::None
+                                   : DateCheckMode::Continuity;
+}
+
+IngestCommand::IngestCommand(IWorkflowHandler &workflow_handler)
+    : workflow_handler_(workflow_handler) {}
+
+std::vector<ArgDef> IngestCommand::GetDefinitions() const {
+  return GetIngestDefinitions();
 }
 
 std::string IngestCommand::GetHelp() const {
@@ -168,13 +215,61 @@ std::string IngestCommand::GetHelp() const {
 
 void IngestCommand::Execute(const CommandParser &parser) {
   ParsedArgs args = CommandValidator::Validate(parser, GetDefinitions());
-  DateCheckMode mode =
-      args.Has("date_check")
-          ? ArgUtils::ParseDateCheckMode(args.Get("date_check"))
-          : (args.Has("no_date_check") ? DateCheckMode::None
-                                       : DateCheckMode::Continuity);
+  DateCheckMode mode = ParseIngestDateCheck(args);
   bool save_json = !args.Has("no_save");
-  workflow_handler_.RunIngest(args.Get("path"), mode, save_json);
+  bool full_rebuild = args.Has("full");
+  size_t jobs = ArgUtils::ParseJobCount(args.Get("jobs"));
+  workflow_handler_.RunIngest(args.Get("path"), mode, save_json, full_rebuild,
+                              jobs);
+}
+
+// ============================================================================
+// IngestExportCommand 实现
+// ============================================================================
+
+IngestExportCommand::IngestExportCommand(
+    IWorkflowHandler &workflow_handler,
+    ReportHandlerFactory report_handler_factory)
+    : workflow_handler_(workflow_handler),
+      report_handler_factory_(std::move(report_handler_factory)) {}
+
+std::vector<ArgDef> IngestExportCommand::GetDefinitions() const {
+  // [修改] 在 ingest 的参数之后追加导出参数
+  std::vector<ArgDef> defs = GetIngestDefinitions();
+  defs.push_back({"format",
+                  ArgType::Option,
+                  {"-f", "--format"},
+                  "Output formats",
+                  false,
+                  "md,tex,typ"});
+  defs.push_back({"output",
+                  ArgType::Option,
+                  {"-o", "--output"},
+                  "Output directory",
+                  false,
+                  ""});
+  return defs;
+}
+
+std::string IngestExportCommand::GetHelp() const {
+  return "Ingest raw logs, then export every day and period report in all "
+         "formats from a single data load.";
+}
+
+void IngestExportCommand::Execute(const CommandParser &parser) {
+  ParsedArgs args = CommandValidator::Validate(parser, GetDefinitions());
+  DateCheckMode mode = ParseIngestDateCheck(args);
+  size_t jobs = ArgUtils::ParseJobCount(args.Get("jobs"));
+  workflow_handler_.RunIngest(args.Get("path"), mode, !args.Has("no_save"),
+                              args.Has("full"), jobs);
+
+  // 导入完成后才打开数据库，报表数据在所有格式之间共享
+  if (!report_handler_factory_) {
+    throw std::runtime_error("ReportHandler factory not initialized");
+  }
+  std::shared_ptr<IReportHandler> report_handler = report_handler_factory_();
+  report_handler->RunExportAllFormatsQuery(
+      ArgUtils::ParseReportFormats(args.Get("format")));
 }
 
 // ============================================================================
@@ -205,7 +300,13 @@ std::vector<ArgDef> ValidateLogicCommand::GetDefinitions() const {
        {"--no-date-check"},
        "Disable date check",
        false,
-       ""}};
+       ""},
+      {"jobs",
+       ArgType::Option,
+       {"-j", "--jobs"},
+       "Worker threads (0 = hardware concurrency)",
+       false,
+       "0"}};
 }
 
 std::string ValidateLogicCommand::GetHelp() const {
@@ -223,9 +324,12 @@ void ValidateLogicCommand::Execute(const CommandParser &parser) {
           ? DateCheckMode::None
           : ArgUtils::ParseDateCheckMode(args.Get("date_check"));
 
+  options.jobs_ = ArgUtils::ParseJobCount(args.Get("jobs"));
+
   core::pipeline::PipelineContext context(app_config_, output_root_, fs_,
                                           notifier_);
   context.config.input_root_ = options.input_path_;
+  context.config.jobs_ = options.jobs_;
   auto pipeline = core::pipeline::PipelineFactory::CreateIngestPipeline(
       options, app_config_, serializer_, converter_);
   pipeline->Run(std::move(context));
@@ -252,7 +356,13 @@ std::vector<ArgDef> ValidateStructureCommand::GetDefinitions() const {
            "Source directory or file path",
            true,
            "",
-           0}};
+           0},
+          {"jobs",
+           ArgType::Option,
+           {"-j", "--jobs"},
+           "Worker threads (0 = hardware concurrency)",
+           false,
+           "0"}};
 }
 
 std::string ValidateStructureCommand::GetHelp() const {
@@ -264,14 +374,42 @@ void ValidateStructureCommand::Execute(const CommandParser &parser) {
   AppOptions options;
   options.input_path_ = args.Get("path");
   options.validate_structure_ = true;
+  options.jobs_ = ArgUtils::ParseJobCount(args.Get("jobs"));
   core::pipeline::PipelineContext context(app_config_, output_root_, fs_,
                                           notifier_);
   context.config.input_root_ = options.input_path_;
+  context.config.jobs_ = options.jobs_;
   auto pipeline = core::pipeline::PipelineFactory::CreateIngestPipeline(
       options, app_config_, serializer_, converter_);
   pipeline->Run(std::move(context));
 }
 
+// ============================================================================
+// MigrateCommand 实现
+// ============================================================================
+
+MigrateCommand::MigrateCommand(
+    std::function<bool()> migrate,
+    std::shared_ptr<core::interfaces::IUserNotifier> notifier)
+    : migrate_(std::move(migrate)), notifier_(std::move(notifier)) {}
+
+std::vector<ArgDef> MigrateCommand::GetDefinitions() const { return {}; }
+
+std::string MigrateCommand::GetHelp() const {
+  return "Upgrade an existing database to the current schema version.";
+}
+
+void MigrateCommand::Execute(const CommandParser &parser) {
+  CommandValidator::Validate(parser, GetDefinitions());
+  if (!migrate_)
+    throw std::runtime_error("Schema migrator not initialized");
+  if (!migrate_()) {
+    throw std::runtime_error(
+        "Schema migration failed (missing or read-only database).");
+  }
+  notifier_->NotifySuccess("Database schema is up to date.");
+}
+
 // ============================================================================
 // ExportCommand 实现
 // ============================================================================
@@ -284,7 +422,8 @@ std::vector<ArgDef> ExportCommand::GetDefinitions() const {
            ArgType::Positional,
            {},
            "Export scope: day, month, week, year, recent, range, "
-           "all-day, all-month, all-week, all-year, all-recent",
+           "all-day, all-month, all-week, all-year, all-recent, "
+           "all-biweek, all-quarter, all-half, all-period",
            true,
            "",
            0},
@@ -319,7 +458,13 @@ std::vector<ArgDef> ExportCommand::GetDefinitions() const {
            {"--db", "--database"},
            "Database path",
            false,
-           ""}};
+           ""},
+          {"jobs",
+           ArgType::Option,
+           {"-j", "--jobs"},
+           "Worker threads for all-* exports (0 = hardware concurrency)",
+           false,
+           "0"}};
 }
 
 std::string ExportCommand::GetHelp() const {
@@ -421,6 +566,21 @@ void ExportCommand::Execute(const CommandParser &parser) {
       report_handler_->RunExportAllYearlyReportsQuery(format);
     } else if (sub_command == "all-week") {
       report_handler_->RunExportAllWeeklyReportsQuery(format);
+    } else if (sub_command == "all-biweek") {
+      report_handler_->RunExportAllPeriodReportsQuery({ReportPeriod::BiWeek},
+                                                      format);
+    } else if (sub_command == "all-quarter") {
+      report_handler_->RunExportAllPeriodReportsQuery({ReportPeriod::Quarter},
+                                                      format);
+    } else if (sub_command == "all-half") {
+      report_handler_->RunExportAllPeriodReportsQuery(
+          {ReportPeriod::HalfYear}, format);
+    } else if (sub_command == "all-period") {
+      // [新增] 周 / 双周 / 月 / 季度 / 半年 / 年报，一次汇总全部生成
+      report_handler_->RunExportAllPeriodReportsQuery(
+          {ReportPeriod::Week, ReportPeriod::BiWeek, ReportPeriod::Month,
+           ReportPeriod::Quarter, ReportPeriod::HalfYear, ReportPeriod::Year},
+          format);
     } else {
       throw std::runtime_error("Unknown export type '" + sub_command + "'.");
     }
@@ -439,21 +599,23 @@ std::vector<ArgDef> QueryCommand::GetDefinitions() const {
       {"type",
        ArgType::Positional,
        {},
-       "Query scope: day, month, week, year, recent, range",
+       "Query scope: day, month, week, year, recent, range, compare",
        true,
        "",
        0},
       {"argument",
        ArgType::Positional,
        {},
-       "Date (YYYY-MM-DD), Month (YYYY-MM), Year (YYYY), StartDate, or Days",
+       "Date (YYYY-MM-DD), Month (YYYY-MM), Year (YYYY), StartDate, Days, "
+       "or Period (compare)",
        true,
        "",
        1},
       {"week_num",
        ArgType::Positional,
        {},
-       "Week number or EndDate (required for 'week' or 'range' type)",
+       "Week number or EndDate (required for 'week' or 'range' type; "
+       "optional week number for 'compare')",
        false,
        "",
        2},
@@ -488,6 +650,18 @@ void QueryCommand::Execute(const CommandParser &parser) {
     query_arg = TimeUtils::NormalizeToDateFormat(query_arg);
   } else if (sub_command == "month") {
     query_arg = TimeUtils::NormalizeToMonthFormat(query_arg);
+  } else if (sub_command == "compare") {
+    // [新增] compare <year> [week_num] | compare <year-month>
+    if (!week_arg.empty()) {
+      try {
+        query_arg = std::format("{}-W{:02d}", std::stoi(query_arg),
+                                std::stoi(week_arg));
+      } catch (const std::exception &) {
+        throw std::runtime_error("Invalid year or week number.");
+      }
+    } else {
+      query_arg = TimeUtils::NormalizeToMonthFormat(query_arg);
+    }
   }
 
   for (size_t i = 0; i < formats.size(); ++i) {
@@ -552,10 +726,12 @@ void QueryCommand::Execute(const CommandParser &parser) {
       std::string end_normalized = TimeUtils::NormalizeRangeEnd(week_arg);
       std::cout << report_handler_->RunRangeQuery(start_normalized,
                                                   end_normalized, format);
+    } else if (sub_command == "compare") {
+      std::cout << report_handler_->RunComparisonQuery(query_arg, format);
     } else {
       throw std::runtime_error("Unknown query type '" + sub_command +
                                "'. Supported: day, week, month, year, "
-                               "recent, range.");
+                               "recent, range, compare.");
     }
   }
 }
@@ -12,6 +12,7 @@
 #include "core/domain/ports/i_file_system.hpp"
 #include "core/domain/ports/i_user_notifier.hpp"
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -53,6 +54,22 @@ private:
   IWorkflowHandler &workflow_handler_;
 };
 
+// [新增] 导入后一次性导出全部日期、全部格式的报表
+class IngestExportCommand : public ICommand {
+public:
+  using ReportHandlerFactory = std::function<std::shared_ptr<IReportHandler>()>;
+
+  IngestExportCommand(IWorkflowHandler &workflow_handler,
+                      ReportHandlerFactory report_handler_factory);
+  std::vector<ArgDef> GetDefinitions() const override;
+  std::string GetHelp() const override;
+  void Execute(const CommandParser &parser) override;
+
+private:
+  IWorkflowHandler &workflow_handler_;
+  ReportHandlerFactory report_handler_factory_;
+};
+
 // ============================================================================
 // Validate Commands - 基于 Pipeline 逻辑的校验命�?
 // ============================================================================
@@ -101,6 +118,26 @@ private:
   std::shared_ptr<core::interfaces::ILogConverter> converter_;
 };
 
+// ============================================================================
+// Migrate Command - 数据库模式升级命令
+// ============================================================================
+
+// [新增] 显式升级数据库模式 (打开数据库时也会自动尝试一次)，
+// 可用于在导出前单独完成升级或确认升级结果
+class MigrateCommand : public ICommand {
+public:
+  MigrateCommand(std::function<bool()> migrate,
+                 std::shared_ptr<core::interfaces::IUserNotifier> notifier);
+
+  std::vector<ArgDef> GetDefinitions() const override;
+  std::string GetHelp() const override;
+  void Execute(const CommandParser &parser) override;
+
+private:
+  std::function<bool()> migrate_;
+  std::shared_ptr<core::interfaces::IUserNotifier> notifier_;
+};
+
 // ============================================================================
 // Export Command - 报表导出命令
 // ============================================================================
@@ -52,6 +52,22 @@ public:
       throw std::runtime_error("Invalid date check mode: '" + mode_str + "'");
     }
   }
+
+  // [新增] 解析 --jobs (0 或缺省表示使用 hardware_concurrency)
+  static size_t ParseJobCount(const std::string &jobs_str) {
+    if (jobs_str.empty()) {
+      return 0;
+    }
+    try {
+      size_t pos = 0;
+      int jobs = std::stoi(jobs_str, &pos);
+      if (pos == jobs_str.size() && jobs >= 0) {
+        return static_cast<size_t>(jobs);
+      }
+    } catch (...) {
+    }
+    throw std::runtime_error("Invalid job count: '" + jobs_str + "'");
+  }
 };
 
 #endif // CLI_IMPL_UTILS_ARG_UTILS_HPP_
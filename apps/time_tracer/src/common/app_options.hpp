@@ -3,6 +3,7 @@
 #define COMMON_APP_OPTIONS_HPP_
 
 #include "common/types/date_check_mode.hpp"
+#include <cstddef>
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -15,6 +16,10 @@ struct AppOptions {
   bool validate_logic_ = false;
   DateCheckMode date_check_mode_ = DateCheckMode::None;
   bool save_processed_output_ = false;
+  // [新增] 并行任务线程数 (--jobs)，0 表示自动
+  size_t jobs_ = 0;
+  // [新增] 结构验证与转换合并为单遍 (ingest 默认开启)
+  bool single_pass_validation_ = false;
 };
 
 #endif // COMMON_APP_OPTIONS_HPP_
@@ -2,11 +2,15 @@
 #ifndef COMMON_CONFIG_MODELS_CONVERTER_CONFIG_MODELS_HPP_
 #define COMMON_CONFIG_MODELS_CONVERTER_CONFIG_MODELS_HPP_
 
+#include "common/utils/civil_time.hpp"
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class ActivityDictionary; // converter/convert/core/activity_dictionary.hpp
+
 struct DurationMappingRule {
   int less_than_minutes_ = 0;
   std::string value_;
@@ -27,6 +31,12 @@ struct LogMapperConfig {
       duration_mappings_;
   std::unordered_map<std::string, std::string> top_parent_mapping_;
   std::unordered_map<std::string, std::string> initial_top_parents_;
+
+  // [新增] 时间戳计算使用的时区规则 (配置项 utc_offset，默认 "local")
+  TimeUtils::TimeZoneRule time_zone_;
+
+  // [新增] 由上面各映射表预编译得到的只读字典；为空时转换器按需自行构建
+  std::shared_ptr<const ActivityDictionary> compiled_dictionary_;
 };
 
 // 3. 链接器专用配置
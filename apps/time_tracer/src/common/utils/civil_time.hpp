@@ -0,0 +1,209 @@
+﻿// common/utils/civil_time.hpp
+#ifndef COMMON_UTILS_CIVIL_TIME_HPP_
+#define COMMON_UTILS_CIVIL_TIME_HPP_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// [新增] 纯算术的民用日期/时间内核 (constexpr + noexcept)
+// 取代 stringstream + std::get_time + std::mktime：
+// 不分配内存、不读取区域设置，也不会争用 mktime 的进程级时区锁。
+namespace TimeUtils {
+
+inline constexpr long long kSecondsPerDay = 24LL * 60 * 60;
+
+/**
+ * @brief 时区规则
+ * use_local_ = true 时沿用进程本地时区 (与旧 mktime 行为一致，按日采样偏移)；
+ * 否则使用固定的 UTC 偏移 utc_offset_minutes_ (例如 +08:00 -> 480)。
+ */
+struct TimeZoneRule {
+  bool use_local_ = true;
+  int utc_offset_minutes_ = 0;
+};
+
+struct CivilDate {
+  int year_ = 0;
+  int month_ = 0;
+  int day_ = 0;
+};
+
+/// 解析 s[pos, pos+width) 处的定宽十进制数字，遇到非数字返回 -1
+constexpr int ParseFixedDigits(std::string_view s, size_t pos,
+                               size_t width) noexcept {
+  if (pos + width > s.size()) {
+    return -1;
+  }
+  int value = 0;
+  for (size_t i = pos; i < pos + width; ++i) {
+    char c = s[i];
+    if (c < '0' || c > '9') {
+      return -1;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+/// 1970-01-01 起的天数 (proleptic Gregorian, H. Hinnant days_from_civil)
+constexpr long long DaysFromCivil(int year, int month, int day) noexcept {
+  year -= month <= 2 ? 1 : 0;
+  const long long era = (year >= 0 ? year : year - 399) / 400;
+  const unsigned yoe = static_cast<unsigned>(year - era * 400);
+  const unsigned mp = static_cast<unsigned>(month + (month > 2 ? -3 : 9));
+  const unsigned doy = (153 * mp + 2) / 5 + static_cast<unsigned>(day) - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+/// DaysFromCivil 的逆运算 (H. Hinnant civil_from_days)
+constexpr CivilDate CivilFromDays(long long days) noexcept {
+  days += 719468;
+  const long long era = (days >= 0 ? days : days - 146096) / 146097;
+  const unsigned doe = static_cast<unsigned>(days - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  const int day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  const int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  const int year = static_cast<int>(static_cast<long long>(yoe) + era * 400) +
+                   (month <= 2 ? 1 : 0);
+  return {year, month, day};
+}
+
+/// [新增] ISO 8601 周：周一为一周首日，周四所在年份即 ISO 年
+struct IsoWeek {
+  int year_ = 0;
+  int week_ = 0;
+  long long monday_days_ = 0; // 该周周一距 1970-01-01 的天数
+};
+
+constexpr IsoWeek IsoWeekFromDays(long long days) noexcept {
+  // 1970-01-01 为周四；weekday: 周一 = 0 ... 周日 = 6
+  const long long weekday = ((days % 7) + 7 + 3) % 7;
+  const long long monday = days - weekday;
+  const int iso_year = CivilFromDays(monday + 3).year_;
+  const long long jan1 = DaysFromCivil(iso_year, 1, 1);
+  const int week = static_cast<int>((monday + 3 - jan1) / 7 + 1);
+  return {iso_year, week, monday};
+}
+
+/// 解析 "YYYY-MM-DD" (允许尾随内容)，仅校验月份/日期范围
+constexpr bool ParseCivilDate(std::string_view s, CivilDate &out) noexcept {
+  if (s.size() < 10 || s[4] != '-' || s[7] != '-') {
+    return false;
+  }
+  const int year = ParseFixedDigits(s, 0, 4);
+  const int month = ParseFixedDigits(s, 5, 2);
+  const int day = ParseFixedDigits(s, 8, 2);
+  if (year < 0 || month < 1 || month > 12 || day < 1 || day > 31) {
+    return false;
+  }
+  out = {year, month, day};
+  return true;
+}
+
+/// 解析 "HH:MM" 为当日秒数，格式非法返回 -1
+constexpr int ParseClockSeconds(std::string_view s) noexcept {
+  if (s.size() < 5 || s[2] != ':') {
+    return -1;
+  }
+  const int hour = ParseFixedDigits(s, 0, 2);
+  const int minute = ParseFixedDigits(s, 3, 2);
+  if (hour < 0 || minute < 0 || minute > 59) {
+    return -1;
+  }
+  return (hour * 60 + minute) * 60;
+}
+
+/// [新增] 解析 "HH:MM" 为当日分钟数 (数据库 start/end 列)，非法返回 -1
+constexpr int ParseClockMinutes(std::string_view s) noexcept {
+  const int seconds = ParseClockSeconds(s);
+  return seconds < 0 ? -1 : seconds / 60;
+}
+
+/// [新增] 解析 "YYYY-MM-DD" 为 1970-01-01 起的天数 (数据库 date 列)；
+/// 与 ParseCivilDate 不同，日期必须在当月天数之内 (2024-02-30 非法)
+constexpr bool ParseDayNumber(std::string_view s, long long &out) noexcept {
+  CivilDate date;
+  if (!ParseCivilDate(s, date)) {
+    return false;
+  }
+  const long long days = DaysFromCivil(date.year_, date.month_, date.day_);
+  if (CivilFromDays(days).day_ != date.day_) {
+    return false;
+  }
+  out = days;
+  return true;
+}
+
+/// [新增] 天数 -> "YYYY-MM-DD"，仅在展示/输出时调用
+inline std::string FormatDayNumber(long long days) {
+  const CivilDate date = CivilFromDays(days);
+  std::string text(10, '-');
+  auto put = [&text](size_t pos, int width, int value) {
+    for (int i = width - 1; i >= 0; --i, value /= 10) {
+      text[pos + i] = static_cast<char>('0' + value % 10);
+    }
+  };
+  put(0, 4, date.year_);
+  put(5, 2, date.month_);
+  put(8, 2, date.day_);
+  return text;
+}
+
+/// 解析 "local" / "Z" / "UTC" / "+HH:MM" / "-HH:MM"
+constexpr bool ParseTimeZoneRule(std::string_view s,
+                                 TimeZoneRule &out) noexcept {
+  if (s.empty() || s == "local") {
+    out = {};
+    return true;
+  }
+  if (s == "Z" || s == "UTC") {
+    out = {false, 0};
+    return true;
+  }
+  if (s.size() != 6 || (s[0] != '+' && s[0] != '-')) {
+    return false;
+  }
+  const int offset_seconds = ParseClockSeconds(s.substr(1));
+  if (offset_seconds < 0 || offset_seconds > 14 * 3600) {
+    return false;
+  }
+  const int minutes = offset_seconds / 60;
+  out = {false, s[0] == '-' ? -minutes : minutes};
+  return true;
+}
+
+/// 民用日期 + 当日秒数 -> Unix 时间戳 (已知 UTC 偏移)
+constexpr long long CivilToTimestamp(const CivilDate &date,
+                                     int seconds_of_day,
+                                     long long utc_offset_seconds) noexcept {
+  return DaysFromCivil(date.year_, date.month_, date.day_) * kSecondsPerDay +
+         seconds_of_day - utc_offset_seconds;
+}
+
+static_assert(DaysFromCivil(1970, 1, 1) == 0);
+static_assert(DaysFromCivil(2000, 3, 1) == 11017);
+static_assert(DaysFromCivil(2024, 2, 29) == 19782);
+static_assert(CivilFromDays(19782).month_ == 2 &&
+              CivilFromDays(19782).day_ == 29);
+static_assert(CivilFromDays(-1).year_ == 1969);
+// 2021-01-03 (周日) 属于 2020-W53；2024-12-30 (周一) 属于 2025-W01
+static_assert(IsoWeekFromDays(DaysFromCivil(2021, 1, 3)).year_ == 2020 &&
+              IsoWeekFromDays(DaysFromCivil(2021, 1, 3)).week_ == 53);
+static_assert(IsoWeekFromDays(DaysFromCivil(2024, 12, 30)).year_ == 2025 &&
+              IsoWeekFromDays(DaysFromCivil(2024, 12, 30)).week_ == 1);
+static_assert(ParseClockSeconds("23:59") == 86340);
+static_assert(ParseClockSeconds("2a:00") == -1);
+static_assert(ParseClockMinutes("08:30") == 510);
+static_assert([] {
+  long long days = 0;
+  return ParseDayNumber("2024-02-29", days) && days == 19782 &&
+         !ParseDayNumber("2023-02-29", days);
+}());
+
+} // namespace TimeUtils
+
+#endif // COMMON_UTILS_CIVIL_TIME_HPP_
@@ -0,0 +1,102 @@
+﻿// common/utils/log_line_tokenizer.cpp
+#include "common/utils/log_line_tokenizer.hpp"
+
+namespace {
+
+constexpr std::string_view kWhitespace = " \n\r\t\f\v";
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool AllDigits(std::string_view str) {
+  for (char c : str) {
+    if (!IsDigit(c))
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+std::string_view TrimView(std::string_view str) {
+  size_t first = str.find_first_not_of(kWhitespace);
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  size_t last = str.find_last_not_of(kWhitespace);
+  return str.substr(first, last - first + 1);
+}
+
+LogLineTokenizer::LogLineTokenizer(std::string_view buffer,
+                                   std::string_view remark_prefix)
+    : buffer_(buffer), remark_prefix_(remark_prefix) {}
+
+bool LogLineTokenizer::Next(LogLineToken &token) {
+  while (position_ < buffer_.size()) {
+    size_t line_end = buffer_.find('\n', position_);
+    if (line_end == std::string_view::npos) {
+      line_end = buffer_.size();
+    }
+    std::string_view line = buffer_.substr(position_, line_end - position_);
+    position_ = line_end + 1;
+    ++line_number_;
+
+    std::string_view trimmed = TrimView(line);
+    if (trimmed.empty()) {
+      continue;
+    }
+
+    token = LogLineToken{};
+    token.line_number = line_number_;
+    token.text = trimmed;
+    Classify(token);
+    return true;
+  }
+  return false;
+}
+
+void LogLineTokenizer::Classify(LogLineToken &token) const {
+  std::string_view text = token.text;
+
+  if (text.size() == 5 && text[0] == 'y' && AllDigits(text.substr(1))) {
+    token.kind = LogLineKind::Year;
+    return;
+  }
+
+  if (text.size() == 4 && AllDigits(text)) {
+    token.kind = LogLineKind::Date;
+    return;
+  }
+
+  if (!remark_prefix_.empty() && text.starts_with(remark_prefix_)) {
+    token.kind = LogLineKind::Remark;
+    token.remark_body = text.substr(remark_prefix_.size());
+    return;
+  }
+
+  if (text.size() >= 5 && AllDigits(text.substr(0, 4))) {
+    token.kind = LogLineKind::Event;
+    token.time = text.substr(0, 4);
+    token.hour = (text[0] - '0') * 10 + (text[1] - '0');
+    token.minute = (text[2] - '0') * 10 + (text[3] - '0');
+
+    // 注释符取最靠前的一个: "//", "#", ";"
+    std::string_view remaining = text.substr(4);
+    size_t comment_pos = remaining.find_first_of("/#;");
+    while (comment_pos != std::string_view::npos &&
+           remaining[comment_pos] == '/' &&
+           remaining.substr(comment_pos, 2) != "//") {
+      comment_pos = remaining.find_first_of("/#;", comment_pos + 1);
+    }
+
+    if (comment_pos == std::string_view::npos) {
+      token.description = TrimView(remaining);
+    } else {
+      size_t delim_len = (remaining[comment_pos] == '/') ? 2 : 1;
+      token.description = TrimView(remaining.substr(0, comment_pos));
+      token.remark = TrimView(remaining.substr(comment_pos + delim_len));
+    }
+    return;
+  }
+
+  token.kind = LogLineKind::Other;
+}
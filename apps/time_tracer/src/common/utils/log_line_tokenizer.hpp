@@ -0,0 +1,63 @@
+﻿// common/utils/log_line_tokenizer.hpp
+#ifndef COMMON_UTILS_LOG_LINE_TOKENIZER_HPP_
+#define COMMON_UTILS_LOG_LINE_TOKENIZER_HPP_
+
+#include <string_view>
+
+/**
+ * @brief 源日志行的结构类别 (仅按格式判断，不做业务校验)。
+ */
+enum class LogLineKind {
+  Year,   // "y2025"
+  Date,   // "0101"
+  Remark, // 以 remark_prefix 开头
+  Event,  // 以 4 位数字 (HHMM) 开头且长度 >= 5
+  Other
+};
+
+/**
+ * @brief 一行源日志的切分结果。所有 string_view 均指向原始缓冲区，
+ *        在缓冲区生命周期内有效。
+ */
+struct LogLineToken {
+  LogLineKind kind = LogLineKind::Other;
+  int line_number = 0;
+
+  std::string_view text; // 去除首尾空白后的整行
+
+  // Remark: remark_prefix 之后的内容 (未去空白)
+  std::string_view remark_body;
+
+  // Event
+  std::string_view time; // "HHMM"
+  int hour = 0;
+  int minute = 0;
+  std::string_view description; // 注释符之前的内容 (已去空白)
+  std::string_view remark;      // 注释符 ("//", "#", ";") 之后的内容 (已去空白)
+};
+
+/**
+ * @class LogLineTokenizer
+ * @brief 在连续缓冲区上逐行切分源日志，供 TextParser 与 TextValidator 共用。
+ * @details 不分配内存；空行被跳过，但行号仍按原文件计数。
+ */
+class LogLineTokenizer {
+public:
+  LogLineTokenizer(std::string_view buffer, std::string_view remark_prefix);
+
+  // 读取下一条非空行；没有更多行时返回 false
+  bool Next(LogLineToken &token);
+
+private:
+  void Classify(LogLineToken &token) const;
+
+  std::string_view buffer_;
+  std::string_view remark_prefix_;
+  size_t position_ = 0;
+  int line_number_ = 0;
+};
+
+// 去除首尾空白 (与 Trim 使用相同的空白字符集)，不分配内存
+std::string_view TrimView(std::string_view str);
+
+#endif // COMMON_UTILS_LOG_LINE_TOKENIZER_HPP_
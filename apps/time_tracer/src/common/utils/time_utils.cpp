@@ -3,8 +3,6 @@
 #include <algorithm>
 #include <cctype>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -22,23 +20,18 @@ int CalculateDurationSeconds(const std::string &start_time_str,
   // 简单校验格式 HH:MM
   if (start_time_str.length() != 5 || end_time_str.length() != 5)
     return 0;
-  try {
-    int start_hour = std::stoi(start_time_str.substr(0, 2));
-    int start_min = std::stoi(start_time_str.substr(3, 2));
-    int end_hour = std::stoi(end_time_str.substr(0, 2));
-    int end_min = std::stoi(end_time_str.substr(3, 2));
-
-    int start_sec = (start_hour * 60 + start_min) * 60;
-    int end_sec = (end_hour * 60 + end_min) * 60;
-
-    // 如果结束时间小于开始时间，视为跨天（+24小时）
-    if (end_sec < start_sec) {
-      end_sec += 24 * 60 * 60;
-    }
-    return end_sec - start_sec;
-  } catch (...) {
+
+  // [修改] 定宽数字解析，替代 4 次 substr + stoi
+  int start_sec = ParseClockSeconds(start_time_str);
+  int end_sec = ParseClockSeconds(end_time_str);
+  if (start_sec < 0 || end_sec < 0)
     return 0;
+
+  // 如果结束时间小于开始时间，视为跨天（+24小时）
+  if (end_sec < start_sec) {
+    end_sec += 24 * 60 * 60;
   }
+  return end_sec - start_sec;
 }
 
 int CalculateDurationMinutes(const std::string &start_time_str,
@@ -46,19 +39,39 @@ int CalculateDurationMinutes(const std::string &start_time_str,
   return CalculateDurationSeconds(start_time_str, end_time_str) / 60;
 }
 
-long long TimeStringToTimestamp(const std::string &date,
-                                const std::string &time, bool is_end_time,
-                                long long start_timestamp_for_end) {
-  if (date.length() < 10 || time.length() < 5)
-    return 0;
+long long ResolveUtcOffsetSeconds(const CivilDate &date,
+                                  const TimeZoneRule &time_zone) {
+  if (!time_zone.use_local_) {
+    return static_cast<long long>(time_zone.utc_offset_minutes_) * 60;
+  }
+
+  // 与旧实现保持一致：tm_isdst = 0，按当日正午采样本地偏移
   std::tm t = {};
-  std::string datetime_str = date + " " + time;
-  std::stringstream ss(datetime_str);
-  ss >> std::get_time(&t, "%Y-%m-%d %H:%M");
-  if (ss.fail())
+  t.tm_year = date.year_ - 1900;
+  t.tm_mon = date.month_ - 1;
+  t.tm_mday = date.day_;
+  t.tm_hour = 12;
+  const long long local = std::mktime(&t);
+  if (local == -1)
+    return 0;
+  return CivilToTimestamp(date, 12 * 3600, 0) - local;
+}
+
+long long TimeStringToTimestamp(std::string_view date, std::string_view time,
+                                bool is_end_time,
+                                long long start_timestamp_for_end,
+                                const TimeZoneRule &time_zone) {
+  // [修改] 使用 civil_time 内核，不再构造 stringstream / get_time
+  CivilDate civil_date;
+  if (!ParseCivilDate(date, civil_date))
+    return 0;
+  int seconds_of_day = ParseClockSeconds(time);
+  if (seconds_of_day < 0)
     return 0;
 
-  long long timestamp = std::mktime(&t);
+  long long timestamp =
+      CivilToTimestamp(civil_date, seconds_of_day,
+                       ResolveUtcOffsetSeconds(civil_date, time_zone));
 
   // 如果是结束时间，且计算出的时间戳小于开始时间，说明跨天了，加一天
   if (is_end_time && timestamp < start_timestamp_for_end) {
@@ -72,15 +85,10 @@ long long TimeStringToTimestamp(const std::string &date,
 int TimeStrToSeconds(const std::string &time_str_in) {
   // 复用 formatTime 逻辑
   std::string time_str = FormatTime(time_str_in);
-  if (time_str.length() != 5 || time_str[2] != ':')
-    return 0;
-  try {
-    int hours = std::stoi(time_str.substr(0, 2));
-    int minutes = std::stoi(time_str.substr(3, 2));
-    return hours * 3600 + minutes * 60;
-  } catch (...) {
+  if (time_str.length() != 5)
     return 0;
-  }
+  int seconds = ParseClockSeconds(time_str);
+  return seconds < 0 ? 0 : seconds;
 }
 
 std::string NormalizeToDateFormat(const std::string &input) {
@@ -2,7 +2,9 @@
 #ifndef COMMON_UTILS_TIME_UTILS_HPP_
 #define COMMON_UTILS_TIME_UTILS_HPP_
 
+#include "common/utils/civil_time.hpp"
 #include <string>
+#include <string_view>
 
 namespace TimeUtils {
 
@@ -35,10 +37,20 @@ int CalculateDurationSeconds(const std::string &startTimeStr,
  * @param is_end_time 是否是结束时间（用于辅助判断跨天）
  * @param start_timestamp_for_end
  * 如果是结束时间，提供开始时间戳以确保结束时间不早于开始时间
+ * @param time_zone 时区规则，默认沿用进程本地时区
  */
-long long TimeStringToTimestamp(const std::string &date,
-                                const std::string &time, bool is_end_time,
-                                long long start_timestamp_for_end);
+long long TimeStringToTimestamp(std::string_view date, std::string_view time,
+                                bool is_end_time,
+                                long long start_timestamp_for_end,
+                                const TimeZoneRule &time_zone = {});
+
+/**
+ * @brief [新增] 求某个民用日期所适用的 UTC 偏移 (秒)
+ * 固定偏移规则直接返回；本地时区规则对该日调用一次 mktime 采样，
+ * 调用方应按日缓存结果，而不是逐条活动调用。
+ */
+long long ResolveUtcOffsetSeconds(const CivilDate &date,
+                                  const TimeZoneRule &time_zone);
 
 // 保留原有的辅助函数（如果有需要可以整合，这里为了兼容性保留定义）
 int TimeStrToSeconds(const std::string &time_str_in);
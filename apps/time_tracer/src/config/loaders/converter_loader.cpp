@@ -110,6 +110,14 @@ void ConverterConfigLoader::ParseTomlToStruct(const toml::table &tbl,
   // 3. 填充 MapperConfig
   config.mapper_config_.wake_keywords_ = config.parser_config_.wake_keywords_;
 
+  // [新增] 时区规则: "local" (默认) / "UTC" / "+08:00"
+  if (auto val = tbl["utc_offset"].value<std::string>()) {
+    if (!TimeUtils::ParseTimeZoneRule(*val, config.mapper_config_.time_zone_)) {
+      throw std::runtime_error("Invalid utc_offset in converter config: " +
+                               *val);
+    }
+  }
+
   auto load_map = [&](const std::string &key,
                       std::unordered_map<std::string, std::string> &target) {
     if (const toml::table *map_tbl = tbl[key].as_table()) {
@@ -187,6 +195,13 @@ bool TomlConverterConfigLoader::load(ConverterConfig &config) {
     // --- 2. Mapper Config ---
     config.mapper_config_.wake_keywords_ = config.parser_config_.wake_keywords_;
 
+    if (auto val = toml_source_["utc_offset"].value<std::string>()) {
+      if (!TimeUtils::ParseTimeZoneRule(*val,
+                                        config.mapper_config_.time_zone_)) {
+        throw std::runtime_error("Invalid utc_offset: " + *val);
+      }
+    }
+
     if (const toml::table *tbl =
             toml_source_["top_parent_mapping"].as_table()) {
       for (const auto &[k, v] : *tbl) {
@@ -0,0 +1,141 @@
+﻿// converter/convert/core/activity_dictionary.cpp
+#include "converter/convert/core/activity_dictionary.hpp"
+#include "common/utils/string_utils.hpp"
+
+ActivityDictionary::ActivityDictionary(const LogMapperConfig &config)
+    : config_(config) {
+  paths_.emplace_back();
+
+  wake_keywords_.insert(config_.wake_keywords_.begin(),
+                        config_.wake_keywords_.end());
+
+  // 校验器接受的原始描述来源于这些表，逐一预编译
+  for (const auto &[key, value] : config_.text_mapping_)
+    Compile(key);
+  for (const auto &[key, value] : config_.text_duration_mapping_)
+    Compile(key);
+  for (const auto &[key, rules] : config_.duration_mappings_)
+    Compile(key);
+  for (const auto &[key, value] : config_.top_parent_mapping_)
+    Compile(key);
+  for (const auto &[key, value] : config_.initial_top_parents_)
+    Compile(key);
+}
+
+std::string
+ActivityDictionary::MapDescription(const std::string &description) const {
+  std::string mapped = description;
+
+  auto map_it = config_.text_mapping_.find(mapped);
+  if (map_it != config_.text_mapping_.end()) {
+    mapped = map_it->second;
+  }
+
+  auto dur_map_it = config_.text_duration_mapping_.find(mapped);
+  if (dur_map_it != config_.text_duration_mapping_.end()) {
+    mapped = dur_map_it->second;
+  }
+  return mapped;
+}
+
+std::optional<std::string>
+ActivityDictionary::BuildProjectPath(const std::string &mapped) const {
+  std::vector<std::string> parts = SplitString(mapped, '_');
+  if (parts.empty()) {
+    return std::nullopt;
+  }
+
+  auto map_it = config_.top_parent_mapping_.find(parts[0]);
+  if (map_it != config_.top_parent_mapping_.end()) {
+    parts[0] = map_it->second;
+  } else {
+    auto init_map_it = config_.initial_top_parents_.find(parts[0]);
+    if (init_map_it != config_.initial_top_parents_.end()) {
+      parts[0] = init_map_it->second;
+    }
+  }
+
+  std::string path;
+  for (size_t i = 0; i < parts.size(); ++i) {
+    if (i > 0) {
+      path += '_';
+    }
+    path += parts[i];
+  }
+  return path;
+}
+
+int ActivityDictionary::Intern(const std::string &mapped) {
+  auto path = BuildProjectPath(mapped);
+  if (!path) {
+    return kNoPathId;
+  }
+
+  auto it = path_ids_.find(*path);
+  if (it != path_ids_.end()) {
+    return it->second;
+  }
+
+  int id = static_cast<int>(paths_.size());
+  paths_.push_back(*path);
+  path_ids_.emplace(std::move(*path), id);
+  return id;
+}
+
+void ActivityDictionary::Compile(const std::string &description) {
+  if (entries_.contains(description)) {
+    return;
+  }
+
+  std::string mapped = MapDescription(description);
+
+  Entry entry;
+  entry.path_id_ = Intern(mapped);
+
+  auto rules_it = config_.duration_mappings_.find(mapped);
+  if (rules_it != config_.duration_mappings_.end()) {
+    entry.duration_rules_.reserve(rules_it->second.size());
+    for (const auto &rule : rules_it->second) {
+      entry.duration_rules_.push_back(
+          {rule.less_than_minutes_, Intern(rule.value_)});
+    }
+  }
+
+  entries_.emplace(description, std::move(entry));
+}
+
+const ActivityDictionary::Entry *
+ActivityDictionary::Find(std::string_view description) const {
+  auto it = entries_.find(description);
+  return it != entries_.end() ? &it->second : nullptr;
+}
+
+bool ActivityDictionary::IsWakeKeyword(std::string_view description) const {
+  return wake_keywords_.find(description) != wake_keywords_.end();
+}
+
+const std::string &ActivityDictionary::GetPath(int path_id) const {
+  if (path_id <= kNoPathId || static_cast<size_t>(path_id) >= paths_.size()) {
+    return paths_[0];
+  }
+  return paths_[path_id];
+}
+
+std::string ActivityDictionary::ResolveUncompiled(
+    const std::string &description,
+    const std::function<int()> &duration_minutes) const {
+  std::string mapped = MapDescription(description);
+
+  auto rules_it = config_.duration_mappings_.find(mapped);
+  if (rules_it != config_.duration_mappings_.end()) {
+    int duration = duration_minutes();
+    for (const auto &rule : rules_it->second) {
+      if (duration < rule.less_than_minutes_) {
+        mapped = rule.value_;
+        break;
+      }
+    }
+  }
+
+  return BuildProjectPath(mapped).value_or(std::string{});
+}
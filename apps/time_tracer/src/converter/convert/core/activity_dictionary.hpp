@@ -0,0 +1,71 @@
+﻿// converter/convert/core/activity_dictionary.hpp
+#ifndef CONVERTER_CONVERT_CORE_ACTIVITY_DICTIONARY_HPP_
+#define CONVERTER_CONVERT_CORE_ACTIVITY_DICTIONARY_HPP_
+
+#include "common/config/models/converter_config_models.hpp"
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// [新增] 活动/项目路径驻留字典
+// 将 LogMapperConfig 一次性编译为符号表：每个可识别的原始描述直接对应
+// 最终项目路径 ID (text / text_duration / top_parent 映射均已预先应用)。
+// 构建后只读，可在多个转换线程之间共享。
+class ActivityDictionary {
+public:
+  // 路径 ID 从 1 开始；0 表示 "不产生活动" 或 "未驻留"
+  static constexpr int kNoPathId = 0;
+
+  struct DurationRule {
+    int less_than_minutes_ = 0;
+    int path_id_ = kNoPathId;
+  };
+
+  struct Entry {
+    int path_id_ = kNoPathId; // 无时长规则命中时使用的路径
+    std::vector<DurationRule> duration_rules_;
+  };
+
+  explicit ActivityDictionary(const LogMapperConfig &config);
+
+  const Entry *Find(std::string_view description) const;
+  bool IsWakeKeyword(std::string_view description) const;
+  const std::string &GetPath(int path_id) const;
+  size_t PathCount() const { return paths_.size() - 1; }
+
+  // 慢路径：未收录的描述按原始映射规则即时求值，结果不驻留。
+  // duration_minutes 仅在存在时长规则时才会被调用。
+  std::string ResolveUncompiled(const std::string &description,
+                                const std::function<int()> &duration_minutes)
+      const;
+
+private:
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+  template <typename Value>
+  using StringMap =
+      std::unordered_map<std::string, Value, StringHash, std::equal_to<>>;
+
+  // 仅保留求值所需的配置副本，使字典不依赖 ConverterConfig 的生命周期
+  LogMapperConfig config_;
+
+  std::vector<std::string> paths_; // 下标即路径 ID，paths_[0] 为占位
+  StringMap<int> path_ids_;
+  StringMap<Entry> entries_;
+  std::unordered_set<std::string, StringHash, std::equal_to<>> wake_keywords_;
+
+  std::string MapDescription(const std::string &description) const;
+  std::optional<std::string> BuildProjectPath(const std::string &mapped) const;
+  int Intern(const std::string &mapped);
+  void Compile(const std::string &description);
+};
+
+#endif // CONVERTER_CONVERT_CORE_ACTIVITY_DICTIONARY_HPP_
@@ -2,17 +2,17 @@
 #ifndef CONVERTER_CONVERT_CORE_ACTIVITY_MAPPER_HPP_
 #define CONVERTER_CONVERT_CORE_ACTIVITY_MAPPER_HPP_
 
-#include "common/config/models/converter_config_models.hpp"
+#include "converter/convert/core/activity_dictionary.hpp"
 #include "core/domain/model/daily_log.hpp"
 
 class ActivityMapper {
 public:
-  // [Fix] 类型重命名: MapperConfig -> LogMapperConfig
-  explicit ActivityMapper(const LogMapperConfig &config);
+  // [修改] 使用预编译的 ActivityDictionary，每个事件只做一次查表
+  explicit ActivityMapper(const ActivityDictionary &dictionary);
   void MapActivities(DailyLog &day);
 
 private:
-  const LogMapperConfig &config_;
+  const ActivityDictionary &dictionary_;
 };
 
 #endif // CONVERTER_CONVERT_CORE_ACTIVITY_MAPPER_HPP_
@@ -1,19 +1,20 @@
 ﻿// converter/convert/core/day_processor.cpp
 #include "converter/convert/core/day_processor.hpp"
-#include "activity_mapper.hpp"
 #include "common/utils/time_utils.hpp"
 #include "day_stats.hpp"
 
 // [Fix] 类型重命名
-DayProcessor::DayProcessor(const LogMapperConfig &config) : config_(config) {}
+DayProcessor::DayProcessor(const LogMapperConfig &config)
+    : dictionary_(config.compiled_dictionary_
+                      ? config.compiled_dictionary_
+                      : std::make_shared<const ActivityDictionary>(config)),
+      activity_mapper_(*dictionary_), time_zone_(config.time_zone_) {}
 
 void DayProcessor::Process(DailyLog &previousDay, DailyLog &dayToProcess) {
   if (dayToProcess.date_.empty())
     return;
 
-  // ActivityMapper 构造函数现在接受 LogMapperConfig
-  ActivityMapper activity_mapper(config_);
-  activity_mapper.MapActivities(dayToProcess);
+  activity_mapper_.MapActivities(dayToProcess);
 
   if (!previousDay.date_.empty() && !previousDay.raw_events_.empty() &&
       !dayToProcess.getup_time_.empty() && !dayToProcess.is_continuation_) {
@@ -39,6 +40,6 @@ void DayProcessor::Process(DailyLog &previousDay, DailyLog &dayToProcess) {
         TimeUtils::FormatTime(previousDay.raw_events_.back().end_time_str_);
   }
 
-  DayStats stats_calculator;
+  DayStats stats_calculator(time_zone_);
   stats_calculator.CalculateStats(dayToProcess);
 }
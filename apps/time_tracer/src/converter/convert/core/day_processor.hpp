@@ -3,7 +3,10 @@
 #define CONVERTER_CONVERT_CORE_DAY_PROCESSOR_HPP_
 
 #include "common/config/models/converter_config_models.hpp"
+#include "converter/convert/core/activity_dictionary.hpp"
+#include "converter/convert/core/activity_mapper.hpp"
 #include "core/domain/model/daily_log.hpp"
+#include <memory>
 
 class DayProcessor {
 public:
@@ -12,7 +15,10 @@ public:
   void Process(DailyLog &previousDay, DailyLog &dayToProcess);
 
 private:
-  const LogMapperConfig &config_;
+  // [修改] 优先复用配置中预编译的字典，否则在此构建一次 (而非每天一次)
+  std::shared_ptr<const ActivityDictionary> dictionary_;
+  ActivityMapper activity_mapper_;
+  TimeUtils::TimeZoneRule time_zone_;
 };
 
 #endif // CONVERTER_CONVERT_CORE_DAY_PROCESSOR_HPP_
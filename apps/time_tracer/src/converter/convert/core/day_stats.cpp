@@ -5,6 +5,9 @@
 #include <algorithm>
 #include <string>
 
+DayStats::DayStats(const TimeUtils::TimeZoneRule &time_zone)
+    : time_zone_(time_zone) {}
+
 void DayStats::CalculateStats(DailyLog &day) {
   day.activity_count_ = day.processed_activities_.size();
   day.stats_ = {};
@@ -21,6 +24,15 @@ void DayStats::CalculateStats(DailyLog &day) {
   } catch (...) {
   }
 
+  // [修改] 日期与 UTC 偏移每天只解析一次，逐条活动只做定宽时间解析
+  TimeUtils::CivilDate civil_date;
+  const bool has_date = TimeUtils::ParseCivilDate(day.date_, civil_date);
+  const long long day_base =
+      has_date ? TimeUtils::CivilToTimestamp(
+                     civil_date, 0,
+                     TimeUtils::ResolveUtcOffsetSeconds(civil_date, time_zone_))
+               : 0;
+
   for (auto &activity : day.processed_activities_) {
     activity.logical_id_ = date_as_long * 10000 + activity_sequence++;
 
@@ -28,10 +40,18 @@ void DayStats::CalculateStats(DailyLog &day) {
     activity.duration_seconds_ = TimeUtils::CalculateDurationSeconds(
         activity.start_time_str_, activity.end_time_str_);
 
-    activity.start_timestamp_ = TimeUtils::TimeStringToTimestamp(
-        day.date_, activity.start_time_str_, false, 0);
-    activity.end_timestamp_ = TimeUtils::TimeStringToTimestamp(
-        day.date_, activity.end_time_str_, true, activity.start_timestamp_);
+    const int start_sec =
+        TimeUtils::ParseClockSeconds(activity.start_time_str_);
+    const int end_sec = TimeUtils::ParseClockSeconds(activity.end_time_str_);
+    activity.start_timestamp_ =
+        (has_date && start_sec >= 0) ? day_base + start_sec : 0;
+    activity.end_timestamp_ =
+        (has_date && end_sec >= 0) ? day_base + end_sec : 0;
+    // 结束时间早于开始时间，说明跨天了，加一天
+    if (activity.end_timestamp_ != 0 &&
+        activity.end_timestamp_ < activity.start_timestamp_) {
+      activity.end_timestamp_ += TimeUtils::kSecondsPerDay;
+    }
 
     if (activity.project_path_.rfind("study", 0) == 0) {
       day.has_study_activity_ = true;
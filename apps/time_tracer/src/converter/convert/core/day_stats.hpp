@@ -2,12 +2,18 @@
 #ifndef CONVERTER_CONVERT_CORE_DAY_STATS_HPP_
 #define CONVERTER_CONVERT_CORE_DAY_STATS_HPP_
 
+#include "common/utils/civil_time.hpp"
 #include "core/domain/model/daily_log.hpp"
 
 class DayStats {
 public:
+  // [新增] 时区规则决定时间戳的 UTC 偏移，默认沿用本地时区
+  explicit DayStats(const TimeUtils::TimeZoneRule &time_zone = {});
   void CalculateStats(DailyLog &day);
   // 移除了私有辅助函数，因为已经转移到了 TimeUtils
+
+private:
+  TimeUtils::TimeZoneRule time_zone_;
 };
 
 #endif // CONVERTER_CONVERT_CORE_DAY_STATS_HPP_
@@ -7,13 +7,12 @@ ConverterService::ConverterService(std::shared_ptr<IParser> parser,
     : parser_(std::move(parser)), processor_(std::move(processor)) {}
 
 void ConverterService::ExecuteConversion(
-    std::istream &combined_input_stream,
-    std::function<void(DailyLog &&)> data_consumer) {
+    std::string_view content, std::function<void(DailyLog &&)> data_consumer) {
   DailyLog previous_day;
   bool has_previous = false;
 
   // [DIP] 使用接口调用
-  parser_->Parse(combined_input_stream, [&](DailyLog &current_day) {
+  parser_->Parse(content, [&](DailyLog &current_day) {
     if (!has_previous) {
       DailyLog empty_day;
       processor_->Process(empty_day, current_day);
@@ -6,7 +6,7 @@
 #include "converter/convert/io/i_parser.hpp" // [DIP] 依赖接口
 #include "core/domain/model/daily_log.hpp"
 #include <functional>
-#include <istream>
+#include <string_view>
 #include <memory>
 
 class ConverterService {
@@ -15,7 +15,7 @@ public:
   ConverterService(std::shared_ptr<IParser> parser,
                    std::shared_ptr<DayProcessor> processor);
 
-  void ExecuteConversion(std::istream &combined_input_stream,
+  void ExecuteConversion(std::string_view content,
                          std::function<void(DailyLog &&)> data_consumer);
 
 private:
@@ -4,7 +4,7 @@
 
 #include "core/domain/model/daily_log.hpp"
 #include <functional>
-#include <iostream>
+#include <string_view>
 
 /**
  * @brief 解析器接口
@@ -15,11 +15,11 @@ public:
   virtual ~IParser() = default;
 
   /**
-   * @brief 解析流
-   * @param inputStream 输入流
+   * @brief 解析内容
+   * @param content 完整的源文件内容 (调用期间必须保持有效)
    * @param onNewDay 当解析完完整的一天数据时的回调
    */
-  virtual void Parse(std::istream &inputStream,
+  virtual void Parse(std::string_view content,
                      std::function<void(DailyLog &)> onNewDay) = 0;
 };
 
@@ -3,14 +3,19 @@
 #define CONVERTER_CONVERT_IO_TEXT_PARSER_HPP_
 
 #include "common/config/models/converter_config_models.hpp"
+#include "common/utils/log_line_tokenizer.hpp"
 #include "converter/convert/io/i_parser.hpp"
+#include <functional>
 #include <vector>
 
 class TextParser : public IParser {
 public:
   // [Fix] 类型重命名: ParserConfig -> LogParserConfig
-  explicit TextParser(const LogParserConfig &config);
-  void Parse(std::istream &inputStream,
+  // [新增] on_line: 可选，每切分出一行即回调 (用于单遍验证)
+  using LineObserver = std::function<void(const LogLineToken &)>;
+  explicit TextParser(const LogParserConfig &config,
+                      LineObserver on_line = nullptr);
+  void Parse(std::string_view content,
              std::function<void(DailyLog &)> onNewDay) override;
 
 private:
@@ -19,9 +24,10 @@ private:
   // 缓存引用
   const std::vector<std::string> &wake_keywords_;
 
-  bool IsYearMarker(const std::string &line) const;
-  bool IsNewDayMarker(const std::string &line) const;
-  void ParseLine(const std::string &line, DailyLog &currentDay) const;
+  LineObserver on_line_;
+
+  // [修改] 行的切分由共享的 LogLineTokenizer 完成，这里只处理语义
+  void ParseLine(const LogLineToken &token, DailyLog &currentDay) const;
 };
 
 #endif // CONVERTER_CONVERT_IO_TEXT_PARSER_HPP_
@@ -7,21 +7,19 @@
 #include "converter/convert/io/text_parser.hpp"
 #include <iostream>
 #include <memory>
-#include <sstream>
 
 using core::interfaces::LogProcessingResult;
 
-void LogProcessor::ConvertStreamToData(
-    std::istream &combined_stream,
-    std::function<void(DailyLog &&)> data_consumer,
-    const ConverterConfig &config) {
+void LogProcessor::ConvertContentToData(
+    std::string_view content, std::function<void(DailyLog &&)> data_consumer,
+    const ConverterConfig &config, const LineObserver &on_line) {
   try {
     // [Composition Root] 每次调用时组装依赖，使用传入的 config
-    auto parser = std::make_shared<TextParser>(config.parser_config_);
+    auto parser = std::make_shared<TextParser>(config.parser_config_, on_line);
     auto processor = std::make_shared<DayProcessor>(config.mapper_config_);
 
     ConverterService service(parser, processor);
-    service.ExecuteConversion(combined_stream, data_consumer);
+    service.ExecuteConversion(content, data_consumer);
 
   } catch (const std::exception &e) {
     std::cerr << kRedColor
@@ -30,22 +28,28 @@ void LogProcessor::ConvertStreamToData(
   }
 }
 
-LogProcessingResult LogProcessor::Convert(const std::string & /*filename*/,
+LogProcessingResult LogProcessor::Convert(const std::string &filename,
                                           const std::string &content,
                                           const ConverterConfig &config) {
+  return Convert(filename, content, config, nullptr);
+}
+
+LogProcessingResult LogProcessor::Convert(const std::string & /*filename*/,
+                                          const std::string &content,
+                                          const ConverterConfig &config,
+                                          const LineObserver &on_line) {
   LogProcessingResult result;
   result.success = true;
 
   try {
-    std::stringstream ss(content);
     // [修改] 传递 config
-    ConvertStreamToData(
-        ss,
+    ConvertContentToData(
+        content,
         [&](DailyLog &&log) {
           std::string key = log.date_.substr(0, 7);
           result.processed_data[key].push_back(std::move(log));
         },
-        config);
+        config, on_line);
 
     // [Linker] 处理跨月连接，注入 LinkerConfig
     LogLinker linker(config.linker_config_);
@@ -4,7 +4,7 @@
 
 #include "application/interfaces/i_log_converter.hpp" // [新增] 实现接口
 #include <functional>
-#include <istream>
+#include <string_view>
 
 // [移除] struct LogProcessingResult 定义，已移动到接口文件中
 
@@ -17,11 +17,18 @@ public:
   Convert(const std::string &filename, const std::string &content,
           const ConverterConfig &config) override;
 
+  core::interfaces::LogProcessingResult
+  Convert(const std::string &filename, const std::string &content,
+          const ConverterConfig &config,
+          const LineObserver &on_line) override;
+
 private:
   // 内部辅助方法，也需要传递 config
-  void ConvertStreamToData(std::istream &combined_stream,
-                           std::function<void(DailyLog &&)> data_consumer,
-                           const ConverterConfig &config);
+  // [修改] 直接在内容缓冲区上解析，不再构造 stringstream 副本
+  void ConvertContentToData(std::string_view content,
+                            std::function<void(DailyLog &&)> data_consumer,
+                            const ConverterConfig &config,
+                            const LineObserver &on_line);
 };
 
 #endif // CONVERTER_LOG_PROCESSOR_HPP_
@@ -2,6 +2,9 @@
 #ifndef CORE_DOMAIN_MODEL_QUERY_DATA_STRUCTS_HPP_
 #define CORE_DOMAIN_MODEL_QUERY_DATA_STRUCTS_HPP_
 
+#include "core/domain/types/report_format.hpp"
+#include "core/domain/types/report_period.hpp"
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -25,4 +28,26 @@ using FormattedYearlyReports = std::map<int, std::string>;
 // 用于导出所有近期报告的数据结构
 using FormattedRecentReports = std::map<int, std::string>;
 
+// [新增] 通用周期报表: Map<PeriodKey, Content>，键如 "2025-Q1" (见 ReportPeriod)
+using FormattedPeriodReports = std::map<std::string, std::string>;
+using FormattedPeriodHistory = std::map<ReportPeriod, FormattedPeriodReports>;
+
+// [新增] 流式导出：服务每格式化完一个窗口就回调一次 sink，
+// 回调返回后该窗口的内容即被释放，峰值内存不随归档年限增长
+// 一个月的日报: vector<pair<Date, Content>>，按日期升序
+using DailyReportBatch = std::vector<std::pair<std::string, std::string>>;
+using DailyReportBatchSink = std::function<void(const DailyReportBatch &)>;
+
+// 一年的月报: Map<Month, Content>
+using MonthlyReportBatch = std::map<int, std::string>;
+using MonthlyReportBatchSink =
+    std::function<void(int year, const MonthlyReportBatch &)>;
+
+// [新增] 多格式共享一次数据加载：同一窗口 / 周期的数据只查询、建树一次，
+// 再交给每个格式的格式化器；结果按格式分组
+using MultiFormatDailyBatch = std::map<ReportFormat, DailyReportBatch>;
+using MultiFormatDailyBatchSink =
+    std::function<void(const MultiFormatDailyBatch &)>;
+using MultiFormatPeriodHistory = std::map<ReportFormat, FormattedPeriodHistory>;
+
 #endif // CORE_DOMAIN_MODEL_QUERY_DATA_STRUCTS_HPP_
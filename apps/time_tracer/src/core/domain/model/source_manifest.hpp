@@ -0,0 +1,66 @@
+﻿// core/domain/model/source_manifest.hpp
+#ifndef CORE_DOMAIN_MODEL_SOURCE_MANIFEST_HPP_
+#define CORE_DOMAIN_MODEL_SOURCE_MANIFEST_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct SourceFileRecord
+ * @brief 源文件清单 (source_manifest) 中的一行。
+ * @details 用于增量摄入：size/mtime 作为快速判断，hash 作为最终判断，
+ *          months 记录该文件上一次转换产出的月份 ("YYYY-MM")。
+ */
+struct SourceFileRecord {
+  std::string path_;
+  std::uintmax_t size_ = 0;
+  long long mtime_ = 0;
+  std::string hash_;
+  std::vector<std::string> months_;
+};
+
+// key: 源文件路径 (path_)
+using SourceManifest = std::map<std::string, SourceFileRecord>;
+
+/**
+ * @struct ManifestChanges
+ * @brief [新增] 一次摄入对 source_manifest 及既有数据的变更 (同事务写入)。
+ */
+struct ManifestChanges {
+  // 本次处理过的源文件指纹
+  std::vector<SourceFileRecord> upserts_;
+  // 已从输入目录删除的源文件，其清单行被移除
+  std::vector<std::string> removed_paths_;
+  // 变化/删除的源文件以前产出的月份，与本次写入的月份一并整月替换
+  std::vector<std::string> stale_months_;
+
+  bool empty() const {
+    return upserts_.empty() && removed_paths_.empty() &&
+           stale_months_.empty();
+  }
+};
+
+/**
+ * @brief 计算内容指纹 (64-bit FNV-1a, 16 位十六进制)。
+ * @note 仅用于变更检测，不具备密码学强度。
+ */
+inline std::string ComputeContentHash(std::string_view content) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : content) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string result(16, '0');
+  for (int i = 15; i >= 0; --i) {
+    result[i] = kHexDigits[hash & 0xF];
+    hash >>= 4;
+  }
+  return result;
+}
+
+#endif // CORE_DOMAIN_MODEL_SOURCE_MANIFEST_HPP_
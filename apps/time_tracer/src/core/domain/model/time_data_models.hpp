@@ -36,6 +36,8 @@ struct BaseActivityRecord {
   std::string start_time_str_; // 原 startTime / start
   std::string end_time_str_;   // 原 endTime / end
   std::string project_path_;
+  // [新增] 转换器驻留字典中的路径 ID (0 = 未驻留)，供导入器按 ID 去重解析
+  int project_path_id_ = 0;
 
   int duration_seconds_ = 0;          // 原 durationSeconds
   std::optional<std::string> remark_; // 原 activityRemark
@@ -2,6 +2,7 @@
 #ifndef CORE_DOMAIN_PORTS_I_FILE_SYSTEM_HPP_
 #define CORE_DOMAIN_PORTS_I_FILE_SYSTEM_HPP_
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -33,6 +34,11 @@ public:
   virtual bool Exists(const std::filesystem::path &path) = 0;
   virtual bool IsDirectory(const std::filesystem::path &path) = 0;
   virtual bool IsRegularFile(const std::filesystem::path &path) = 0;
+
+  // [新增] 文件元数据 (增量摄入的快速变更检测)
+  virtual std::uintmax_t GetFileSize(const std::filesystem::path &path) = 0;
+  // 返回最后修改时间的原始计数 (仅用于相等比较)
+  virtual long long GetLastWriteTime(const std::filesystem::path &path) = 0;
 };
 
 } // namespace core::interfaces
@@ -0,0 +1,25 @@
+﻿// core/domain/ports/i_task_executor.hpp
+#ifndef CORE_DOMAIN_PORTS_I_TASK_EXECUTOR_HPP_
+#define CORE_DOMAIN_PORTS_I_TASK_EXECUTOR_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace core::interfaces {
+
+class ITaskExecutor {
+public:
+  virtual ~ITaskExecutor() = default;
+
+  // 提交一个无参数、无返回值的任务 (任务自身负责捕获异常)
+  virtual void Submit(std::function<void()> task) = 0;
+
+  // 阻塞直到所有已提交的任务执行完毕 (不可在任务内部调用)
+  virtual void WaitAll() = 0;
+
+  // 工作线程数
+  virtual size_t GetWorkerCount() const = 0;
+};
+
+} // namespace core::interfaces
+#endif
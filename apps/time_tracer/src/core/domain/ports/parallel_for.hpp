@@ -0,0 +1,77 @@
+﻿// core/domain/ports/parallel_for.hpp
+#ifndef CORE_DOMAIN_PORTS_PARALLEL_FOR_HPP_
+#define CORE_DOMAIN_PORTS_PARALLEL_FOR_HPP_
+
+#include "core/domain/ports/i_task_executor.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <latch>
+#include <mutex>
+
+namespace core::interfaces {
+
+// [新增] 把 [0, count) 切成连续分块提交给 executor，并阻塞到全部完成。
+// - executor 为空、只有一个工作线程或只有一个元素时，在当前线程顺序执行；
+// - fn(i) 只应写入下标 i 对应的槽位，由调用方按下标汇总以保证结果顺序确定；
+// - 第一个异常会在所有分块结束后重新抛出；
+// - [修改] 只等待本批分块 (各自的 latch)，不受同一线程池上其他任务影响。
+template <typename Fn>
+void ParallelFor(ITaskExecutor *executor, size_t count, Fn &&fn) {
+  if (count == 0) {
+    return;
+  }
+  if (executor == nullptr || count == 1 || executor->GetWorkerCount() <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  // 每个线程分到若干块，兼顾负载均衡与任务调度开销
+  constexpr size_t kChunksPerWorker = 4;
+  const size_t chunk_count =
+      std::min(count, executor->GetWorkerCount() * kChunksPerWorker);
+  const size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+  const size_t submit_count = (count + chunk_size - 1) / chunk_size;
+
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+  std::latch done(static_cast<std::ptrdiff_t>(submit_count));
+
+  size_t submitted = 0;
+  try {
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+      const size_t end = std::min(count, begin + chunk_size);
+      executor->Submit(
+          [&fn, &error_mutex, &first_error, &done, begin, end]() {
+            try {
+              for (size_t i = begin; i < end; ++i) {
+                fn(i);
+              }
+            } catch (...) {
+              std::lock_guard<std::mutex> lock(error_mutex);
+              if (!first_error) {
+                first_error = std::current_exception();
+              }
+            }
+            done.count_down();
+          });
+      ++submitted;
+    }
+  } catch (...) {
+    // 提交失败：补齐未提交的计数，等已提交的分块结束后再抛出
+    done.count_down(static_cast<std::ptrdiff_t>(submit_count - submitted));
+    done.wait();
+    throw;
+  }
+  done.wait();
+
+  if (first_error) {
+    std::rethrow_exception(first_error);
+  }
+}
+
+} // namespace core::interfaces
+
+#endif // CORE_DOMAIN_PORTS_PARALLEL_FOR_HPP_
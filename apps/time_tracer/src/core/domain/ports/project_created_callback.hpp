@@ -0,0 +1,18 @@
+﻿// core/domain/ports/project_created_callback.hpp
+#ifndef CORE_DOMAIN_PORTS_PROJECT_CREATED_CALLBACK_HPP_
+#define CORE_DOMAIN_PORTS_PROJECT_CREATED_CALLBACK_HPP_
+
+#include <functional>
+#include <string>
+
+namespace core::interfaces {
+
+// [新增] 导入器在 projects 表新建节点后回调 (id, 名称, 父 id；根节点父 id 为 0)。
+// 由组合根注入，导入层不依赖任何报表侧的缓存；为空时不通知
+using ProjectCreatedCallback =
+    std::function<void(long long id, const std::string &name,
+                       long long parent_id)>;
+
+} // namespace core::interfaces
+
+#endif // CORE_DOMAIN_PORTS_PROJECT_CREATED_CALLBACK_HPP_
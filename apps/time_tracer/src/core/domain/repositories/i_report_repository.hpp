@@ -27,13 +27,36 @@ public:
 
   virtual std::string GetYearlyReport(int year, ReportFormat format) = 0;
 
+  // [新增] 环比 / 同比报表，period 为 "YYYY"、"YYYY-MM" 或 "YYYY-Www"
+  virtual std::string GetComparisonReport(const std::string &period,
+                                          ReportFormat format) = 0;
+
   virtual FormattedGroupedReports GetAllDailyReports(ReportFormat format) = 0;
   virtual FormattedMonthlyReports GetAllMonthlyReports(ReportFormat format) = 0;
 
+  // [新增] 流式全量导出：按窗口回调 sink，不在内存中保留全部报表
+  virtual void StreamAllDailyReports(ReportFormat format,
+                                     const DailyReportBatchSink &sink) = 0;
+  virtual void StreamAllMonthlyReports(ReportFormat format,
+                                       const MonthlyReportBatchSink &sink) = 0;
+
   virtual FormattedWeeklyReports GetAllWeeklyReports(ReportFormat format) = 0;
 
   virtual FormattedYearlyReports GetAllYearlyReports(ReportFormat format) = 0;
 
+  // [新增] 一次汇总生成 periods 中所有粒度的历史报表
+  virtual FormattedPeriodHistory
+  GetAllPeriodReports(const std::vector<ReportPeriod> &periods,
+                      ReportFormat format) = 0;
+
+  // [新增] 多格式版本：数据只加载、建树一次，再分发给各格式的格式化器
+  virtual void
+  StreamAllDailyReportsMultiFormat(const std::vector<ReportFormat> &formats,
+                                   const MultiFormatDailyBatchSink &sink) = 0;
+  virtual MultiFormatPeriodHistory
+  GetAllPeriodReportsMultiFormat(const std::vector<ReportPeriod> &periods,
+                                 const std::vector<ReportFormat> &formats) = 0;
+
   virtual FormattedRecentReports
   GetAllRecentReports(const std::vector<int> &days_list,
                       ReportFormat format) = 0;
@@ -0,0 +1,14 @@
+﻿// core/domain/types/report_period.hpp
+#ifndef CORE_DOMAIN_TYPES_REPORT_PERIOD_HPP_
+#define CORE_DOMAIN_TYPES_REPORT_PERIOD_HPP_
+
+/**
+ * @enum ReportPeriod
+ * @brief 历史报表的周期粒度。周与双周按 ISO 周年划分，其余按公历划分。
+ *
+ * 周期键: Week "2025-W07", BiWeek "2025-B04" (第 7-8 周), Month "2025-03",
+ *         Quarter "2025-Q1", HalfYear "2025-H1", Year "2025"
+ */
+enum class ReportPeriod { Week, BiWeek, Month, Quarter, HalfYear, Year };
+
+#endif // CORE_DOMAIN_TYPES_REPORT_PERIOD_HPP_
@@ -0,0 +1,89 @@
+﻿// core/infrastructure/concurrency/thread_pool_executor.cpp
+#include "core/infrastructure/concurrency/thread_pool_executor.hpp"
+#include <iostream>
+
+namespace infrastructure::concurrency {
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t threads) {
+  const size_t worker_count = ResolveWorkerCount(threads);
+  threads_.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    threads_.emplace_back([this] { WorkerThread(); });
+  }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+
+  for (std::thread &worker : threads_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+size_t ThreadPoolExecutor::ResolveWorkerCount(size_t requested) {
+  if (requested > 0) {
+    return requested;
+  }
+  size_t hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? hardware : 1;
+}
+
+void ThreadPoolExecutor::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    ++active_task_count_;
+    tasks_.emplace(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+void ThreadPoolExecutor::WaitAll() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  wait_condition_.wait(lock, [this] { return active_task_count_ == 0; });
+}
+
+size_t ThreadPoolExecutor::GetWorkerCount() const { return threads_.size(); }
+
+void ThreadPoolExecutor::WorkerThread() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+      if (stop_ && tasks_.empty()) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+
+    try {
+      task();
+    } catch (const std::exception &e) {
+      // 任务应自行处理异常；此处兜底，避免工作线程退出导致 WaitAll 永久阻塞
+      std::cerr << "[ThreadPool] Unhandled task exception: " << e.what()
+                << std::endl;
+    } catch (...) {
+      std::cerr << "[ThreadPool] Unhandled task exception." << std::endl;
+    }
+
+    bool all_done = false;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      all_done = (--active_task_count_ == 0);
+    }
+    if (all_done) {
+      wait_condition_.notify_all();
+    }
+  }
+}
+
+} // namespace infrastructure::concurrency
@@ -0,0 +1,55 @@
+﻿// core/infrastructure/concurrency/thread_pool_executor.hpp
+#ifndef CORE_INFRASTRUCTURE_CONCURRENCY_THREAD_POOL_EXECUTOR_HPP_
+#define CORE_INFRASTRUCTURE_CONCURRENCY_THREAD_POOL_EXECUTOR_HPP_
+
+#include "core/domain/ports/i_task_executor.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace infrastructure::concurrency {
+
+/**
+ * @class ThreadPoolExecutor
+ * @brief 固定大小的线程池，供流水线各步骤 (验证/转换) 共享。
+ * @details 线程数在构造时确定，不随提交的任务数增长；
+ *          threads 为 0 时使用 hardware_concurrency。
+ */
+class ThreadPoolExecutor : public core::interfaces::ITaskExecutor {
+public:
+  explicit ThreadPoolExecutor(size_t threads = 0);
+  ~ThreadPoolExecutor() override;
+
+  // 禁止拷贝和移动
+  ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+  ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+
+  void Submit(std::function<void()> task) override;
+  void WaitAll() override;
+  size_t GetWorkerCount() const override;
+
+  // 根据 --jobs 取值计算实际线程数 (0 表示自动)
+  static size_t ResolveWorkerCount(size_t requested);
+
+private:
+  void WorkerThread();
+
+  std::vector<std::thread> threads_;
+  std::queue<std::function<void()>> tasks_;
+
+  std::mutex queue_mutex_;
+  std::condition_variable condition_;
+
+  // 用于 WaitAll 的同步机制
+  std::condition_variable wait_condition_;
+  size_t active_task_count_ = 0;
+
+  bool stop_ = false;
+};
+
+} // namespace infrastructure::concurrency
+
+#endif // CORE_INFRASTRUCTURE_CONCURRENCY_THREAD_POOL_EXECUTOR_HPP_
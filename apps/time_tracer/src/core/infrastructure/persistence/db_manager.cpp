@@ -1,6 +1,8 @@
 ﻿// core/infrastructure/persistence/db_manager.cpp
 #include "core/infrastructure/persistence/db_manager.hpp"
+#include "core/infrastructure/persistence/schema_migrator.hpp"
 #include <filesystem>
+#include <iostream>
 #include <sqlite3.h>
 #include <stdexcept>
 
@@ -28,9 +30,21 @@ bool DBManager::CheckAndOpen() {
     // [修改] 抛出异常
     throw std::runtime_error("Failed to open database: " + err_msg);
   }
+
+  // [新增] 打开已有数据库时一次性升级模式 (已是最新版本时不执行任何 DDL)；
+  // 升级失败 (例如只读文件) 不影响打开，由报表仓库判断能否查询
+  if (SchemaMigrator::get_version(db_) < SchemaMigrator::kCurrentVersion) {
+    SchemaMigrator::migrate(db_);
+  }
   return true;
 }
 
+bool DBManager::MigrateSchema() {
+  if (!CheckAndOpen())
+    return false;
+  return SchemaMigrator::migrate(db_);
+}
+
 void DBManager::OpenDatabase() {
   if (db_ != nullptr)
     return;
@@ -46,7 +60,13 @@ void DBManager::OpenDatabase() {
 
 void DBManager::CloseDatabase() {
   if (db_) {
-    sqlite3_close(db_);
+    // [修改] 仍有未 finalize 的语句时 sqlite3_close 返回 SQLITE_BUSY 且不关闭；
+    // 报告后改用 sqlite3_close_v2，待语句释放后再真正关闭，避免泄漏连接
+    if (sqlite3_close(db_) != SQLITE_OK) {
+      std::cerr << "Warning: database closed with unfinalized statements: "
+                << sqlite3_errmsg(db_) << std::endl;
+      sqlite3_close_v2(db_);
+    }
     db_ = nullptr;
   }
 }
@@ -20,6 +20,11 @@ public:
   // 尝试打开，如果不存在则抛出特定异常或返回false (保留原有语义但移除打印)
   bool CheckAndOpen();
 
+  // [新增] 显式升级已有数据库到最新模式版本 (migrate 命令)；
+  // CheckAndOpen 已在打开时尝试升级，此处返回升级结果。
+  // 数据库不存在或升级失败时返回 false
+  bool MigrateSchema();
+
   void CloseDatabase();
   sqlite3 *GetDbConnection() const;
 
@@ -0,0 +1,293 @@
+﻿// core/infrastructure/persistence/schema_migrator.cpp
+#include "core/infrastructure/persistence/schema_migrator.hpp"
+#include "importer/storage/sqlite/connection.hpp"
+#include "importer/storage/sqlite/rollup_store.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+struct IndexDef {
+  const char *name;
+  const char *create_sql;
+};
+
+// 报表查询均按 date 过滤 / 分组，并读取 project_id 与 duration：
+// - idx_time_records_date: (date, logical_id)，logical_id 即 rowid，
+//   单日记录按 logical_id 顺序直接从索引取出
+// - idx_time_records_date_project: (date, project_id, duration)，
+//   区间聚合与按月/周/年的 GROUP BY 只扫描索引，不回表
+constexpr IndexDef kSecondaryIndexes[] = {
+    {"idx_year_month",
+     "CREATE INDEX IF NOT EXISTS idx_year_month ON days (year, month);"},
+    {"idx_time_records_date",
+     "CREATE INDEX IF NOT EXISTS idx_time_records_date "
+     "ON time_records (date, logical_id);"},
+    {"idx_time_records_date_project",
+     "CREATE INDEX IF NOT EXISTS idx_time_records_date_project "
+     "ON time_records (date, project_id, duration);"},
+};
+
+// [新增] v4 表定义：date 为 1970-01-01 起的天数 (days 中即 rowid)，
+// start / end 为当日分钟数；文本仅在报表展示时生成
+constexpr const char *kCreateDaysSql =
+    "CREATE TABLE IF NOT EXISTS days ("
+    "date INTEGER PRIMARY KEY, "
+    "year INTEGER, "
+    "month INTEGER, "
+    "status INTEGER, "
+    "sleep INTEGER, "
+    "remark TEXT, "
+    "getup_time TEXT, "
+    "exercise INTEGER, "
+    "total_exercise_time INTEGER, "
+    "cardio_time INTEGER, "
+    "anaerobic_time INTEGER, "
+    "gaming_time INTEGER, "
+    "grooming_time INTEGER, "
+    "toilet_time INTEGER, "
+    "study_time INTEGER, "
+    "sleep_night_time INTEGER, "
+    "sleep_day_time INTEGER, "
+    "sleep_total_time INTEGER, "
+    "recreation_time INTEGER, "
+    "recreation_zhihu_time INTEGER, "
+    "recreation_bilibili_time INTEGER, "
+    "recreation_douyin_time INTEGER);";
+
+constexpr const char *kCreateRecordsSql =
+    "CREATE TABLE IF NOT EXISTS time_records ("
+    "logical_id INTEGER PRIMARY KEY, "
+    "start_timestamp INTEGER, "
+    "end_timestamp INTEGER, "
+    "date INTEGER, "
+    "start INTEGER, "
+    "end INTEGER, "
+    "project_id INTEGER, "
+    "duration INTEGER, "
+    "activity_remark TEXT, "
+    "FOREIGN KEY (date) REFERENCES days(date), "
+    "FOREIGN KEY (project_id) REFERENCES projects(id));";
+
+// v3 -> v4 的数据搬迁 (旧表已改名为 *_legacy)。
+// date(date, '+0 days') 会把 2024-02-30 规范化为 03-01，与原文比较
+// 即可同时排除格式错误与溢出日期。
+// 无法换算的行不搬迁：先计数，迁移后仅这些行保留在 *_legacy 中
+constexpr const char *kCountRejectedDaysSql =
+    "SELECT count(*) FROM days "
+    "WHERE coalesce(date(date, '+0 days') = date, 0) = 0;";
+constexpr const char *kCountRejectedRecordsSql =
+    "SELECT count(*) FROM time_records "
+    "WHERE coalesce(date(date, '+0 days') = date, 0) = 0;";
+constexpr const char *kPruneLegacySql =
+    "DELETE FROM time_records_legacy WHERE date(date, '+0 days') = date;"
+    "DELETE FROM days_legacy WHERE date(date, '+0 days') = date;";
+
+constexpr const char *kCopyLegacyDaysSql =
+    "INSERT OR IGNORE INTO days SELECT "
+    "CAST(julianday(date) - 2440587.5 AS INTEGER), year, month, status, "
+    "sleep, remark, getup_time, exercise, total_exercise_time, cardio_time, "
+    "anaerobic_time, gaming_time, grooming_time, toilet_time, study_time, "
+    "sleep_night_time, sleep_day_time, sleep_total_time, recreation_time, "
+    "recreation_zhihu_time, recreation_bilibili_time, "
+    "recreation_douyin_time "
+    "FROM days_legacy WHERE date(date, '+0 days') = date;";
+
+// "HH:MM" -> 当日分钟数，其余写 NULL ("end" 需加引号，避免与 CASE 冲突)
+constexpr const char *kCopyLegacyRecordsSql =
+    "INSERT OR IGNORE INTO time_records SELECT "
+    "logical_id, start_timestamp, end_timestamp, "
+    "CAST(julianday(date) - 2440587.5 AS INTEGER), "
+    "CASE WHEN \"start\" GLOB '[0-9][0-9]:[0-5][0-9]*' "
+    "THEN CAST(substr(\"start\", 1, 2) AS INTEGER) * 60 + "
+    "CAST(substr(\"start\", 4, 2) AS INTEGER) END, "
+    "CASE WHEN \"end\" GLOB '[0-9][0-9]:[0-5][0-9]*' "
+    "THEN CAST(substr(\"end\", 1, 2) AS INTEGER) * 60 + "
+    "CAST(substr(\"end\", 4, 2) AS INTEGER) END, "
+    "project_id, duration, activity_remark "
+    "FROM time_records_legacy WHERE date(date, '+0 days') = date;";
+
+bool has_table(sqlite3 *db, const char *table) {
+  sqlite3_stmt *stmt = nullptr;
+  bool found = false;
+  if (sqlite3_prepare_v2(db,
+                         "SELECT 1 FROM sqlite_master "
+                         "WHERE type = 'table' AND name = ?;",
+                         -1, &stmt, nullptr) == SQLITE_OK) {
+    sqlite3_bind_text(stmt, 1, table, -1, SQLITE_STATIC);
+    found = sqlite3_step(stmt) == SQLITE_ROW;
+  }
+  sqlite3_finalize(stmt);
+  return found;
+}
+
+// days.date 的声明类型；表不存在时返回空串
+std::string declared_date_type(sqlite3 *db) {
+  sqlite3_stmt *stmt = nullptr;
+  std::string type;
+  if (sqlite3_prepare_v2(db,
+                         "SELECT upper(type) FROM pragma_table_info('days') "
+                         "WHERE name = 'date';",
+                         -1, &stmt, nullptr) == SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW) {
+    const unsigned char *text = sqlite3_column_text(stmt, 0);
+    if (text)
+      type = reinterpret_cast<const char *>(text);
+  }
+  sqlite3_finalize(stmt);
+  return type;
+}
+
+long long count_rows(sqlite3 *db, const char *sql) {
+  sqlite3_stmt *stmt = nullptr;
+  long long count = 0;
+  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW) {
+    count = sqlite3_column_int64(stmt, 0);
+  }
+  sqlite3_finalize(stmt);
+  return count;
+}
+
+} // namespace
+
+int SchemaMigrator::get_version(sqlite3 *db) {
+  sqlite3_stmt *stmt = nullptr;
+  int version = 0;
+  if (sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &stmt, nullptr) ==
+          SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW) {
+    version = sqlite3_column_int(stmt, 0);
+  }
+  sqlite3_finalize(stmt);
+  return version;
+}
+
+bool SchemaMigrator::create_secondary_indexes(sqlite3 *db) {
+  bool ok = true;
+  for (const auto &index : kSecondaryIndexes) {
+    ok = execute_sql(db, index.create_sql,
+                     std::string("Create index ") + index.name) &&
+         ok;
+  }
+  return ok;
+}
+
+void SchemaMigrator::drop_secondary_indexes(sqlite3 *db) {
+  for (const auto &index : kSecondaryIndexes) {
+    execute_sql(db, std::string("DROP INDEX IF EXISTS ") + index.name + ";",
+                std::string("Drop index ") + index.name);
+  }
+}
+
+bool SchemaMigrator::create_day_tables(sqlite3 *db) {
+  bool ok = execute_sql(db, kCreateDaysSql, "Create days table");
+  return execute_sql(db, kCreateRecordsSql, "Create time_records table") &&
+         ok;
+}
+
+bool SchemaMigrator::migrate_date_keys(sqlite3 *db) {
+  const std::string type = declared_date_type(db);
+  if (type.empty() || type == "INTEGER") {
+    return true;
+  }
+
+  // 进度与告警写 stderr，避免混入 query 重定向到文件的报表输出
+  std::cerr << "Migrating date/time columns to integer keys..." << std::endl;
+  if (!execute_sql(db, "BEGIN TRANSACTION;", "Begin date key migration")) {
+    return false;
+  }
+  const long long rejected_days = count_rows(db, kCountRejectedDaysSql);
+  const long long rejected_records = count_rows(db, kCountRejectedRecordsSql);
+  const bool keep_legacy = rejected_days > 0 || rejected_records > 0;
+
+  // 索引随表改名，先删除以便在新表上按原名重建
+  drop_secondary_indexes(db);
+  bool ok =
+      execute_sql(db,
+                  "ALTER TABLE time_records RENAME TO time_records_legacy;"
+                  "ALTER TABLE days RENAME TO days_legacy;",
+                  "Rename legacy tables") &&
+      create_day_tables(db) &&
+      execute_sql(db, kCopyLegacyDaysSql, "Copy legacy days") &&
+      execute_sql(db, kCopyLegacyRecordsSql, "Copy legacy time_records") &&
+      (keep_legacy
+           ? execute_sql(db, kPruneLegacySql, "Prune migrated legacy rows")
+           : execute_sql(db,
+                         "DROP TABLE time_records_legacy;"
+                         "DROP TABLE days_legacy;",
+                         "Drop legacy tables")) &&
+      create_secondary_indexes(db);
+  if (!ok) {
+    execute_sql(db, "ROLLBACK;", "Rollback date key migration");
+    return false;
+  }
+  if (!execute_sql(db, "COMMIT;", "Commit date key migration")) {
+    return false;
+  }
+  if (keep_legacy) {
+    std::cerr << "Warning: " << rejected_days << " day(s) and "
+              << rejected_records
+              << " time record(s) have invalid dates and were not migrated; "
+                 "they are kept in days_legacy / time_records_legacy."
+              << std::endl;
+  }
+  return true;
+}
+
+bool SchemaMigrator::migrate(sqlite3 *db) {
+  if (!db || !has_table(db, "days") || !has_table(db, "time_records")) {
+    return true;
+  }
+
+  const int version = get_version(db);
+  if (version >= kCurrentVersion) {
+    return true;
+  }
+
+  // v3 -> v4: 日期/时刻列改为整数。须先于预聚合重建，
+  // RollupStore 的查询已按整数 date 编写
+  if (version < 4) {
+    if (!migrate_date_keys(db)) {
+      return false;
+    }
+  }
+
+  // v0 -> v1: 覆盖索引 (创建语句幂等，版本号仅用于跳过重复检查)
+  if (version < 1) {
+    if (!create_secondary_indexes(db)) {
+      return false;
+    }
+  }
+
+  // v1 -> v2: 建立预聚合表并由已有记录一次性填充
+  // v2 -> v3: 前缀和索引同由 RollupStore 维护，一并全量重建
+  // v3 -> v4: 预聚合按新的整数列重建 (非法日期行未搬迁，不计入)
+  if (version < 4) {
+    if (!RollupStore::create_tables(db) ||
+        !execute_sql(db, "BEGIN TRANSACTION;", "Begin rollup migration")) {
+      return false;
+    }
+    try {
+      RollupStore(db).rebuild_all();
+    } catch (const std::exception &e) {
+      std::cerr << "Error building rollups: " << e.what() << std::endl;
+      execute_sql(db, "ROLLBACK;", "Rollback rollup migration");
+      return false;
+    }
+    if (!execute_sql(db, "COMMIT;", "Commit rollup migration")) {
+      return false;
+    }
+  }
+  execute_sql(db, "ANALYZE;", "Analyze after migration");
+
+  return mark_current(db);
+}
+
+bool SchemaMigrator::mark_current(sqlite3 *db) {
+  return execute_sql(db,
+                     "PRAGMA user_version = " +
+                         std::to_string(kCurrentVersion) + ";",
+                     "Update schema version");
+}
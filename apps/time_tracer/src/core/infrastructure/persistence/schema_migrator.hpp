@@ -0,0 +1,42 @@
+﻿// core/infrastructure/persistence/schema_migrator.hpp
+#ifndef CORE_INFRASTRUCTURE_PERSISTENCE_SCHEMA_MIGRATOR_HPP_
+#define CORE_INFRASTRUCTURE_PERSISTENCE_SCHEMA_MIGRATOR_HPP_
+
+#include <sqlite3.h>
+
+// [新增] 数据库模式版本管理 (PRAGMA user_version)
+// [修改] 导入与报表共用的持久化模块。导入 (Connection) 与查询 / 导出
+// (DBManager::CheckAndOpen) 打开数据库时，版本落后才升级一次；
+// migrate 命令可显式执行同一升级
+// 版本历史:
+//   0 - 初始模式，仅有 idx_year_month
+//   1 - time_records 覆盖索引 (date, logical_id) / (date, project_id, duration)
+//   2 - 预聚合表 project_rollups / period_active_days (见 RollupStore)
+//   3 - 前缀和索引 project_prefix_sums / active_day_prefix
+//   4 - days.date / time_records.date 改为天数 (1970-01-01 起)，
+//       time_records.start / end 改为当日分钟数，均为 INTEGER
+class SchemaMigrator {
+public:
+  static constexpr int kCurrentVersion = 4;
+
+  static int get_version(sqlite3 *db);
+  // 将 user_version 标记为 kCurrentVersion (新建库的索引已按最新定义创建)
+  static bool mark_current(sqlite3 *db);
+
+  // 将已有数据库升级到 kCurrentVersion；表尚未创建时不做任何事。
+  // 返回 false 表示升级失败 (例如只读数据库)，不影响后续只读查询。
+  static bool migrate(sqlite3 *db);
+
+  // [新增] days / time_records 的最新表定义 (CREATE IF NOT EXISTS)
+  static bool create_day_tables(sqlite3 *db);
+  // [新增] 将 TEXT 日期/时刻列就地转换为整数 (v4)；已是整数模式时不做任何事。
+  // 无法解析的日期行不搬迁：计数后告警，并仅将这些行保留在
+  // days_legacy / time_records_legacy 中；无法解析的时刻写为 NULL。
+  static bool migrate_date_keys(sqlite3 *db);
+
+  // 二级索引的统一定义，批量加载模式下先删除、写入完成后再重建
+  static bool create_secondary_indexes(sqlite3 *db);
+  static void drop_secondary_indexes(sqlite3 *db);
+};
+
+#endif // CORE_INFRASTRUCTURE_PERSISTENCE_SCHEMA_MIGRATOR_HPP_
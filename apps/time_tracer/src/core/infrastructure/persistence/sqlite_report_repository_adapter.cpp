@@ -1,26 +1,59 @@
 ﻿// core/infrastructure/persistence/sqlite_report_repository_adapter.cpp
 #include "core/infrastructure/persistence/sqlite_report_repository_adapter.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
-#include <format>
+#include <cstdio>
 #include <iostream>
 #include <stdexcept>
 
 #include "reports/application/usecases/daily_report_service.hpp"
 #include "reports/application/usecases/range_report_service.hpp"
+#include "reports/data/utils/period_rollup_engine.hpp"
 
 // [修改] 必须包含新的底层仓库头文件
 #include "reports/infrastructure/persistence/sqlite_report_data_repository.hpp"
 
 namespace infrastructure::persistence {
 
+namespace {
+
+// [新增] 单期报表的区间与 export all-* 使用同一套周期划分，
+// 月末、闰年与 53 周年份均按实际天数计算
+RangeRequest make_period_request(ReportPeriod period, RangeType type,
+                                 int year, int index) {
+  PeriodBucket bucket;
+  if (!PeriodRollupEngine::describe(period, year, index, bucket)) {
+    throw std::invalid_argument("Invalid report period: year " +
+                                std::to_string(year) + ", index " +
+                                std::to_string(index));
+  }
+  RangeRequest req;
+  req.name = bucket.key_;
+  req.start_date = bucket.start_date_;
+  req.end_date = bucket.end_date_;
+  req.covered_days = bucket.covered_days_;
+  req.type = type;
+  return req;
+}
+
+// "YYYY-MM" -> (年, 月)；格式不符时返回 false
+bool parse_year_month(const std::string &month, int &year, int &month_num) {
+  return month.size() == 7 && month[4] == '-' &&
+         sscanf(month.c_str(), "%4d-%2d", &year, &month_num) == 2;
+}
+
+} // namespace
+
 SqliteReportRepositoryAdapter::SqliteReportRepositoryAdapter(
-    sqlite3 *db, const GlobalReportConfig &config) {
+    sqlite3 *db, const GlobalReportConfig &config,
+    std::shared_ptr<core::interfaces::ITaskExecutor> executor) {
   // [修复] 这里创建的是底层的 SqliteReportDataRepository，而不是 Adapter
   data_repo_ = std::make_unique<::SqliteReportDataRepository>(db);
 
   // 初始化 Service，把底层 Repo 传给它们
-  daily_service_ = std::make_unique<DailyReportService>(*data_repo_, config);
-  range_service_ = std::make_unique<RangeReportService>(*data_repo_, config);
+  daily_service_ =
+      std::make_unique<DailyReportService>(*data_repo_, config, executor);
+  range_service_ =
+      std::make_unique<RangeReportService>(*data_repo_, config, executor);
 }
 
 SqliteReportRepositoryAdapter::~SqliteReportRepositoryAdapter() = default;
@@ -34,43 +67,33 @@ SqliteReportRepositoryAdapter::GetDailyReport(const std::string &date,
 std::string
 SqliteReportRepositoryAdapter::GetMonthlyReport(const std::string &month,
                                                 ReportFormat format) {
-  RangeRequest req;
-  req.name = month;
-  req.start_date = month + "-01";
-  req.end_date =
-      month +
-      "-31"; // 简化的逻辑，Service内部如果不依赖此日期计算ActiveDays则无妨，否则建议用工具计算准确月底
-  req.covered_days = 30;
-  req.type = RangeType::Month; // [新增] 指定类型
-
-  return range_service_->generate_report(req, format);
+  int year = 0;
+  int month_num = 0;
+  if (!parse_year_month(month, year, month_num)) {
+    throw std::invalid_argument("Invalid month '" + month +
+                                "'. Expected YYYY-MM.");
+  }
+  // [修改] 区间取该月实际天数，不再以 "-31" / 30 天近似
+  return range_service_->generate_report(
+      make_period_request(ReportPeriod::Month, RangeType::Month, year,
+                          month_num),
+      format);
 }
 
 std::string
 SqliteReportRepositoryAdapter::GetWeeklyReport(int year, int week,
                                                ReportFormat format) {
-  auto [start_date, end_date] = get_week_date_range(year, week);
-
-  RangeRequest req;
-  req.name = std::format("{}-W{:02d}", year, week);
-  req.start_date = start_date;
-  req.end_date = end_date;
-  req.covered_days = 7;
-  req.type = RangeType::Week; // [新增] 指定类型
-
-  return range_service_->generate_report(req, format);
+  return range_service_->generate_report(
+      make_period_request(ReportPeriod::Week, RangeType::Week, year, week),
+      format);
 }
 
 std::string
 SqliteReportRepositoryAdapter::GetYearlyReport(int year, ReportFormat format) {
-  RangeRequest req;
-  req.name = std::to_string(year);
-  req.start_date = std::to_string(year) + "-01-01";
-  req.end_date = std::to_string(year) + "-12-31";
-  req.covered_days = 365;     // Simplified
-  req.type = RangeType::Year; // 指定类型
-
-  return range_service_->generate_report(req, format);
+  // [修改] 闰年按 366 天计
+  return range_service_->generate_report(
+      make_period_request(ReportPeriod::Year, RangeType::Year, year, 0),
+      format);
 }
 
 std::string
@@ -105,6 +128,29 @@ SqliteReportRepositoryAdapter::GetRangeReport(const std::string &start_date,
   return range_service_->generate_report(req, format);
 }
 
+std::string
+SqliteReportRepositoryAdapter::GetComparisonReport(const std::string &period,
+                                                   ReportFormat format) {
+  // [修改] 与单期报表共用 make_period_request，Service 再据此派生对照期
+  int year = 0;
+  int index = 0;
+  RangeRequest req;
+  if (period.size() == 4 && sscanf(period.c_str(), "%4d", &year) == 1) {
+    req = make_period_request(ReportPeriod::Year, RangeType::Year, year, 0);
+  } else if (sscanf(period.c_str(), "%d-W%d", &year, &index) == 2) {
+    req = make_period_request(ReportPeriod::Week, RangeType::Week, year,
+                              index);
+  } else if (parse_year_month(period, year, index)) {
+    req = make_period_request(ReportPeriod::Month, RangeType::Month, year,
+                              index);
+  } else {
+    throw std::invalid_argument("Invalid comparison period '" + period +
+                                "'. Expected YYYY, YYYY-MM or YYYY-Www.");
+  }
+
+  return range_service_->generate_comparison_report(req, format);
+}
+
 FormattedGroupedReports
 SqliteReportRepositoryAdapter::GetAllDailyReports(ReportFormat format) {
   // [修复] 方法名更正为 generate_all_reports，匹配 DailyReportService 的定义
@@ -116,6 +162,16 @@ SqliteReportRepositoryAdapter::GetAllMonthlyReports(ReportFormat format) {
   return range_service_->generate_all_monthly_history(format);
 }
 
+void SqliteReportRepositoryAdapter::StreamAllDailyReports(
+    ReportFormat format, const DailyReportBatchSink &sink) {
+  daily_service_->stream_all_reports(format, sink);
+}
+
+void SqliteReportRepositoryAdapter::StreamAllMonthlyReports(
+    ReportFormat format, const MonthlyReportBatchSink &sink) {
+  range_service_->stream_all_monthly_history(format, sink);
+}
+
 FormattedRecentReports SqliteReportRepositoryAdapter::GetAllRecentReports(
     const std::vector<int> &days_list, ReportFormat format) {
   std::vector<RangeRequest> reqs;
@@ -162,4 +218,23 @@ SqliteReportRepositoryAdapter::GetAllYearlyReports(ReportFormat format) {
   return range_service_->generate_all_yearly_history(format);
 }
 
+FormattedPeriodHistory SqliteReportRepositoryAdapter::GetAllPeriodReports(
+    const std::vector<ReportPeriod> &periods, ReportFormat format) {
+  return range_service_->generate_all_period_history(format, periods);
+}
+
+void SqliteReportRepositoryAdapter::StreamAllDailyReportsMultiFormat(
+    const std::vector<ReportFormat> &formats,
+    const MultiFormatDailyBatchSink &sink) {
+  daily_service_->stream_all_reports_multi_format(formats, sink);
+}
+
+MultiFormatPeriodHistory
+SqliteReportRepositoryAdapter::GetAllPeriodReportsMultiFormat(
+    const std::vector<ReportPeriod> &periods,
+    const std::vector<ReportFormat> &formats) {
+  return range_service_->generate_all_period_history_multi_format(formats,
+                                                                  periods);
+}
+
 } // namespace infrastructure::persistence
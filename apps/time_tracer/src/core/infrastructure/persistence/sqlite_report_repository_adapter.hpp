@@ -3,6 +3,7 @@
 #define CORE_INFRASTRUCTURE_PERSISTENCE_SQLITE_REPORT_REPOSITORY_ADAPTER_HPP_
 
 #include "common/config/global_report_config.hpp"
+#include "core/domain/ports/i_task_executor.hpp"
 #include "core/domain/repositories/i_report_repository.hpp"
 #include <memory>
 
@@ -18,7 +19,10 @@ namespace infrastructure::persistence {
 class SqliteReportRepositoryAdapter
     : public core::domain::repositories::IReportRepository {
 public:
-  SqliteReportRepositoryAdapter(sqlite3 *db, const GlobalReportConfig &config);
+  // [修改] executor 可为空；非空时全量导出会并行建树与格式化
+  SqliteReportRepositoryAdapter(
+      sqlite3 *db, const GlobalReportConfig &config,
+      std::shared_ptr<core::interfaces::ITaskExecutor> executor = nullptr);
   ~SqliteReportRepositoryAdapter() override;
 
   std::string GetDailyReport(const std::string &date,
@@ -31,13 +35,29 @@ public:
   std::string GetRangeReport(const std::string &start_date,
                              const std::string &end_date,
                              ReportFormat format) override;
+  std::string GetComparisonReport(const std::string &period,
+                                  ReportFormat format) override;
 
   FormattedGroupedReports GetAllDailyReports(ReportFormat format) override;
 
   FormattedWeeklyReports GetAllWeeklyReports(ReportFormat format) override;
   FormattedYearlyReports GetAllYearlyReports(ReportFormat format) override;
+  FormattedPeriodHistory
+  GetAllPeriodReports(const std::vector<ReportPeriod> &periods,
+                      ReportFormat format) override;
+  void StreamAllDailyReportsMultiFormat(
+      const std::vector<ReportFormat> &formats,
+      const MultiFormatDailyBatchSink &sink) override;
+  MultiFormatPeriodHistory GetAllPeriodReportsMultiFormat(
+      const std::vector<ReportPeriod> &periods,
+      const std::vector<ReportFormat> &formats) override;
 
   FormattedMonthlyReports GetAllMonthlyReports(ReportFormat format) override;
+
+  void StreamAllDailyReports(ReportFormat format,
+                             const DailyReportBatchSink &sink) override;
+  void StreamAllMonthlyReports(ReportFormat format,
+                               const MonthlyReportBatchSink &sink) override;
   FormattedRecentReports GetAllRecentReports(const std::vector<int> &days_list,
                                              ReportFormat format) override;
 
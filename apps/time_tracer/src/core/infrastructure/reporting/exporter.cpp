@@ -1,25 +1,34 @@
 ﻿// core/infrastructure/reporting/exporter.cpp
 #include "core/infrastructure/reporting/exporter.hpp"
+#include "core/domain/ports/parallel_for.hpp"
 #include "core/infrastructure/reporting/export_utils.hpp"
 #include "core/infrastructure/reporting/report_file_manager.hpp"
 #include <filesystem>
+#include <map>
+#include <set>
 
 namespace fs = std::filesystem;
 
 // [修改] 构造函数注入 Notifier
 Exporter::Exporter(const fs::path &export_root_path,
                    std::shared_ptr<core::interfaces::IFileSystem> fs,
-                   std::shared_ptr<core::interfaces::IUserNotifier> notifier)
-    : fs_(std::move(fs)), notifier_(std::move(notifier)) {
+                   std::shared_ptr<core::interfaces::IUserNotifier> notifier,
+                   std::shared_ptr<core::interfaces::ITaskExecutor> executor)
+    : fs_(std::move(fs)), notifier_(std::move(notifier)),
+      executor_(std::move(executor)) {
   file_manager_ = std::make_unique<ReportFileManager>(export_root_path);
 }
 
 Exporter::~Exporter() = default;
 
+static bool should_write_report(const std::string &report_content) {
+  return !report_content.empty() &&
+         report_content.find("No time records") == std::string::npos;
+}
+
 void Exporter::WriteReportToFile(const std::string &report_content,
                                  const fs::path &output_path) const {
-  if (report_content.empty() ||
-      report_content.find("No time records") != std::string::npos) {
+  if (!should_write_report(report_content)) {
     return;
   }
 
@@ -35,6 +44,58 @@ void Exporter::WriteReportToFile(const std::string &report_content,
   }
 }
 
+int Exporter::WriteReportsToFiles(
+    const std::vector<PendingWrite> &writes) const {
+  int files_created = 0;
+  std::vector<const PendingWrite *> to_write;
+  std::set<fs::path> directories;
+  for (const auto &write : writes) {
+    if (!write.content_->empty()) {
+      files_created++;
+    }
+    if (should_write_report(*write.content_)) {
+      to_write.push_back(&write);
+      directories.insert(write.path_.parent_path());
+    }
+  }
+
+  // 1. 目录串行创建，避免多个线程同时 create_directories 同一路径
+  std::set<fs::path> failed_directories;
+  for (const auto &dir : directories) {
+    try {
+      fs_->CreateDirectories(dir);
+    } catch (const std::exception &e) {
+      failed_directories.insert(dir);
+      notifier_->NotifyError("Error: Failed to write report to " +
+                             dir.string() + ": " + e.what());
+    }
+  }
+
+  // 2. 文件并行写入，每个槽位只记录自己的错误
+  std::vector<std::string> errors(to_write.size());
+  core::interfaces::ParallelFor(
+      executor_.get(), to_write.size(), [&](size_t i) {
+        const PendingWrite &write = *to_write[i];
+        if (failed_directories.count(write.path_.parent_path()) > 0) {
+          return;
+        }
+        try {
+          fs_->WriteContent(write.path_, *write.content_);
+        } catch (const std::exception &e) {
+          errors[i] = "Error: Failed to write report to " +
+                      write.path_.string() + ": " + e.what();
+        }
+      });
+
+  // 3. 错误按输入顺序输出，保证控制台信息确定
+  for (const auto &error : errors) {
+    if (!error.empty()) {
+      notifier_->NotifyError(error);
+    }
+  }
+  return files_created;
+}
+
 void Exporter::ExportSingleDayReport(const std::string &date,
                                      const std::string &content,
                                      ReportFormat format) const {
@@ -98,31 +159,77 @@ void Exporter::ExportAllDailyReports(const FormattedGroupedReports &reports,
 
   // [修改] 传递 notifier 给通用工具
   ExportUtils::ExecuteExportTask("日报", base_dir, *notifier_, [&]() {
-    int files_created = 0;
+    std::vector<PendingWrite> writes;
     for (const auto &year_pair : reports) {
       for (const auto &month_pair : year_pair.second) {
         for (const auto &day_report : month_pair.second) {
           const std::string &date = day_report.first;
-          const std::string &content = day_report.second;
-          fs::path report_path =
-              file_manager_->GetSingleDayReportPath(date, format);
-          WriteReportToFile(content, report_path);
-          if (!content.empty())
-            files_created++;
+          writes.push_back(
+              {file_manager_->GetSingleDayReportPath(date, format),
+               &day_report.second});
         }
       }
     }
+    return WriteReportsToFiles(writes);
+  });
+}
+
+void Exporter::ExportAllDailyReports(const DailyReportStream &stream,
+                                     ReportFormat format) const {
+  fs::path base_dir = file_manager_->GetAllDailyReportsBaseDir(format);
+
+  ExportUtils::ExecuteExportTask("日报", base_dir, *notifier_, [&]() {
+    int files_created = 0;
+    stream([&](const DailyReportBatch &batch) {
+      std::vector<PendingWrite> writes;
+      writes.reserve(batch.size());
+      for (const auto &[date, content] : batch) {
+        writes.push_back(
+            {file_manager_->GetSingleDayReportPath(date, format), &content});
+      }
+      files_created += WriteReportsToFiles(writes);
+    });
     return files_created;
   });
 }
 
+void Exporter::ExportAllDailyReportsMultiFormat(
+    const MultiFormatDailyReportStream &stream,
+    const std::vector<ReportFormat> &formats) const {
+  std::map<ReportFormat, int> files_created;
+  try {
+    stream([&](const MultiFormatDailyBatch &batches) {
+      for (const auto &[format, batch] : batches) {
+        std::vector<PendingWrite> writes;
+        writes.reserve(batch.size());
+        for (const auto &[date, content] : batch) {
+          writes.push_back(
+              {file_manager_->GetSingleDayReportPath(date, format), &content});
+        }
+        files_created[format] += WriteReportsToFiles(writes);
+      }
+    });
+  } catch (const std::exception &e) {
+    notifier_->NotifyError("导出过程中发生错误: " + std::string(e.what()));
+    return;
+  }
+
+  // 写盘已在上面一次完成，这里按格式汇报结果
+  for (ReportFormat format : formats) {
+    ExportUtils::ExecuteExportTask(
+        "日报", file_manager_->GetAllDailyReportsBaseDir(format), *notifier_,
+        [&]() { return files_created[format]; });
+  }
+}
+
 // [修复] 实现 ExportAllWeeklyReports 方法
 void Exporter::ExportAllWeeklyReports(const FormattedWeeklyReports &reports,
                                       ReportFormat format) const {
   fs::path base_dir = file_manager_->GetAllWeeklyReportsBaseDir(format);
 
   ExportUtils::ExecuteExportTask("周报", base_dir, *notifier_, [&]() {
-    int files_created = 0;
+    auto details = ExportUtils::GetReportFormatDetails(format).value();
+    std::vector<PendingWrite> writes;
     for (const auto &year_pair : reports) {
       int year = year_pair.first;
       // 建议按年份分文件夹: weekly/2025/
@@ -135,16 +242,12 @@ void Exporter::ExportAllWeeklyReports(const FormattedWeeklyReports &reports,
         // 文件名: 2025-W01.md
         std::string filename = std::format("{}-W{:02d}", year, week);
 
-        // 获取后缀并构造完整路径
-        auto details = ExportUtils::GetReportFormatDetails(format).value();
-        fs::path report_path = year_dir / (filename + details.extension_);
-
-        WriteReportToFile(content, report_path);
-        if (!content.empty())
-          files_created++;
+        // 构造完整路径 (后缀在循环外解析一次)
+        writes.push_back(
+            {year_dir / (filename + details.extension_), &content});
       }
     }
-    return files_created;
+    return WriteReportsToFiles(writes);
   });
 }
 
@@ -154,7 +257,7 @@ void Exporter::ExportAllMonthlyReports(const FormattedMonthlyReports &reports,
 
   // [修改] 传递 notifier 给通用工具
   ExportUtils::ExecuteExportTask("月报", base_dir, *notifier_, [&]() {
-    int files_created = 0;
+    std::vector<PendingWrite> writes;
     for (const auto &year_pair : reports) {
       int year = year_pair.first;
       for (const auto &month_pair : year_pair.second) {
@@ -163,13 +266,32 @@ void Exporter::ExportAllMonthlyReports(const FormattedMonthlyReports &reports,
         std::string month_str = std::to_string(year) + (month < 10 ? "0" : "") +
                                 std::to_string(month);
 
-        fs::path report_path =
-            file_manager_->GetSingleMonthReportPath(month_str, format);
-        WriteReportToFile(content, report_path);
-        if (!content.empty())
-          files_created++;
+        writes.push_back(
+            {file_manager_->GetSingleMonthReportPath(month_str, format),
+             &content});
       }
     }
+    return WriteReportsToFiles(writes);
+  });
+}
+
+void Exporter::ExportAllMonthlyReports(const MonthlyReportStream &stream,
+                                       ReportFormat format) const {
+  fs::path base_dir = file_manager_->GetAllMonthlyReportsBaseDir(format);
+
+  ExportUtils::ExecuteExportTask("月报", base_dir, *notifier_, [&]() {
+    int files_created = 0;
+    stream([&](int year, const MonthlyReportBatch &batch) {
+      std::vector<PendingWrite> writes;
+      for (const auto &[month, content] : batch) {
+        std::string month_str = std::to_string(year) + (month < 10 ? "0" : "") +
+                                std::to_string(month);
+        writes.push_back(
+            {file_manager_->GetSingleMonthReportPath(month_str, format),
+             &content});
+      }
+      files_created += WriteReportsToFiles(writes);
+    });
     return files_created;
   });
 }
@@ -179,38 +301,53 @@ void Exporter::ExportAllYearlyReports(const FormattedYearlyReports &reports,
   fs::path base_dir = file_manager_->GetAllYearlyReportsBaseDir(format);
 
   ExportUtils::ExecuteExportTask("年报", base_dir, *notifier_, [&]() {
-    int files_created = 0;
+    std::vector<PendingWrite> writes;
     for (const auto &year_pair : reports) {
       int year = year_pair.first;
       const std::string &content = year_pair.second;
       std::string year_str = std::to_string(year);
 
-      fs::path report_path =
-          file_manager_->GetSingleYearReportPath(year_str, format);
-      WriteReportToFile(content, report_path);
-      if (!content.empty())
-        files_created++;
+      writes.push_back(
+          {file_manager_->GetSingleYearReportPath(year_str, format), &content});
     }
-    return files_created;
+    return WriteReportsToFiles(writes);
   });
 }
 
+void Exporter::ExportAllPeriodReports(ReportPeriod period,
+                                      const FormattedPeriodReports &reports,
+                                      ReportFormat format) const {
+  static constexpr const char *kPeriodNames[] = {"周报", "双周报", "月报",
+                                                 "季报", "半年报", "年报"};
+  fs::path base_dir = file_manager_->GetAllPeriodReportsBaseDir(period, format);
+
+  ExportUtils::ExecuteExportTask(
+      kPeriodNames[static_cast<int>(period)], base_dir, *notifier_, [&]() {
+        std::vector<PendingWrite> writes;
+        writes.reserve(reports.size());
+        for (const auto &[period_key, content] : reports) {
+          writes.push_back(
+              {file_manager_->GetSinglePeriodReportPath(period, period_key,
+                                                        format),
+               &content});
+        }
+        return WriteReportsToFiles(writes);
+      });
+}
+
 void Exporter::ExportAllRecentReports(const FormattedRecentReports &reports,
                                       ReportFormat format) const {
   fs::path base_dir = file_manager_->GetAllRecentReportsBaseDir(format);
 
   // [修改] 传递 notifier 给通用工具
   ExportUtils::ExecuteExportTask("近期报告", base_dir, *notifier_, [&]() {
-    int files_created = 0;
+    std::vector<PendingWrite> writes;
     for (const auto &report_pair : reports) {
       int days = report_pair.first;
       const std::string &content = report_pair.second;
-      fs::path report_path =
-          file_manager_->GetSingleRecentReportPath(days, format);
-      WriteReportToFile(content, report_path);
-      if (!content.empty())
-        files_created++;
+      writes.push_back(
+          {file_manager_->GetSingleRecentReportPath(days, format), &content});
     }
-    return files_created;
+    return WriteReportsToFiles(writes);
   });
 }
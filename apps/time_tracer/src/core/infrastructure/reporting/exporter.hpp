@@ -4,10 +4,12 @@
 
 #include "core/domain/model/query_data_structs.hpp"
 #include "core/domain/ports/i_file_system.hpp"
+#include "core/domain/ports/i_task_executor.hpp"
 #include "core/domain/ports/i_user_notifier.hpp" // [新增]
 #include "core/domain/repositories/i_report_repository.hpp" // 引入 FormattedWeeklyReports 定义
 #include "core/domain/types/report_format.hpp"
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -16,10 +18,18 @@ class ReportFileManager;
 
 class Exporter {
 public:
-  // [修改] 注入 Notifier
+  // [新增] 流式导出的数据源：调用方在其中逐窗口调用传入的 sink
+  using DailyReportStream = std::function<void(const DailyReportBatchSink &)>;
+  using MonthlyReportStream =
+      std::function<void(const MonthlyReportBatchSink &)>;
+  using MultiFormatDailyReportStream =
+      std::function<void(const MultiFormatDailyBatchSink &)>;
+
+  // [修改] 注入 Notifier；executor 可选，非空时全量导出并行写文件
   Exporter(const fs::path &export_root_path,
            std::shared_ptr<core::interfaces::IFileSystem> fs,
-           std::shared_ptr<core::interfaces::IUserNotifier> notifier);
+           std::shared_ptr<core::interfaces::IUserNotifier> notifier,
+           std::shared_ptr<core::interfaces::ITaskExecutor> executor = nullptr);
   ~Exporter();
 
   void ExportSingleDayReport(const std::string &date,
@@ -51,12 +61,37 @@ public:
                               ReportFormat format) const;
   void ExportAllRecentReports(const FormattedRecentReports &reports,
                               ReportFormat format) const;
+  // [新增] 通用周期报表 (双周 / 季度 / 半年等)
+  void ExportAllPeriodReports(ReportPeriod period,
+                              const FormattedPeriodReports &reports,
+                              ReportFormat format) const;
+
+  // [新增] 流式全量导出：每收到一个窗口就写盘，写完即释放该窗口
+  void ExportAllDailyReports(const DailyReportStream &stream,
+                             ReportFormat format) const;
+  void ExportAllMonthlyReports(const MonthlyReportStream &stream,
+                               ReportFormat format) const;
+  // [新增] 多格式流式导出：每个窗口同时包含所有格式，写完即释放
+  void
+  ExportAllDailyReportsMultiFormat(const MultiFormatDailyReportStream &stream,
+                                   const std::vector<ReportFormat> &formats)
+      const;
 
 private:
+  // [新增] 一份待写入的报表 (content 指向调用方持有的字符串)
+  struct PendingWrite {
+    fs::path path_;
+    const std::string *content_;
+  };
+
   void WriteReportToFile(const std::string &report_content,
                          const fs::path &output_path) const;
+  // [新增] 批量写入：目录串行创建，文件并行写入，错误按顺序上报。
+  // 返回非空报表数 (与原逐个写入时的统计口径一致)
+  int WriteReportsToFiles(const std::vector<PendingWrite> &writes) const;
   std::unique_ptr<ReportFileManager> file_manager_;
   std::shared_ptr<core::interfaces::IFileSystem> fs_;
   std::shared_ptr<core::interfaces::IUserNotifier> notifier_; // [新增]
+  std::shared_ptr<core::interfaces::ITaskExecutor> executor_;
 };
 #endif
@@ -1,6 +1,7 @@
 ﻿// core/infrastructure/reporting/report_file_manager.cpp
 #include "core/infrastructure/reporting/report_file_manager.hpp"
 #include "core/infrastructure/reporting/export_utils.hpp"
+#include <algorithm>
 #include <stdexcept>
 
 ReportFileManager::ReportFileManager(const fs::path &export_root)
@@ -83,3 +84,49 @@ ReportFileManager::GetAllRecentReportsBaseDir(ReportFormat format) const {
   auto details = ExportUtils::GetReportFormatDetails(format).value();
   return export_root_path_ / details.dir_name_ / "recent";
 }
+
+fs::path
+ReportFileManager::GetAllPeriodReportsBaseDir(ReportPeriod period,
+                                              ReportFormat format) const {
+  auto details = ExportUtils::GetReportFormatDetails(format).value();
+  switch (period) {
+  case ReportPeriod::Week:
+    return GetAllWeeklyReportsBaseDir(format);
+  case ReportPeriod::BiWeek:
+    return export_root_path_ / details.dir_name_ / "biweek";
+  case ReportPeriod::Month:
+    return GetAllMonthlyReportsBaseDir(format);
+  case ReportPeriod::Quarter:
+    return export_root_path_ / details.dir_name_ / "quarter";
+  case ReportPeriod::HalfYear:
+    return export_root_path_ / details.dir_name_ / "half_year";
+  case ReportPeriod::Year:
+  default:
+    return GetAllYearlyReportsBaseDir(format);
+  }
+}
+
+fs::path
+ReportFileManager::GetSinglePeriodReportPath(ReportPeriod period,
+                                             const std::string &period_key,
+                                             ReportFormat format) const {
+  auto details = ExportUtils::GetReportFormatDetails(format).value();
+  fs::path base_dir = GetAllPeriodReportsBaseDir(period, format);
+  switch (period) {
+  case ReportPeriod::Week:
+  case ReportPeriod::BiWeek:
+    // 与 all-week 一致按年份分文件夹: week/2025/2025-W01.md
+    return base_dir / period_key.substr(0, 4) /
+           (period_key + details.extension_);
+  case ReportPeriod::Month: {
+    // 与 all-month 一致使用 YYYYMM 命名
+    std::string month = period_key;
+    month.erase(std::remove(month.begin(), month.end(), '-'), month.end());
+    return GetSingleMonthReportPath(month, format);
+  }
+  case ReportPeriod::Year:
+    return GetSingleYearReportPath(period_key, format);
+  default:
+    return base_dir / (period_key + details.extension_);
+  }
+}
@@ -3,6 +3,7 @@
 #define CORE_INFRASTRUCTURE_REPORTING_REPORT_FILE_MANAGER_HPP_
 
 #include "core/domain/types/report_format.hpp"
+#include "core/domain/types/report_period.hpp"
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -32,6 +33,13 @@ public:
   fs::path GetAllYearlyReportsBaseDir(ReportFormat format) const;
   fs::path GetAllRecentReportsBaseDir(ReportFormat format) const;
 
+  // [新增] 通用周期报表；周 / 月 / 年沿用上面各自的目录与命名
+  fs::path GetAllPeriodReportsBaseDir(ReportPeriod period,
+                                      ReportFormat format) const;
+  fs::path GetSinglePeriodReportPath(ReportPeriod period,
+                                     const std::string &period_key,
+                                     ReportFormat format) const;
+
 private:
   fs::path export_root_path_;
 };
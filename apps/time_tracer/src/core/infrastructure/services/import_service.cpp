@@ -7,9 +7,11 @@ namespace core::service {
 ImportService::ImportService(
     std::string db_path, std::shared_ptr<core::interfaces::IFileSystem> fs,
     std::shared_ptr<core::interfaces::IUserNotifier> notifier,
-    std::shared_ptr<core::interfaces::ILogSerializer> serializer)
+    std::shared_ptr<core::interfaces::ILogSerializer> serializer,
+    core::interfaces::ProjectCreatedCallback on_project_created)
     : db_path_(std::move(db_path)), fs_(std::move(fs)),
-      notifier_(std::move(notifier)), serializer_(std::move(serializer)) {}
+      notifier_(std::move(notifier)), serializer_(std::move(serializer)),
+      on_project_created_(std::move(on_project_created)) {}
 
 void ImportService::ImportFromFiles(const std::string &directory_path) {
   notifier_->NotifyInfo("正在扫描待导入文件...");
@@ -40,9 +42,15 @@ void ImportService::ImportFromFiles(const std::string &directory_path) {
 }
 
 void ImportService::ImportFromMemory(
-    const std::map<std::string, std::vector<DailyLog>> &data_map) {
+    const std::map<std::string, std::vector<DailyLog>> &data_map,
+    const ManifestChanges &manifest_changes) {
   // 依然调用底层 Importer (暂未重构部分)
-  handle_process_memory_data(db_path_, data_map);
+  handle_process_memory_data(db_path_, data_map, manifest_changes,
+                             on_project_created_);
+}
+
+SourceManifest ImportService::LoadSourceManifest() {
+  return handle_load_source_manifest(db_path_);
 }
 
 } // namespace core::service
@@ -4,8 +4,10 @@
 
 #include "application/interfaces/i_log_serializer.hpp" // [新增] 依赖接口
 #include "core/domain/model/daily_log.hpp"
+#include "core/domain/model/source_manifest.hpp"
 #include "core/domain/ports/i_file_system.hpp"
 #include "core/domain/ports/i_user_notifier.hpp"
+#include "core/domain/ports/project_created_callback.hpp"
 #include <map>
 #include <memory>
 #include <string>
@@ -15,15 +17,23 @@ namespace core::service {
 
 class ImportService {
 public:
+  // [修改] on_project_created: 导入时新建项目节点的回调 (可为空)
   ImportService(std::string db_path,
                 std::shared_ptr<core::interfaces::IFileSystem> fs,
                 std::shared_ptr<core::interfaces::IUserNotifier> notifier,
                 std::shared_ptr<core::interfaces::ILogSerializer>
-                    serializer); // [修改] 注入 Serializer
+                    serializer, // [修改] 注入 Serializer
+                core::interfaces::ProjectCreatedCallback on_project_created =
+                    {});
 
   void ImportFromFiles(const std::string &directory_path);
+  // [修改] manifest_changes: 源文件清单的变更与需清除的月份 (同事务写入)
   void ImportFromMemory(
-      const std::map<std::string, std::vector<DailyLog>> &data_map);
+      const std::map<std::string, std::vector<DailyLog>> &data_map,
+      const ManifestChanges &manifest_changes = {});
+
+  // [新增] 读取上一次摄入保存的源文件清单
+  SourceManifest LoadSourceManifest();
 
 private:
   std::string db_path_;
@@ -31,6 +41,7 @@ private:
   std::shared_ptr<core::interfaces::IUserNotifier> notifier_;
   std::shared_ptr<core::interfaces::ILogSerializer>
       serializer_; // [新增] 持有接口
+  core::interfaces::ProjectCreatedCallback on_project_created_;
 };
 
 } // namespace core::service
@@ -39,6 +39,21 @@ void print_report(const ImportStats &stats, const std::string &title) {
       std::cerr << "  Failed: " << f << std::endl;
   }
 
+  // [新增] 行级写入结果
+  std::cout << "Rows: days=" << stats.days_written
+            << ", records=" << stats.records_written << std::endl;
+  if (!stats.failed_rows.empty()) {
+    constexpr size_t kMaxListedRows = 10;
+    std::cerr << kYellowColor << "[Warning] " << stats.failed_rows.size()
+              << " row(s) failed to insert." << kResetColor << std::endl;
+    for (size_t i = 0; i < stats.failed_rows.size() && i < kMaxListedRows;
+         ++i) {
+      const auto &row = stats.failed_rows[i];
+      std::cerr << "  " << row.table << " [" << row.key
+                << "]: " << row.message << std::endl;
+    }
+  }
+
   std::cout << std::fixed << std::setprecision(3);
   std::cout << "Timing: Parse=" << stats.parsing_duration_s
             << "s, Insert=" << stats.db_insertion_duration_s
@@ -52,19 +67,28 @@ void print_report(const ImportStats &stats, const std::string &title) {
 
 void handle_process_memory_data(
     const std::string &db_name,
-    const std::map<std::string, std::vector<DailyLog>> &data) {
+    const std::map<std::string, std::vector<DailyLog>> &data,
+    const ManifestChanges &manifest_changes,
+    const core::interfaces::ProjectCreatedCallback &on_project_created) {
   std::cout << "Task: Memory Import..." << std::endl;
 
   // 1. 创建组件 (Wiring Dependencies)
   auto connection = std::make_shared<Connection>(db_name);
-  auto repository = std::make_shared<Repository>(connection);
+  auto repository = std::make_shared<Repository>(
+      connection, Statement::kDefaultBatchRows, on_project_created);
   auto parser = std::make_shared<MemoryParser>();
 
   // 2. 注入 Service
   ImportService service(repository, parser);
 
   // 3. 执行业务
-  ImportStats stats = service.import_from_memory(data);
+  ImportStats stats = service.import_from_memory(data, manifest_changes);
 
   print_report(stats, "Memory Import");
 }
+
+SourceManifest handle_load_source_manifest(const std::string &db_name) {
+  auto connection = std::make_shared<Connection>(db_name);
+  Repository repository(connection);
+  return repository.load_source_manifest();
+}
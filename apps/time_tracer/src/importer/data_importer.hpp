@@ -8,10 +8,19 @@
 #include <utility> // for std::pair
 #include <vector>
 
+#include "core/domain/model/source_manifest.hpp"
+#include "core/domain/ports/project_created_callback.hpp"
+
 struct DailyLog;
 
+// [修改] on_project_created: 导入时新建项目节点的回调 (可为空)
 void handle_process_memory_data(
     const std::string &db_name,
-    const std::map<std::string, std::vector<DailyLog>> &data_map);
+    const std::map<std::string, std::vector<DailyLog>> &data_map,
+    const ManifestChanges &manifest_changes = {},
+    const core::interfaces::ProjectCreatedCallback &on_project_created = {});
+
+// [新增] 读取 source_manifest (增量摄入)
+SourceManifest handle_load_source_manifest(const std::string &db_name);
 
 #endif // IMPORTER_DATA_IMPORTER_HPP_
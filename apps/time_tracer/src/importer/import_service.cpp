@@ -10,13 +10,14 @@ ImportService::ImportService(std::shared_ptr<Repository> repository,
     : repository_(std::move(repository)), parser_(std::move(parser)) {}
 
 ImportStats ImportService::import_from_memory(
-    const std::map<std::string, std::vector<DailyLog>> &data_map) {
+    const std::map<std::string, std::vector<DailyLog>> &data_map,
+    const ManifestChanges &manifest_changes) {
   ImportStats stats;
   for (const auto &p : data_map)
     stats.total_files += p.second.size();
   stats.successful_files = stats.total_files;
 
-  if (data_map.empty())
+  if (data_map.empty() && manifest_changes.empty())
     return stats;
 
   auto start = std::chrono::high_resolution_clock::now();
@@ -32,7 +33,11 @@ ImportStats ImportService::import_from_memory(
   if (repository_->is_db_open()) {
     stats.db_open_success = true;
     try {
-      repository_->import_data(all_data.days, all_data.records);
+      WriteReport report = repository_->import_data(
+          all_data.days, all_data.records, manifest_changes);
+      stats.days_written = report.days_written;
+      stats.records_written = report.records_written;
+      stats.failed_rows = std::move(report.failed_rows);
       stats.transaction_success = true;
     } catch (const std::exception &e) {
       stats.transaction_success = false;
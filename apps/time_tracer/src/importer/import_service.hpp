@@ -3,6 +3,7 @@
 #define IMPORTER_IMPORT_SERVICE_HPP_
 
 #include "core/domain/model/daily_log.hpp"
+#include "core/domain/model/source_manifest.hpp"
 #include "importer/model/import_stats.hpp"
 #include <map>
 #include <memory>
@@ -20,7 +21,8 @@ public:
                 std::shared_ptr<MemoryParser> parser);
 
   ImportStats import_from_memory(
-      const std::map<std::string, std::vector<DailyLog>> &data_map);
+      const std::map<std::string, std::vector<DailyLog>> &data_map,
+      const ManifestChanges &manifest_changes = {});
 
 private:
   std::shared_ptr<Repository> repository_;
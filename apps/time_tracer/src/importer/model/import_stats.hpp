@@ -5,6 +5,20 @@
 #include <string>
 #include <vector>
 
+// [新增] 单行写入失败 (批量 INSERT 失败后逐行重试定位)
+struct RowFailure {
+  std::string table; // "days" / "time_records"
+  std::string key;   // date 或 logical_id
+  std::string message;
+};
+
+// [新增] Repository 一次写入的结果
+struct WriteReport {
+  size_t days_written = 0;
+  size_t records_written = 0;
+  std::vector<RowFailure> failed_rows;
+};
+
 // 用于在 Service 层和 Facade 层之间传递执行结果
 struct ImportStats {
   size_t total_files = 0;
@@ -19,6 +33,11 @@ struct ImportStats {
   bool db_open_success = false;
   bool transaction_success = false;
   std::string error_message; // 全局错误信息
+
+  // [新增] 行级写入统计
+  size_t days_written = 0;
+  size_t records_written = 0;
+  std::vector<RowFailure> failed_rows;
 };
 
 #endif // IMPORTER_MODEL_IMPORT_STATS_HPP_
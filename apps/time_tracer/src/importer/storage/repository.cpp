@@ -1,25 +1,33 @@
 ﻿// importer/storage/repository.cpp
 #include "importer/storage/repository.hpp"
 #include <iostream>
+#include <set>
 
 // [修改] 构造函数只负责组装组件
-Repository::Repository(std::shared_ptr<Connection> connection)
+Repository::Repository(
+    std::shared_ptr<Connection> connection, size_t batch_rows,
+    core::interfaces::ProjectCreatedCallback on_project_created)
     : connection_manager_(std::move(connection)) {
   if (is_db_open()) {
     sqlite3 *db = connection_manager_->get_db();
 
     // 1. 初始化 Statements
-    statement_manager_ = std::make_unique<Statement>(db);
+    statement_manager_ = std::make_unique<Statement>(db, batch_rows);
 
     // 2. 初始化 Resolver (作为 Writer 的依赖)
     auto project_resolver = std::make_unique<ProjectResolver>(
-        db, statement_manager_->get_insert_project_stmt());
+        db, statement_manager_->get_insert_project_stmt(),
+        std::move(on_project_created));
 
     // 3. 初始化 Writer (注入 Resolver)
-    data_inserter_ =
-        std::make_unique<Writer>(db, statement_manager_->get_insert_day_stmt(),
-                                 statement_manager_->get_insert_record_stmt(),
-                                 std::move(project_resolver));
+    data_inserter_ = std::make_unique<Writer>(db, *statement_manager_,
+                                              std::move(project_resolver));
+
+    // 4. 初始化源文件清单
+    manifest_store_ = std::make_unique<ManifestStore>(db);
+
+    // 5. [新增] 预聚合表
+    rollup_store_ = std::make_unique<RollupStore>(db);
   }
 }
 
@@ -27,27 +35,58 @@ bool Repository::is_db_open() const {
   return connection_manager_ && connection_manager_->get_db();
 }
 
-void Repository::import_data(const std::vector<DayData> &days,
-                             const std::vector<TimeRecordInternal> &records) {
+WriteReport Repository::import_data(
+    const std::vector<DayData> &days,
+    const std::vector<TimeRecordInternal> &records,
+    const ManifestChanges &manifest_changes) {
   if (!is_db_open()) {
-    std::cerr << "Database is not open. Cannot import data." << std::endl;
-    return;
+    throw std::runtime_error("Database is not open. Cannot import data.");
   }
 
   if (!connection_manager_->begin_transaction()) {
-    return;
+    throw std::runtime_error("Failed to begin transaction.");
+  }
+
+  // 收集本次写入涉及的月份 ("YYYY-MM")，整月替换
+  // [修改] 加上源文件以前产出、本次可能不再产出的月份，清除其残留数据
+  std::set<std::string> month_set(manifest_changes.stale_months_.begin(),
+                                  manifest_changes.stale_months_.end());
+  for (const auto &day : days) {
+    if (day.date_.length() >= 7)
+      month_set.insert(day.date_.substr(0, 7));
   }
+  std::vector<std::string> months(month_set.begin(), month_set.end());
 
+  WriteReport report;
   try {
-    data_inserter_->insert_days(days);
-    data_inserter_->insert_records(records);
+    data_inserter_->delete_months(months);
+    report.days_written = data_inserter_->insert_days(days, report.failed_rows);
+    report.records_written =
+        data_inserter_->insert_records(records, report.failed_rows);
+    // [新增] 与数据写入同一事务刷新涉及月份的预聚合
+    rollup_store_->refresh_months(months);
+    manifest_store_->upsert(manifest_changes.upserts_);
+    manifest_store_->remove(manifest_changes.removed_paths_);
 
     if (!connection_manager_->commit_transaction()) {
       throw std::runtime_error("Failed to commit transaction.");
     }
+    // [新增] 首次建库：数据写完后再建索引并恢复安全设置
+    if (connection_manager_->is_bulk_load()) {
+      connection_manager_->finish_bulk_load();
+    }
   } catch (const std::exception &e) {
     std::cerr << "An error occurred during data import: " << e.what()
               << std::endl;
     connection_manager_->rollback_transaction();
+    connection_manager_->finish_bulk_load();
+    throw;
   }
+  return report;
+}
+
+SourceManifest Repository::load_source_manifest() const {
+  if (!is_db_open())
+    return {};
+  return manifest_store_->load_all();
 }
@@ -2,6 +2,7 @@
 #ifndef IMPORTER_STORAGE_REPOSITORY_HPP_
 #define IMPORTER_STORAGE_REPOSITORY_HPP_
 
+#include "importer/model/import_stats.hpp"
 #include "importer/model/time_sheet_data.hpp"
 #include <memory>
 #include <string>
@@ -9,24 +10,41 @@
 
 // 引用新的组件头文件
 #include "importer/storage/sqlite/connection.hpp"
+#include "importer/storage/sqlite/manifest_store.hpp"
+#include "importer/storage/sqlite/rollup_store.hpp"
 #include "importer/storage/sqlite/statement.hpp"
 #include "importer/storage/sqlite/writer.hpp"
 
 class Repository {
 public:
-  // [修改] 注入 Connection，解耦数据库文件的打开逻辑
-  explicit Repository(std::shared_ptr<Connection> connection);
+  // [修改] 注入 Connection，解耦数据库文件的打开逻辑；
+  // batch_rows 为多行 INSERT 每条语句的行数；
+  // on_project_created 在新建项目节点后回调 (可为空)
+  explicit Repository(
+      std::shared_ptr<Connection> connection,
+      size_t batch_rows = Statement::kDefaultBatchRows,
+      core::interfaces::ProjectCreatedCallback on_project_created = {});
   ~Repository() = default;
 
   bool is_db_open() const;
 
-  void import_data(const std::vector<DayData> &days,
-                   const std::vector<TimeRecordInternal> &records);
+  // [修改] 先整月删除 days 涉及的月份再写入，使重复摄入同一月份幂等；
+  // manifest_changes 在同一事务内写入 source_manifest，其 stale_months_
+  // 与 days 的月份一并删除并刷新预聚合。
+  // [修改] 返回写入行数与行级失败；事务失败时回滚并抛出异常
+  WriteReport import_data(const std::vector<DayData> &days,
+                          const std::vector<TimeRecordInternal> &records,
+                          const ManifestChanges &manifest_changes = {});
+
+  // [新增] 读取源文件清单 (增量摄入)
+  SourceManifest load_source_manifest() const;
 
 private:
   std::shared_ptr<Connection> connection_manager_;
   std::unique_ptr<Statement> statement_manager_;
   std::unique_ptr<Writer> data_inserter_;
+  std::unique_ptr<ManifestStore> manifest_store_;
+  std::unique_ptr<RollupStore> rollup_store_;
 };
 
 #endif // IMPORTER_STORAGE_REPOSITORY_HPP_
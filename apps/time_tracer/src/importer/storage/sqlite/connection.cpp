@@ -1,5 +1,7 @@
 ﻿// importer/storage/sqlite/connection.cpp
 #include "importer/storage/sqlite/connection.hpp"
+#include "core/infrastructure/persistence/schema_migrator.hpp"
+#include "importer/storage/sqlite/rollup_store.hpp"
 #include <iostream>
 
 Connection::Connection(const std::string &db_path) : db_(nullptr) { // MODIFIED
@@ -8,35 +10,20 @@ Connection::Connection(const std::string &db_path) : db_(nullptr) { // MODIFIED
               << std::endl; // MODIFIED
     db_ = nullptr;          // MODIFIED
   } else {
-    const char *create_days_sql = "CREATE TABLE IF NOT EXISTS days ("
-                                  "date TEXT PRIMARY KEY, "
-                                  "year INTEGER, "
-                                  "month INTEGER, "
-                                  "status INTEGER, "
-                                  "sleep INTEGER, "
-                                  "remark TEXT, "
-                                  "getup_time TEXT, "
-                                  "exercise INTEGER, "
-                                  "total_exercise_time INTEGER, "
-                                  "cardio_time INTEGER, "
-                                  "anaerobic_time INTEGER, "
-                                  "gaming_time INTEGER, "
-                                  "grooming_time INTEGER, "
-                                  "toilet_time INTEGER, "
-                                  "study_time INTEGER, "
-                                  "sleep_night_time INTEGER, "
-                                  "sleep_day_time INTEGER, "
-                                  "sleep_total_time INTEGER, "
-                                  "recreation_time INTEGER, "          // 新增
-                                  "recreation_zhihu_time INTEGER, "    // 新增
-                                  "recreation_bilibili_time INTEGER, " // 新增
-                                  "recreation_douyin_time INTEGER);";  // 新增
-    execute_sql(db_, create_days_sql, "Create days table"); // MODIFIED
-
-    const char *create_index_sql =
-        "CREATE INDEX IF NOT EXISTS idx_year_month ON days (year, month);";
-    execute_sql(db_, create_index_sql,
-                "Create index on days(year, month)"); // MODIFIED
+    // [新增] 空库：开启批量加载参数 (必须在建表/事务之前设置)
+    bulk_load_ = is_empty_database();
+    if (bulk_load_) {
+      execute_sql(db_,
+                  "PRAGMA locking_mode = EXCLUSIVE;"
+                  "PRAGMA journal_mode = WAL;"
+                  "PRAGMA synchronous = OFF;"
+                  "PRAGMA cache_size = -65536;" // 64 MiB
+                  "PRAGMA temp_store = MEMORY;",
+                  "Enable bulk-load pragmas");
+    }
+
+    // [修改] days / time_records 定义移至 SchemaMigrator，与 v4 迁移共用
+    SchemaMigrator::create_day_tables(db_);
 
     const char *create_projects_sql =
         "CREATE TABLE IF NOT EXISTS projects ("
@@ -46,25 +33,77 @@ Connection::Connection(const std::string &db_path) : db_(nullptr) { // MODIFIED
         "FOREIGN KEY (parent_id) REFERENCES projects(id));";
     execute_sql(db_, create_projects_sql, "Create projects table"); // MODIFIED
 
-    const char *create_records_sql =
-        "CREATE TABLE IF NOT EXISTS time_records ("
-        "logical_id INTEGER PRIMARY KEY, "
-        "start_timestamp INTEGER, "
-        "end_timestamp INTEGER, "
-        "date TEXT, "
-        "start TEXT, "
-        "end TEXT, "
-        "project_id INTEGER, "
-        "duration INTEGER, "
-        "activity_remark TEXT, "
-        "FOREIGN KEY (date) REFERENCES days(date), "
-        "FOREIGN KEY (project_id) REFERENCES projects(id));";
-    execute_sql(db_, create_records_sql,
-                "Create time_records table"); // MODIFIED
+    // [新增] 源文件清单：增量摄入时判断哪些 .txt 发生了变化
+    const char *create_manifest_sql =
+        "CREATE TABLE IF NOT EXISTS source_manifest ("
+        "path TEXT PRIMARY KEY, "
+        "size INTEGER, "
+        "mtime INTEGER, "
+        "hash TEXT, "
+        "months TEXT);";
+    execute_sql(db_, create_manifest_sql, "Create source_manifest table");
+
+    // [新增] 按日/周/月/年预聚合的项目时长 (导入事务内维护)
+    RollupStore::create_tables(db_);
+
+    // [修改] 批量加载模式下，二级索引在 finish_bulk_load() 中创建；
+    // 已有数据库在打开时升级到最新模式版本 (见 SchemaMigrator)
+    if (bulk_load_) {
+      // 空的旧版表 (TEXT 日期) 同样先转换为整数模式
+      SchemaMigrator::migrate_date_keys(db_);
+      SchemaMigrator::drop_secondary_indexes(db_);
+    } else {
+      SchemaMigrator::migrate(db_);
+    }
+  }
+}
+
+bool Connection::is_empty_database() const {
+  // days 表不存在，或存在但没有任何行 (例如之前只读取过 source_manifest)
+  auto query_int = [this](const char *sql) {
+    sqlite3_stmt *stmt = nullptr;
+    int value = -1;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+      value = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return value;
+  };
+
+  int has_days = query_int("SELECT count(*) FROM sqlite_master "
+                           "WHERE type = 'table' AND name = 'days';");
+  if (has_days == 0) {
+    return true;
   }
+  return has_days > 0 && query_int("SELECT EXISTS (SELECT 1 FROM days);") == 0;
+}
+
+bool Connection::is_bulk_load() const { return bulk_load_; }
+
+bool Connection::finish_bulk_load() {
+  if (!db_ || !bulk_load_) {
+    return true;
+  }
+  bulk_load_ = false;
+
+  SchemaMigrator::create_secondary_indexes(db_);
+  SchemaMigrator::mark_current(db_);
+
+  // 恢复默认的安全设置；切回 DELETE 日志模式会完成 WAL 检查点。
+  // locking_mode 改回 NORMAL 后，独占锁在下一次访问数据库时释放。
+  bool ok = execute_sql(db_,
+                        "PRAGMA journal_mode = DELETE;"
+                        "PRAGMA synchronous = FULL;"
+                        "PRAGMA locking_mode = NORMAL;",
+                        "Restore safe pragmas");
+  ok = execute_sql(db_, "ANALYZE;", "Analyze after bulk load") && ok;
+  return ok;
 }
 
 Connection::~Connection() {
+  // [新增] 未经 import 就关闭时也恢复索引与安全设置
+  finish_bulk_load();
   if (db_) {            // MODIFIED
     sqlite3_close(db_); // MODIFIED
   }
@@ -15,8 +15,17 @@ public:
   bool commit_transaction();
   void rollback_transaction();
 
+  // [新增] 首次建库 (days 表不存在或为空) 时进入批量加载模式：
+  // WAL + synchronous=OFF + 大缓存 + 独占锁，二级索引推迟到数据写入之后。
+  bool is_bulk_load() const;
+  // 建立推迟的二级索引，恢复安全的 journal/synchronous 设置并执行 ANALYZE
+  bool finish_bulk_load();
+
 private:
   sqlite3 *db_; // MODIFIED
+  bool bulk_load_ = false;
+
+  bool is_empty_database() const;
 };
 
 bool execute_sql(sqlite3 *db, const std::string &sql,
@@ -0,0 +1,95 @@
+﻿// importer/storage/sqlite/manifest_store.cpp
+#include "importer/storage/sqlite/manifest_store.hpp"
+#include "common/utils/string_utils.hpp"
+#include <stdexcept>
+
+ManifestStore::ManifestStore(sqlite3 *db) : db_(db) {}
+
+SourceManifest ManifestStore::load_all() const {
+  SourceManifest manifest;
+  sqlite3_stmt *stmt = nullptr;
+  const char *sql =
+      "SELECT path, size, mtime, hash, months FROM source_manifest;";
+
+  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      const unsigned char *path = sqlite3_column_text(stmt, 0);
+      if (!path)
+        continue;
+
+      SourceFileRecord record;
+      record.path_ = reinterpret_cast<const char *>(path);
+      record.size_ =
+          static_cast<std::uintmax_t>(sqlite3_column_int64(stmt, 1));
+      record.mtime_ = sqlite3_column_int64(stmt, 2);
+      const unsigned char *hash = sqlite3_column_text(stmt, 3);
+      if (hash)
+        record.hash_ = reinterpret_cast<const char *>(hash);
+      const unsigned char *months = sqlite3_column_text(stmt, 4);
+      if (months && *months)
+        record.months_ =
+            SplitString(reinterpret_cast<const char *>(months), ',');
+
+      manifest[record.path_] = std::move(record);
+    }
+  }
+  sqlite3_finalize(stmt);
+  return manifest;
+}
+
+void ManifestStore::upsert(const std::vector<SourceFileRecord> &records) {
+  if (records.empty())
+    return;
+
+  sqlite3_stmt *stmt = nullptr;
+  const char *sql = "INSERT OR REPLACE INTO source_manifest "
+                    "(path, size, mtime, hash, months) VALUES (?, ?, ?, ?, ?);";
+  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare source_manifest upsert.");
+  }
+
+  for (const auto &record : records) {
+    std::string months;
+    for (size_t i = 0; i < record.months_.size(); ++i) {
+      if (i > 0)
+        months += ',';
+      months += record.months_[i];
+    }
+
+    sqlite3_bind_text(stmt, 1, record.path_.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(record.size_));
+    sqlite3_bind_int64(stmt, 3, record.mtime_);
+    sqlite3_bind_text(stmt, 4, record.hash_.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 5, months.c_str(), -1, SQLITE_TRANSIENT);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      std::string error = sqlite3_errmsg(db_);
+      sqlite3_finalize(stmt);
+      throw std::runtime_error("Failed to update source_manifest: " + error);
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+}
+
+void ManifestStore::remove(const std::vector<std::string> &paths) {
+  if (paths.empty())
+    return;
+
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db_, "DELETE FROM source_manifest WHERE path = ?;",
+                         -1, &stmt, nullptr) != SQLITE_OK) {
+    throw std::runtime_error("Failed to prepare source_manifest delete.");
+  }
+
+  for (const auto &path : paths) {
+    sqlite3_bind_text(stmt, 1, path.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      std::string error = sqlite3_errmsg(db_);
+      sqlite3_finalize(stmt);
+      throw std::runtime_error("Failed to update source_manifest: " + error);
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+}
@@ -0,0 +1,27 @@
+﻿// importer/storage/sqlite/manifest_store.hpp
+#ifndef IMPORTER_STORAGE_SQLITE_MANIFEST_STORE_HPP_
+#define IMPORTER_STORAGE_SQLITE_MANIFEST_STORE_HPP_
+
+#include "core/domain/model/source_manifest.hpp"
+#include <sqlite3.h>
+#include <vector>
+
+/**
+ * @class ManifestStore
+ * @brief 读写 source_manifest 表 (增量摄入的源文件清单)。
+ * @details 表结构由 Connection 负责创建；months 以逗号分隔存储。
+ */
+class ManifestStore {
+public:
+  explicit ManifestStore(sqlite3 *db);
+
+  SourceManifest load_all() const;
+  void upsert(const std::vector<SourceFileRecord> &records);
+  // [新增] 删除已不存在的源文件的清单行
+  void remove(const std::vector<std::string> &paths);
+
+private:
+  sqlite3 *db_;
+};
+
+#endif // IMPORTER_STORAGE_SQLITE_MANIFEST_STORE_HPP_
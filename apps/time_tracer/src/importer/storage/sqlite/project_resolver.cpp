@@ -11,8 +11,11 @@ struct ImportProjectNode {
   std::string name;
   std::unordered_map<std::string, std::unique_ptr<ImportProjectNode>> children;
 };
-ProjectResolver::ProjectResolver(sqlite3 *db, sqlite3_stmt *stmt_insert_project)
-    : db_(db), stmt_insert_project_(stmt_insert_project) {}
+ProjectResolver::ProjectResolver(
+    sqlite3 *db, sqlite3_stmt *stmt_insert_project,
+    core::interfaces::ProjectCreatedCallback on_project_created)
+    : db_(db), stmt_insert_project_(stmt_insert_project),
+      on_project_created_(std::move(on_project_created)) {}
 
 ProjectResolver::~ProjectResolver() = default;
 
@@ -114,6 +117,11 @@ long long ProjectResolver::ensure_path(const std::string &full_path) {
 
       long long new_id = sqlite3_last_insert_rowid(db_);
 
+      // [修改] 通知组合根注入的监听者 (如报表侧的项目名缓存)
+      if (on_project_created_) {
+        on_project_created_(new_id, part_name, current_parent_id);
+      }
+
       // Update memory tree
       auto new_node = std::make_unique<ImportProjectNode>();
       new_node->id = new_id;
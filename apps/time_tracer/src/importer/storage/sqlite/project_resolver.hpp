@@ -2,6 +2,7 @@
 #ifndef IMPORTER_STORAGE_SQLITE_PROJECT_RESOLVER_HPP_
 #define IMPORTER_STORAGE_SQLITE_PROJECT_RESOLVER_HPP_
 
+#include "core/domain/ports/project_created_callback.hpp"
 #include <memory>
 #include <sqlite3.h>
 #include <string>
@@ -12,7 +13,10 @@ struct ImportProjectNode; // Forward declaration
 
 class ProjectResolver {
 public:
-  explicit ProjectResolver(sqlite3 *db, sqlite3_stmt *stmt_insert_project);
+  // [修改] on_project_created: 新建项目节点后的通知 (可为空)
+  ProjectResolver(sqlite3 *db, sqlite3_stmt *stmt_insert_project,
+                  core::interfaces::ProjectCreatedCallback on_project_created =
+                      {});
   ~ProjectResolver();
 
   // Batch preload and resolve
@@ -24,6 +28,7 @@ public:
 private:
   sqlite3 *db_;
   sqlite3_stmt *stmt_insert_project_;
+  core::interfaces::ProjectCreatedCallback on_project_created_;
 
   std::unique_ptr<ImportProjectNode> root_;
   std::unordered_map<std::string, long long> cache_;
@@ -0,0 +1,217 @@
+﻿// importer/storage/sqlite/rollup_store.cpp
+#include "importer/storage/sqlite/rollup_store.hpp"
+#include "common/utils/civil_time.hpp"
+#include "importer/storage/sqlite/connection.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace {
+
+// 预编译语句的简单持有者，析构时 finalize
+class PreparedStatement {
+public:
+  PreparedStatement(sqlite3 *db, const char *sql) : db_(db) {
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt_, nullptr) != SQLITE_OK) {
+      std::string error = sqlite3_errmsg(db);
+      sqlite3_finalize(stmt_);
+      throw std::runtime_error("Failed to prepare rollup statement: " + error);
+    }
+  }
+  ~PreparedStatement() { sqlite3_finalize(stmt_); }
+  PreparedStatement(const PreparedStatement &) = delete;
+  PreparedStatement &operator=(const PreparedStatement &) = delete;
+
+  // 绑定全部文本参数 (?1, ?2, ...) 并执行到结束
+  void run(std::initializer_list<const std::string *> params) {
+    sqlite3_reset(stmt_);
+    int index = 1;
+    for (const std::string *param : params) {
+      sqlite3_bind_text(stmt_, index++, param->c_str(),
+                        static_cast<int>(param->size()), SQLITE_STATIC);
+    }
+    if (sqlite3_step(stmt_) != SQLITE_DONE) {
+      throw std::runtime_error(std::string("Failed to refresh rollups: ") +
+                               sqlite3_errmsg(db_));
+    }
+  }
+
+private:
+  sqlite3 *db_;
+  sqlite3_stmt *stmt_ = nullptr;
+};
+
+// 参数 ?1 = granularity, ?2 = 起始 period, ?3 = 结束 period (闭区间)
+constexpr const char *kDeleteRollups =
+    "DELETE FROM project_rollups "
+    "WHERE granularity = ?1 AND period >= ?2 AND period <= ?3;";
+constexpr const char *kDeleteActiveDays =
+    "DELETE FROM period_active_days "
+    "WHERE granularity = ?1 AND period >= ?2 AND period <= ?3;";
+
+// 日：?1 起始天数, ?2 结束天数。period 仍为 "YYYY-MM-DD" 文本
+constexpr const char *kInsertDayRollups =
+    "INSERT INTO project_rollups (granularity, period, project_id, duration) "
+    "SELECT 'day', date(2440587.5 + date), project_id, SUM(duration) "
+    "FROM time_records "
+    "WHERE date >= ?1 AND date <= ?2 GROUP BY date, project_id;";
+
+// 月：?1 granularity, ?2 period, ?3 起始日期, ?4 结束日期，由日汇总
+constexpr const char *kInsertActiveDaysFromDays =
+    "INSERT INTO period_active_days (granularity, period, active_days) "
+    "SELECT ?1, ?2, COUNT(DISTINCT period) FROM project_rollups "
+    "WHERE granularity = 'day' AND period >= ?3 AND period <= ?4 "
+    "HAVING COUNT(*) > 0;";
+
+// 前缀和：?1 起始天数, ?2 起始日期。基数取起始日之前最近的累计值
+constexpr const char *kDeleteProjectPrefix =
+    "DELETE FROM project_prefix_sums WHERE day_number >= ?1;";
+constexpr const char *kInsertProjectPrefix =
+    "INSERT INTO project_prefix_sums (project_id, day_number, cumulative) "
+    "SELECT d.project_id, d.day_number, "
+    "  COALESCE((SELECT p.cumulative FROM project_prefix_sums p "
+    "            WHERE p.project_id = d.project_id AND p.day_number < ?1 "
+    "            ORDER BY p.day_number DESC LIMIT 1), 0) "
+    "  + SUM(d.duration) OVER (PARTITION BY d.project_id "
+    "                          ORDER BY d.day_number) "
+    "FROM (SELECT project_id, "
+    "        CAST(julianday(period) - 2440587.5 AS INTEGER) AS day_number, "
+    "        SUM(duration) AS duration "
+    "      FROM project_rollups "
+    "      WHERE granularity = 'day' AND period >= ?2 "
+    "        AND julianday(period) IS NOT NULL "
+    "      GROUP BY 1, 2) d;";
+constexpr const char *kDeleteActivePrefix =
+    "DELETE FROM active_day_prefix WHERE day_number >= ?1;";
+constexpr const char *kInsertActivePrefix =
+    "INSERT INTO active_day_prefix (day_number, cumulative_days) "
+    "SELECT d.day_number, "
+    "  COALESCE((SELECT cumulative_days FROM active_day_prefix "
+    "            WHERE day_number < ?1 "
+    "            ORDER BY day_number DESC LIMIT 1), 0) "
+    "  + ROW_NUMBER() OVER (ORDER BY d.day_number) "
+    "FROM (SELECT DISTINCT "
+    "        CAST(julianday(period) - 2440587.5 AS INTEGER) AS day_number "
+    "      FROM project_rollups "
+    "      WHERE granularity = 'day' AND period >= ?2 "
+    "        AND julianday(period) IS NOT NULL) d;";
+
+} // namespace
+
+RollupStore::RollupStore(sqlite3 *db) : db_(db) {}
+
+bool RollupStore::create_tables(sqlite3 *db) {
+  bool ok = execute_sql(db,
+                        "CREATE TABLE IF NOT EXISTS project_rollups ("
+                        "granularity TEXT NOT NULL, "
+                        "period TEXT NOT NULL, "
+                        "project_id INTEGER NOT NULL, "
+                        "duration INTEGER NOT NULL, "
+                        "PRIMARY KEY (granularity, period, project_id)) "
+                        "WITHOUT ROWID;",
+                        "Create project_rollups table");
+  ok = execute_sql(db,
+                   "CREATE TABLE IF NOT EXISTS period_active_days ("
+                   "granularity TEXT NOT NULL, "
+                   "period TEXT NOT NULL, "
+                   "active_days INTEGER NOT NULL, "
+                   "PRIMARY KEY (granularity, period)) WITHOUT ROWID;",
+                   "Create period_active_days table") &&
+       ok;
+  ok = execute_sql(db,
+                   "CREATE TABLE IF NOT EXISTS project_prefix_sums ("
+                   "project_id INTEGER NOT NULL, "
+                   "day_number INTEGER NOT NULL, "
+                   "cumulative INTEGER NOT NULL, "
+                   "PRIMARY KEY (project_id, day_number)) WITHOUT ROWID;",
+                   "Create project_prefix_sums table") &&
+       ok;
+  ok = execute_sql(db,
+                   "CREATE TABLE IF NOT EXISTS active_day_prefix ("
+                   "day_number INTEGER PRIMARY KEY, "
+                   "cumulative_days INTEGER NOT NULL);",
+                   "Create active_day_prefix table") &&
+       ok;
+  return ok;
+}
+
+void RollupStore::refresh_months(const std::vector<std::string> &months) {
+  if (months.empty())
+    return;
+
+  PreparedStatement delete_rollups(db_, kDeleteRollups);
+  PreparedStatement delete_active(db_, kDeleteActiveDays);
+  PreparedStatement insert_days(db_, kInsertDayRollups);
+  PreparedStatement insert_active(db_, kInsertActiveDaysFromDays);
+
+  const std::string day = "day";
+  const std::string month = "month";
+
+  // 1. 日与月：先删后由 time_records 重算
+  for (const std::string &ym : months) {
+    TimeUtils::CivilDate first;
+    if (!TimeUtils::ParseCivilDate(ym + "-01", first))
+      continue;
+
+    const long long first_day = TimeUtils::DaysFromCivil(first.year_,
+                                                         first.month_, 1);
+    const int next_year = first.month_ == 12 ? first.year_ + 1 : first.year_;
+    const int next_month = first.month_ == 12 ? 1 : first.month_ + 1;
+    const long long last_day =
+        TimeUtils::DaysFromCivil(next_year, next_month, 1) - 1;
+
+    const std::string start = ym + "-01";
+    const std::string end = ym + "-31";
+    const std::string first_number = std::to_string(first_day);
+    const std::string last_number = std::to_string(last_day);
+    delete_rollups.run({&day, &start, &end});
+    delete_active.run({&month, &ym, &ym});
+
+    insert_days.run({&first_number, &last_number});
+    insert_active.run({&month, &ym, &start, &end});
+  }
+
+  // 2. 前缀和：从最早变动的月份起重算后缀
+  refresh_prefix_sums(*std::min_element(months.begin(), months.end()) +
+                      "-01");
+}
+
+void RollupStore::refresh_prefix_sums(const std::string &from_date) {
+  TimeUtils::CivilDate date;
+  if (!TimeUtils::ParseCivilDate(from_date, date))
+    return;
+  const std::string from_day = std::to_string(
+      TimeUtils::DaysFromCivil(date.year_, date.month_, date.day_));
+
+  PreparedStatement(db_, kDeleteProjectPrefix).run({&from_day});
+  PreparedStatement(db_, kInsertProjectPrefix).run({&from_day, &from_date});
+  PreparedStatement(db_, kDeleteActivePrefix).run({&from_day});
+  PreparedStatement(db_, kInsertActivePrefix).run({&from_day, &from_date});
+}
+
+void RollupStore::rebuild_all() {
+  execute_sql(db_, "DELETE FROM project_rollups;", "Clear project_rollups");
+  execute_sql(db_, "DELETE FROM period_active_days;",
+              "Clear period_active_days");
+  execute_sql(db_, "DELETE FROM project_prefix_sums;",
+              "Clear project_prefix_sums");
+  execute_sql(db_, "DELETE FROM active_day_prefix;",
+              "Clear active_day_prefix");
+
+  std::vector<std::string> months;
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db_,
+                         "SELECT DISTINCT strftime('%Y-%m', 2440587.5 + date) "
+                         "FROM time_records WHERE typeof(date) = 'integer' "
+                         "ORDER BY 1;",
+                         -1, &stmt, nullptr) == SQLITE_OK) {
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      const unsigned char *ym = sqlite3_column_text(stmt, 0);
+      if (ym)
+        months.emplace_back(reinterpret_cast<const char *>(ym));
+    }
+  }
+  sqlite3_finalize(stmt);
+
+  refresh_months(months);
+}
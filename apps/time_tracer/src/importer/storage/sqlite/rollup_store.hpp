@@ -0,0 +1,52 @@
+﻿// importer/storage/sqlite/rollup_store.hpp
+#ifndef IMPORTER_STORAGE_SQLITE_ROLLUP_STORE_HPP_
+#define IMPORTER_STORAGE_SQLITE_ROLLUP_STORE_HPP_
+
+#include <sqlite3.h>
+#include <string>
+#include <vector>
+
+/**
+ * @class RollupStore
+ * @brief 维护按周期预聚合的项目时长表，供报表直接读取。
+ * @details
+ * - project_rollups(granularity, period, project_id, duration)
+ * - period_active_days(granularity, period, active_days)
+ *
+ * [修改] project_rollups 只维护 "day" 粒度 (period 为 "YYYY-MM-DD")，
+ * 周 / 月 / 年等周期报表由 PeriodRollupEngine 顺序读取日汇总得到；
+ * period_active_days 只维护 "month" 粒度 (period 为 "YYYY-MM")，
+ * 供按月流式导出列举月份。
+ * 导入按整月替换数据，因此以月为单位刷新：日由 time_records 重算，
+ * 月再由日汇总得到，不扫描整张 time_records。
+ *
+ * [新增] 前缀和索引 (day_number 为 1970-01-01 起的天数)：
+ * - project_prefix_sums(project_id, day_number, cumulative)
+ *   该项目截至当天 (含) 的累计时长，只在有记录的日期落行
+ * - active_day_prefix(day_number, cumulative_days)
+ *   截至当天 (含) 的累计活跃天数
+ * 任意区间 [a, b] 的合计 = 累计(<= b) - 累计(< a)，每个项目两次索引查找。
+ * 刷新时只重算最早变动日期之后的后缀，追加新月份只写入新行。
+ */
+class RollupStore {
+public:
+  explicit RollupStore(sqlite3 *db);
+
+  // 建表 (幂等)；Connection 建库与 SchemaMigrator 升级时调用
+  static bool create_tables(sqlite3 *db);
+
+  // 重新计算给定月份 ("YYYY-MM") 的日汇总与月活跃天数。
+  // 须在导入事务内、days / time_records 写入完成后调用
+  void refresh_months(const std::vector<std::string> &months);
+
+  // [新增] 重算 from_date ("YYYY-MM-DD") 及之后的前缀和 (依赖日汇总)
+  void refresh_prefix_sums(const std::string &from_date);
+
+  // 按 time_records 中出现的所有月份全量重建 (模式迁移时使用)
+  void rebuild_all();
+
+private:
+  sqlite3 *db_;
+};
+
+#endif // IMPORTER_STORAGE_SQLITE_ROLLUP_STORE_HPP_
@@ -1,10 +1,60 @@
 ﻿// importer/storage/sqlite/statement.cpp
 #include "importer/storage/sqlite/statement.hpp"
+#include <algorithm>
 #include <stdexcept>
 
-Statement::Statement(sqlite3 *db)
+namespace {
+
+// days 的列 (顺序即绑定顺序)
+constexpr const char *kInsertDayPrefix =
+    "INSERT INTO days ("
+    // [1-7] 基础信息
+    "date, year, month, status, sleep, remark, getup_time, "
+    // [8-11] 运动相关
+    "exercise, total_exercise_time, cardio_time, anaerobic_time, "
+    // [12-14] 生活琐事
+    "gaming_time, grooming_time, toilet_time, "
+    // [15-17] 睡眠统计
+    "sleep_night_time, sleep_day_time, sleep_total_time, "
+    // [18-21] 娱乐统计
+    "recreation_time, recreation_zhihu_time, recreation_bilibili_time, "
+    "recreation_douyin_time, "
+    // [22] 学习统计
+    "study_time"
+    ") VALUES ";
+
+constexpr const char *kInsertRecordPrefix =
+    "INSERT OR REPLACE INTO time_records "
+    "(logical_id, start_timestamp, end_timestamp, date, start, end, "
+    "project_id, duration, activity_remark) VALUES ";
+
+// 生成 "(?, ..., ?),(?, ..., ?)..." 共 rows 组，每组 columns 个占位符
+std::string build_insert_sql(const char *prefix, size_t rows, int columns) {
+  std::string tuple = "(";
+  for (int i = 0; i < columns; ++i) {
+    tuple += (i == 0) ? "?" : ", ?";
+  }
+  tuple += ")";
+
+  std::string sql = prefix;
+  sql.reserve(sql.size() + rows * (tuple.size() + 1) + 1);
+  for (size_t row = 0; row < rows; ++row) {
+    if (row > 0)
+      sql += ",";
+    sql += tuple;
+  }
+  sql += ";";
+  return sql;
+}
+
+} // namespace
+
+Statement::Statement(sqlite3 *db, size_t batch_rows)
     : db_(db), stmt_insert_day_(nullptr), stmt_insert_record_(nullptr),
-      stmt_select_project_id_(nullptr), stmt_insert_project_(nullptr) {
+      stmt_select_project_id_(nullptr), stmt_insert_project_(nullptr),
+      stmt_insert_day_batch_(nullptr), stmt_insert_record_batch_(nullptr),
+      day_batch_rows_(_resolve_batch_rows(batch_rows, kDayColumns)),
+      record_batch_rows_(_resolve_batch_rows(batch_rows, kRecordColumns)) {
   _prepare_statements();
 }
 
@@ -22,47 +72,55 @@ sqlite3_stmt *Statement::get_select_project_id_stmt() const {
 sqlite3_stmt *Statement::get_insert_project_stmt() const {
   return stmt_insert_project_;
 }
+sqlite3_stmt *Statement::get_insert_day_batch_stmt() const {
+  return stmt_insert_day_batch_;
+}
+sqlite3_stmt *Statement::get_insert_record_batch_stmt() const {
+  return stmt_insert_record_batch_;
+}
+size_t Statement::get_day_batch_rows() const { return day_batch_rows_; }
+size_t Statement::get_record_batch_rows() const { return record_batch_rows_; }
+
+size_t Statement::_resolve_batch_rows(size_t requested, int columns) const {
+  // 单条语句的占位符总数不能超过 SQLITE_LIMIT_VARIABLE_NUMBER
+  int max_vars = sqlite3_limit(db_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+  size_t max_rows = max_vars > 0 ? static_cast<size_t>(max_vars) / columns : 1;
+  return std::max<size_t>(1, std::min(requested, max_rows));
+}
 
 void Statement::_prepare_statements() {
-  const char *insert_day_sql =
-      "INSERT INTO days ("
-      // [1-7] 基础信息
-      "date, year, month, status, sleep, remark, getup_time, "
-      // [8-11] 运动相关
-      "exercise, total_exercise_time, cardio_time, anaerobic_time, "
-      // [12-14] 生活琐事
-      "gaming_time, grooming_time, toilet_time, "
-      // [15-17] 睡眠统计
-      "sleep_night_time, sleep_day_time, sleep_total_time, "
-      // [18-21] 娱乐统计
-      "recreation_time, recreation_zhihu_time, recreation_bilibili_time, "
-      "recreation_douyin_time, "
-      // [22] 学习统计
-      "study_time"
-      ") "
-      "VALUES ("
-      "?, ?, ?, ?, ?, ?, ?, " // 1-7
-      "?, ?, ?, ?, "          // 8-11
-      "?, ?, ?, "             // 12-14
-      "?, ?, ?, "             // 15-17
-      "?, ?, ?, ?, "          // 18-21
-      "?"                     // 22: study_time
-      ");";
-  if (sqlite3_prepare_v2(db_, insert_day_sql, -1, &stmt_insert_day_, nullptr) !=
-      SQLITE_OK) {
+  const std::string insert_day_sql =
+      build_insert_sql(kInsertDayPrefix, 1, kDayColumns);
+  if (sqlite3_prepare_v2(db_, insert_day_sql.c_str(), -1, &stmt_insert_day_,
+                         nullptr) != SQLITE_OK) {
     throw std::runtime_error("Failed to prepare day insert statement.");
   }
 
-  const char *insert_record_sql =
-      "INSERT OR REPLACE INTO time_records "
-      "(logical_id, start_timestamp, end_timestamp, date, start, end, "
-      "project_id, duration, activity_remark) "
-      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);";
-  if (sqlite3_prepare_v2(db_, insert_record_sql, -1, &stmt_insert_record_,
-                         nullptr) != SQLITE_OK) {
+  const std::string insert_record_sql =
+      build_insert_sql(kInsertRecordPrefix, 1, kRecordColumns);
+  if (sqlite3_prepare_v2(db_, insert_record_sql.c_str(), -1,
+                         &stmt_insert_record_, nullptr) != SQLITE_OK) {
     throw std::runtime_error("Failed to prepare time record insert statement.");
   }
 
+  // [新增] 多行批量插入语句
+  if (day_batch_rows_ > 1) {
+    const std::string sql =
+        build_insert_sql(kInsertDayPrefix, day_batch_rows_, kDayColumns);
+    if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt_insert_day_batch_,
+                           nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare batched day insert.");
+    }
+  }
+  if (record_batch_rows_ > 1) {
+    const std::string sql = build_insert_sql(
+        kInsertRecordPrefix, record_batch_rows_, kRecordColumns);
+    if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt_insert_record_batch_,
+                           nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare batched record insert.");
+    }
+  }
+
   const char *select_project_id_sql =
       "SELECT id FROM projects WHERE name = ? AND parent_id IS ?";
   if (sqlite3_prepare_v2(db_, select_project_id_sql, -1,
@@ -87,4 +145,8 @@ void Statement::_finalize_statements() {
     sqlite3_finalize(stmt_select_project_id_);
   if (stmt_insert_project_)
     sqlite3_finalize(stmt_insert_project_);
+  if (stmt_insert_day_batch_)
+    sqlite3_finalize(stmt_insert_day_batch_);
+  if (stmt_insert_record_batch_)
+    sqlite3_finalize(stmt_insert_record_batch_);
 }
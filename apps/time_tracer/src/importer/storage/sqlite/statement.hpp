@@ -2,16 +2,30 @@
 #ifndef IMPORTER_STORAGE_SQLITE_STATEMENT_HPP_
 #define IMPORTER_STORAGE_SQLITE_STATEMENT_HPP_
 
+#include <cstddef>
 #include <sqlite3.h>
+#include <string>
 
 class Statement {
 public:
-  explicit Statement(sqlite3 *db);
+  // [新增] 多行 INSERT 默认每条语句的行数
+  static constexpr size_t kDefaultBatchRows = 64;
+  static constexpr int kDayColumns = 22;
+  static constexpr int kRecordColumns = 9;
+
+  // [修改] batch_rows 可调；实际行数还受 SQLITE_LIMIT_VARIABLE_NUMBER 约束
+  explicit Statement(sqlite3 *db, size_t batch_rows = kDefaultBatchRows);
   ~Statement();
 
   sqlite3_stmt *get_insert_day_stmt() const;
   sqlite3_stmt *get_insert_record_stmt() const;
 
+  // [新增] 多行 INSERT ... VALUES (...),(...)；行数 <= 1 时为 nullptr
+  sqlite3_stmt *get_insert_day_batch_stmt() const;
+  sqlite3_stmt *get_insert_record_batch_stmt() const;
+  size_t get_day_batch_rows() const;
+  size_t get_record_batch_rows() const;
+
   // --- [FIX] Added missing function declarations and removed the old one ---
   sqlite3_stmt *get_select_project_id_stmt() const;
   sqlite3_stmt *get_insert_project_stmt() const;
@@ -24,6 +38,12 @@ private:
   sqlite3_stmt *stmt_select_project_id_;
   sqlite3_stmt *stmt_insert_project_;
 
+  sqlite3_stmt *stmt_insert_day_batch_;
+  sqlite3_stmt *stmt_insert_record_batch_;
+  size_t day_batch_rows_;
+  size_t record_batch_rows_;
+
+  size_t _resolve_batch_rows(size_t requested, int columns) const;
   void _prepare_statements();
   void _finalize_statements();
 };
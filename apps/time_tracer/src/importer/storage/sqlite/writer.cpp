@@ -1,102 +1,278 @@
 ﻿// importer/storage/sqlite/writer.cpp
 #include "importer/storage/sqlite/writer.hpp"
-#include <iostream>
+#include "common/utils/civil_time.hpp"
+#include <stdexcept>
+#include <string>
 
-Writer::Writer(sqlite3 *db, sqlite3_stmt *stmt_day, sqlite3_stmt *stmt_record,
+namespace {
+
+// [新增] 文本按 SQLITE_STATIC 绑定：数据由调用方的 vector 持有，
+// 在 sqlite3_step 完成前不会失效，省去 SQLITE_TRANSIENT 的逐列拷贝。
+void bind_text_static(sqlite3_stmt *stmt, int index, const std::string &text) {
+  sqlite3_bind_text(stmt, index, text.c_str(), static_cast<int>(text.size()),
+                    SQLITE_STATIC);
+}
+
+// [新增] date 列存 1970-01-01 起的天数。无法换算的行不写入，直接记为失败：
+// time_records.date 仅有 INTEGER 亲和性，文本会被原样存下，
+// 之后按整数区间的读取与整月删除都无法触及该行
+struct DatedRow {
+  size_t index;
+  long long day_number;
+};
+
+template <typename DateOf, typename RowKey>
+std::vector<DatedRow> resolve_dates(size_t row_count, const char *table,
+                                    DateOf date_of, RowKey row_key,
+                                    std::vector<RowFailure> &failures) {
+  std::vector<DatedRow> rows;
+  rows.reserve(row_count);
+  for (size_t i = 0; i < row_count; ++i) {
+    const std::string &date = date_of(i);
+    long long day_number = 0;
+    if (TimeUtils::ParseDayNumber(date, day_number)) {
+      rows.push_back({i, day_number});
+    } else {
+      failures.push_back({table, row_key(i), "Invalid date: " + date});
+    }
+  }
+  return rows;
+}
+
+// [新增] start / end 列存当日分钟数，非法时刻写 NULL
+void bind_clock(sqlite3_stmt *stmt, int index, const std::string &clock) {
+  const int minutes = TimeUtils::ParseClockMinutes(clock);
+  if (minutes >= 0) {
+    sqlite3_bind_int(stmt, index, minutes);
+  } else {
+    sqlite3_bind_null(stmt, index);
+  }
+}
+
+// base 为该行第一个参数的序号 (从 1 开始)
+void bind_day(sqlite3_stmt *stmt, int base, const DayData &day_data,
+              long long day_number) {
+  sqlite3_bind_int64(stmt, base + 0, day_number);
+  sqlite3_bind_int(stmt, base + 1, day_data.year_);
+  sqlite3_bind_int(stmt, base + 2, day_data.month_);
+  sqlite3_bind_int(stmt, base + 3, day_data.status_);
+  sqlite3_bind_int(stmt, base + 4, day_data.sleep_);
+  bind_text_static(stmt, base + 5, day_data.remark_);
+
+  if (day_data.getup_time_ == "Null" || day_data.getup_time_.empty()) {
+    sqlite3_bind_null(stmt, base + 6);
+  } else {
+    bind_text_static(stmt, base + 6, day_data.getup_time_);
+  }
+
+  const auto &stats = day_data.stats_;
+  sqlite3_bind_int(stmt, base + 7, day_data.exercise_);
+  sqlite3_bind_int(stmt, base + 8, stats.total_exercise_time_);
+  sqlite3_bind_int(stmt, base + 9, stats.cardio_time_);
+  sqlite3_bind_int(stmt, base + 10, stats.anaerobic_time_);
+  sqlite3_bind_int(stmt, base + 11, stats.gaming_time_);
+  sqlite3_bind_int(stmt, base + 12, stats.grooming_time_);
+  sqlite3_bind_int(stmt, base + 13, stats.toilet_time_);
+  sqlite3_bind_int(stmt, base + 14, stats.sleep_night_time_);
+  sqlite3_bind_int(stmt, base + 15, stats.sleep_day_time_);
+  sqlite3_bind_int(stmt, base + 16, stats.sleep_total_time_);
+  sqlite3_bind_int(stmt, base + 17, stats.recreation_time_);
+  sqlite3_bind_int(stmt, base + 18, stats.recreation_zhihu_time_);
+  sqlite3_bind_int(stmt, base + 19, stats.recreation_bilibili_time_);
+  sqlite3_bind_int(stmt, base + 20, stats.recreation_douyin_time_);
+  sqlite3_bind_int(stmt, base + 21, stats.study_time_);
+}
+
+void bind_record(sqlite3_stmt *stmt, int base,
+                 const TimeRecordInternal &record_data, long long day_number,
+                 long long project_id) {
+  sqlite3_bind_int64(stmt, base + 0, record_data.logical_id_);
+  sqlite3_bind_int64(stmt, base + 1, record_data.start_timestamp_);
+  sqlite3_bind_int64(stmt, base + 2, record_data.end_timestamp_);
+  sqlite3_bind_int64(stmt, base + 3, day_number);
+  bind_clock(stmt, base + 4, record_data.start_time_str_);
+  bind_clock(stmt, base + 5, record_data.end_time_str_);
+  sqlite3_bind_int64(stmt, base + 6, project_id);
+  sqlite3_bind_int(stmt, base + 7, record_data.duration_seconds_);
+
+  if (record_data.remark_.has_value()) {
+    bind_text_static(stmt, base + 8, *record_data.remark_);
+  } else {
+    sqlite3_bind_null(stmt, base + 8);
+  }
+}
+
+// [新增] 通用批量写入：整批绑定到多行语句一次 step；
+// 整批失败时 (语句级回滚) 改用单行语句逐行重试，定位具体失败行。
+template <typename BindRow, typename RowKey>
+size_t write_batched(sqlite3 *db, size_t row_count, sqlite3_stmt *single_stmt,
+                     sqlite3_stmt *batch_stmt, size_t batch_rows, int columns,
+                     const char *table, BindRow bind_row, RowKey row_key,
+                     std::vector<RowFailure> &failures) {
+  size_t written = 0;
+
+  auto write_single = [&](size_t index) {
+    bind_row(single_stmt, 1, index);
+    if (sqlite3_step(single_stmt) == SQLITE_DONE) {
+      ++written;
+    } else {
+      failures.push_back({table, row_key(index), sqlite3_errmsg(db)});
+    }
+    sqlite3_reset(single_stmt);
+  };
+
+  size_t index = 0;
+  if (batch_stmt != nullptr && batch_rows > 1) {
+    for (; index + batch_rows <= row_count; index += batch_rows) {
+      for (size_t offset = 0; offset < batch_rows; ++offset) {
+        bind_row(batch_stmt, 1 + static_cast<int>(offset) * columns,
+                 index + offset);
+      }
+      int rc = sqlite3_step(batch_stmt);
+      sqlite3_reset(batch_stmt);
+      if (rc == SQLITE_DONE) {
+        written += batch_rows;
+        continue;
+      }
+      for (size_t offset = 0; offset < batch_rows; ++offset) {
+        write_single(index + offset);
+      }
+    }
+  }
+
+  // 不足一批的尾部逐行写入
+  for (; index < row_count; ++index) {
+    write_single(index);
+  }
+  return written;
+}
+
+} // namespace
+
+Writer::Writer(sqlite3 *db, const Statement &statements,
                std::unique_ptr<ProjectResolver> project_resolver)
-    : db_(db), stmt_insert_day_(stmt_day), stmt_insert_record_(stmt_record),
+    : db_(db), statements_(statements),
       project_resolver_(std::move(project_resolver)) {
   // [修改] 不再在此处创建 ProjectResolver，而是通过构造函数注入
 }
 
 Writer::~Writer() = default;
 
-void Writer::insert_days(const std::vector<DayData> &days) {
-  for (const auto &day_data : days) {
-    sqlite3_bind_text(stmt_insert_day_, 1, day_data.date_.c_str(), -1,
-                      SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt_insert_day_, 2, day_data.year_);
-    sqlite3_bind_int(stmt_insert_day_, 3, day_data.month_);
-    sqlite3_bind_int(stmt_insert_day_, 4, day_data.status_);
-    sqlite3_bind_int(stmt_insert_day_, 5, day_data.sleep_);
-    sqlite3_bind_text(stmt_insert_day_, 6, day_data.remark_.c_str(), -1,
-                      SQLITE_TRANSIENT);
-
-    if (day_data.getup_time_ == "Null" || day_data.getup_time_.empty()) {
-      sqlite3_bind_null(stmt_insert_day_, 7);
-    } else {
-      sqlite3_bind_text(stmt_insert_day_, 7, day_data.getup_time_.c_str(), -1,
-                        SQLITE_TRANSIENT);
-    }
+void Writer::delete_months(const std::vector<std::string> &months) {
+  if (months.empty())
+    return;
+
+  // 先删子表 time_records，再删 days (外键方向)
+  // [修改] 以 date 天数区间过滤，可命中 date 前导的索引
+  const char *sqls[] = {
+      "DELETE FROM time_records WHERE date >= ?1 AND date <= ?2;",
+      "DELETE FROM days WHERE date >= ?1 AND date <= ?2;"};
 
-    sqlite3_bind_int(stmt_insert_day_, 8, day_data.exercise_);
-    sqlite3_bind_int(stmt_insert_day_, 9, day_data.stats_.total_exercise_time_);
-    sqlite3_bind_int(stmt_insert_day_, 10, day_data.stats_.cardio_time_);
-    sqlite3_bind_int(stmt_insert_day_, 11, day_data.stats_.anaerobic_time_);
-    sqlite3_bind_int(stmt_insert_day_, 12, day_data.stats_.gaming_time_);
-    sqlite3_bind_int(stmt_insert_day_, 13, day_data.stats_.grooming_time_);
-    sqlite3_bind_int(stmt_insert_day_, 14, day_data.stats_.toilet_time_);
-    sqlite3_bind_int(stmt_insert_day_, 15, day_data.stats_.sleep_night_time_);
-    sqlite3_bind_int(stmt_insert_day_, 16, day_data.stats_.sleep_day_time_);
-    sqlite3_bind_int(stmt_insert_day_, 17, day_data.stats_.sleep_total_time_);
-    sqlite3_bind_int(stmt_insert_day_, 18, day_data.stats_.recreation_time_);
-    sqlite3_bind_int(stmt_insert_day_, 19,
-                     day_data.stats_.recreation_zhihu_time_);
-    sqlite3_bind_int(stmt_insert_day_, 20,
-                     day_data.stats_.recreation_bilibili_time_);
-    sqlite3_bind_int(stmt_insert_day_, 21,
-                     day_data.stats_.recreation_douyin_time_);
-    sqlite3_bind_int(stmt_insert_day_, 22, day_data.stats_.study_time_);
-
-    if (sqlite3_step(stmt_insert_day_) != SQLITE_DONE) {
-      std::cerr << "Error inserting day row: " << sqlite3_errmsg(db_)
-                << std::endl;
+  for (const char *sql : sqls) {
+    sqlite3_stmt *stmt = nullptr;
+    if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare month delete statement.");
     }
-    sqlite3_reset(stmt_insert_day_);
+    for (const auto &month : months) {
+      TimeUtils::CivilDate first;
+      if (!TimeUtils::ParseCivilDate(month + "-01", first))
+        continue;
+      const int next_year = first.month_ == 12 ? first.year_ + 1 : first.year_;
+      const int next_month = first.month_ == 12 ? 1 : first.month_ + 1;
+      sqlite3_bind_int64(
+          stmt, 1, TimeUtils::DaysFromCivil(first.year_, first.month_, 1));
+      sqlite3_bind_int64(
+          stmt, 2, TimeUtils::DaysFromCivil(next_year, next_month, 1) - 1);
+      if (sqlite3_step(stmt) != SQLITE_DONE) {
+        std::string error = sqlite3_errmsg(db_);
+        sqlite3_finalize(stmt);
+        throw std::runtime_error("Failed to delete month " + month + ": " +
+                                 error);
+      }
+      sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
   }
 }
 
-void Writer::insert_records(const std::vector<TimeRecordInternal> &records) {
+size_t Writer::insert_days(const std::vector<DayData> &days,
+                           std::vector<RowFailure> &failures) {
+  auto day_key = [&](size_t index) { return days[index].date_; };
+  const std::vector<DatedRow> rows = resolve_dates(
+      days.size(), "days", day_key, day_key, failures);
+
+  return write_batched(
+      db_, rows.size(), statements_.get_insert_day_stmt(),
+      statements_.get_insert_day_batch_stmt(),
+      statements_.get_day_batch_rows(), Statement::kDayColumns, "days",
+      [&](sqlite3_stmt *stmt, int base, size_t index) {
+        bind_day(stmt, base, days[rows[index].index], rows[index].day_number);
+      },
+      [&](size_t index) { return day_key(rows[index].index); }, failures);
+}
+
+size_t Writer::insert_records(const std::vector<TimeRecordInternal> &records,
+                              std::vector<RowFailure> &failures) {
   if (records.empty())
-    return;
+    return 0;
 
+  // [修改] 按转换器驻留的路径 ID 去重：每个唯一路径只解析一次，
+  // 逐条插入时以数组下标取 project_id，避免重复的字符串哈希。
+  // ID 只在单个字典内唯一；同一 ID 对应不同路径时 (记录来自不同的字典)
+  // 整批改为按路径字符串解析，结果仍然正确。
+  std::vector<const std::string *> interned_paths;
   std::vector<std::string> paths;
-  paths.reserve(records.size());
+  bool ids_consistent = true;
   for (const auto &record : records) {
-    paths.push_back(record.project_path_);
+    int path_id = record.project_path_id_;
+    if (path_id <= 0) {
+      paths.push_back(record.project_path_);
+      continue;
+    }
+    if (static_cast<size_t>(path_id) >= interned_paths.size()) {
+      interned_paths.resize(path_id + 1, nullptr);
+    }
+    if (interned_paths[path_id] == nullptr) {
+      interned_paths[path_id] = &record.project_path_;
+      paths.push_back(record.project_path_);
+    } else if (*interned_paths[path_id] != record.project_path_) {
+      ids_consistent = false;
+      paths.push_back(record.project_path_);
+    }
   }
 
   project_resolver_->preload_and_resolve(paths);
 
-  for (const auto &record_data : records) {
-    long long project_id = project_resolver_->get_id(record_data.project_path_);
-
-    sqlite3_bind_int64(stmt_insert_record_, 1, record_data.logical_id_);
-    sqlite3_bind_int64(stmt_insert_record_, 2, record_data.start_timestamp_);
-    sqlite3_bind_int64(stmt_insert_record_, 3, record_data.end_timestamp_);
-    sqlite3_bind_text(stmt_insert_record_, 4, record_data.date_.c_str(), -1,
-                      SQLITE_TRANSIENT);
-
-    sqlite3_bind_text(stmt_insert_record_, 5,
-                      record_data.start_time_str_.c_str(), -1,
-                      SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt_insert_record_, 6, record_data.end_time_str_.c_str(),
-                      -1, SQLITE_TRANSIENT);
+  std::vector<long long> project_ids(interned_paths.size(), 0);
+  for (size_t i = 0; i < interned_paths.size(); ++i) {
+    if (interned_paths[i] != nullptr) {
+      project_ids[i] = project_resolver_->get_id(*interned_paths[i]);
+    }
+  }
 
-    sqlite3_bind_int64(stmt_insert_record_, 7, project_id);
-    sqlite3_bind_int(stmt_insert_record_, 8, record_data.duration_seconds_);
+  auto project_id_of = [&](const TimeRecordInternal &record_data) {
+    return ids_consistent && record_data.project_path_id_ > 0
+               ? project_ids[record_data.project_path_id_]
+               : project_resolver_->get_id(record_data.project_path_);
+  };
 
-    if (record_data.remark_.has_value()) {
-      sqlite3_bind_text(stmt_insert_record_, 9, record_data.remark_->c_str(),
-                        -1, SQLITE_TRANSIENT);
-    } else {
-      sqlite3_bind_null(stmt_insert_record_, 9);
-    }
+  auto record_key = [&](size_t index) {
+    return std::to_string(records[index].logical_id_);
+  };
+  const std::vector<DatedRow> rows = resolve_dates(
+      records.size(), "time_records",
+      [&](size_t index) -> const std::string & { return records[index].date_; },
+      record_key, failures);
 
-    if (sqlite3_step(stmt_insert_record_) != SQLITE_DONE) {
-      std::cerr << "Error inserting record row: " << sqlite3_errmsg(db_)
-                << std::endl;
-    }
-    sqlite3_reset(stmt_insert_record_);
-  }
+  return write_batched(
+      db_, rows.size(), statements_.get_insert_record_stmt(),
+      statements_.get_insert_record_batch_stmt(),
+      statements_.get_record_batch_rows(), Statement::kRecordColumns,
+      "time_records",
+      [&](sqlite3_stmt *stmt, int base, size_t index) {
+        const TimeRecordInternal &record_data = records[rows[index].index];
+        bind_record(stmt, base, record_data, rows[index].day_number,
+                    project_id_of(record_data));
+      },
+      [&](size_t index) { return record_key(rows[index].index); }, failures);
 }
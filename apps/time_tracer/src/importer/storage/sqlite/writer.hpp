@@ -2,28 +2,36 @@
 #ifndef IMPORTER_STORAGE_SQLITE_WRITER_HPP_
 #define IMPORTER_STORAGE_SQLITE_WRITER_HPP_
 
+#include "importer/model/import_stats.hpp"
 #include "importer/model/time_sheet_data.hpp"
 #include "importer/storage/sqlite/project_resolver.hpp"
+#include "importer/storage/sqlite/statement.hpp"
 #include <memory>
 #include <sqlite3.h>
 #include <vector>
 
 class Writer {
 public:
-  // [修改] 注入 ProjectResolver，移除 stmt_insert_project
-  explicit Writer(sqlite3 *db, sqlite3_stmt *stmt_day,
-                  sqlite3_stmt *stmt_record,
+  // [修改] 注入 Statement (单行 + 多行批量语句) 与 ProjectResolver
+  explicit Writer(sqlite3 *db, const Statement &statements,
                   std::unique_ptr<ProjectResolver> project_resolver);
 
   ~Writer();
 
-  void insert_days(const std::vector<DayData> &days);
-  void insert_records(const std::vector<TimeRecordInternal> &records);
+  // [新增] 删除指定月份 ("YYYY-MM") 的 days / time_records 行，用于整月替换
+  void delete_months(const std::vector<std::string> &months);
+
+  // [修改] 以多行 INSERT 批量写入，文本列按 SQLITE_STATIC 绑定
+  // (调用方的 vector 在语句执行期间保持有效)。
+  // 返回写入行数；失败的行追加到 failures。
+  size_t insert_days(const std::vector<DayData> &days,
+                     std::vector<RowFailure> &failures);
+  size_t insert_records(const std::vector<TimeRecordInternal> &records,
+                        std::vector<RowFailure> &failures);
 
 private:
   sqlite3 *db_;
-  sqlite3_stmt *stmt_insert_day_;
-  sqlite3_stmt *stmt_insert_record_;
+  const Statement &statements_;
 
   // [修改] 持有注入的 Resolver
   std::unique_ptr<ProjectResolver> project_resolver_;
@@ -147,4 +147,21 @@ bool DiskFileSystem::IsRegularFile(const fs::path &path) {
   return fs::is_regular_file(path, ec);
 }
 
+// --- 文件元数据 ---
+
+std::uintmax_t DiskFileSystem::GetFileSize(const fs::path &path) {
+  std::error_code ec;
+  auto size = fs::file_size(path, ec);
+  return ec ? 0 : size;
+}
+
+long long DiskFileSystem::GetLastWriteTime(const fs::path &path) {
+  std::error_code ec;
+  auto time = fs::last_write_time(path, ec);
+  if (ec) {
+    return 0;
+  }
+  return static_cast<long long>(time.time_since_epoch().count());
+}
+
 } // namespace io
@@ -40,6 +40,10 @@ public:
   bool Exists(const std::filesystem::path &path) override;
   bool IsDirectory(const std::filesystem::path &path) override;
   bool IsRegularFile(const std::filesystem::path &path) override;
+
+  // --- 文件元数据 ---
+  std::uintmax_t GetFileSize(const std::filesystem::path &path) override;
+  long long GetLastWriteTime(const std::filesystem::path &path) override;
 };
 
 } // namespace io
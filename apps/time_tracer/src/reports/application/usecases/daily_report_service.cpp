@@ -1,26 +1,15 @@
 ﻿// reports/application/usecases/daily_report_service.cpp
 #include "reports/application/usecases/daily_report_service.hpp"
+#include "core/domain/ports/parallel_for.hpp"
 #include "reports/data/cache/project_name_cache.hpp"
 #include "reports/data/queriers/daily/day_querier.hpp"
 #include "reports/data/utils/project_tree_builder.hpp"
-#include "reports/shared/factories/generic_formatter_factory.hpp"
 #include <algorithm>
 #include <string>
 #include <tuple>
 #include <vector>
 // [移除] 移除了 fstream, sstream, filesystem，因为不再进行 IO 操作
 
-// 辅助函数保持不变
-static std::string join_path_parts(const std::vector<std::string> &parts) {
-  if (parts.empty())
-    return "";
-  std::string path = parts[0];
-  for (size_t i = 1; i < parts.size(); ++i) {
-    path += "_" + parts[i];
-  }
-  return path;
-}
-
 static std::pair<int, int> parse_year_month(const std::string &date) {
   if (date.size() >= 7) {
     try {
@@ -34,9 +23,10 @@ static std::pair<int, int> parse_year_month(const std::string &date) {
 }
 
 // [修改] 构造函数
-DailyReportService::DailyReportService(IReportRepository &repo,
-                                       const GlobalReportConfig &config)
-    : repo_(repo), config_(config) {}
+DailyReportService::DailyReportService(
+    IReportRepository &repo, const GlobalReportConfig &config,
+    std::shared_ptr<core::interfaces::ITaskExecutor> executor)
+    : repo_(repo), config_(config), executor_(std::move(executor)) {}
 
 // [新增] 辅助函数实现
 const DailyReportConfig &
@@ -65,30 +55,82 @@ std::string DailyReportService::generate_report(const std::string &date,
 
   // 3. 获取格式化器 (传递 Struct)
   // 注意：假设 Factory 已经适配为接收 (ReportFormat, const DailyReportConfig&)
-  auto formatter =
-      GenericFormatterFactory<DailyReportData>::create(format, cfg);
+  auto formatter = formatter_cache_.get(format, cfg);
 
   // 4. 生成
   return formatter->format_report(data);
 }
 
-// [修改] 批量生成
+// [修改] 批量生成：复用流式路径，把每个窗口收集到分组结果中
 FormattedGroupedReports
 DailyReportService::generate_all_reports(ReportFormat format) {
   FormattedGroupedReports grouped_reports;
+  stream_all_reports(format, [&](const DailyReportBatch &batch) {
+    for (const auto &[date, content] : batch) {
+      auto [year, month] = parse_year_month(date);
+      grouped_reports[year][month].push_back({date, content});
+    }
+  });
+  return grouped_reports;
+}
+
+// [新增] 流式生成：一次只持有一个月的原始记录与格式化结果
+void DailyReportService::stream_all_reports(ReportFormat format,
+                                            const DailyReportBatchSink &sink) {
+  // [修改] 预获取配置对象
+  const auto &cfg = get_config_by_format(format);
+
+  // [修改] 创建格式化器 (传递 Struct)
+  auto formatter = formatter_cache_.get(format, cfg);
+
+  for (const std::string &month : repo_.get_all_record_months()) {
+    DailyReportBatch batch =
+        std::move(render_window(month + "-01", month + "-31",
+                                {formatter.get()})
+                      .front());
+    if (!batch.empty()) {
+      sink(batch);
+    }
+  }
+}
+
+void DailyReportService::stream_all_reports_multi_format(
+    const std::vector<ReportFormat> &formats,
+    const MultiFormatDailyBatchSink &sink) {
+  std::vector<std::shared_ptr<const IReportFormatter<DailyReportData>>> owned;
+  std::vector<const IReportFormatter<DailyReportData> *> formatters;
+  for (ReportFormat format : formats) {
+    owned.push_back(formatter_cache_.get(format, get_config_by_format(format)));
+    formatters.push_back(owned.back().get());
+  }
 
+  for (const std::string &month : repo_.get_all_record_months()) {
+    std::vector<DailyReportBatch> batches =
+        render_window(month + "-01", month + "-31", formatters);
+    if (batches.empty() || batches.front().empty()) {
+      continue;
+    }
+    MultiFormatDailyBatch grouped;
+    for (size_t f = 0; f < formats.size(); ++f) {
+      grouped[formats[f]] = std::move(batches[f]);
+    }
+    sink(grouped);
+  }
+}
+
+std::vector<DailyReportBatch> DailyReportService::render_window(
+    const std::string &start_date, const std::string &end_date,
+    const std::vector<const IReportFormatter<DailyReportData> *> &formatters) {
   auto &name_cache = ProjectNameCache::instance();
 
   std::map<std::string, DailyReportData> data_map =
-      repo_.get_all_days_metadata();
-  auto all_records = repo_.get_all_time_records_with_date();
-
-  // [修改] 预获取配置对象
-  const auto &cfg = get_config_by_format(format);
+      repo_.get_days_metadata_in_range(start_date, end_date);
+  auto records =
+      repo_.get_time_records_with_date_in_range(start_date, end_date);
 
   std::map<std::string, std::map<long long, long long>> temp_proj_agg;
 
-  for (auto &[date, record] : all_records) {
+  for (auto &[date, record] : records) {
     DailyReportData &day_data = data_map[date];
     if (day_data.date_.empty())
       day_data.date_ = date;
@@ -101,12 +143,13 @@ DailyReportService::generate_all_reports(ReportFormat format) {
 
     temp_proj_agg[date][pid] += record.duration_seconds_;
 
-    std::vector<std::string> parts = name_cache.get_path_parts(pid);
-    record.project_path_ = join_path_parts(parts);
+    // [修改] 物化路径，单次下标访问
+    record.project_path_ = name_cache.get_joined_path(pid);
 
-    day_data.detailed_records_.push_back(record);
     day_data.total_duration_ += record.duration_seconds_;
+    day_data.detailed_records_.push_back(std::move(record));
   }
+  records.clear();
 
   for (auto &[date, agg] : temp_proj_agg) {
     auto &day_data = data_map[date];
@@ -115,21 +158,35 @@ DailyReportService::generate_all_reports(ReportFormat format) {
     }
   }
 
-  // [修改] 创建格式化器 (传递 Struct)
-  auto formatter =
-      GenericFormatterFactory<DailyReportData>::create(format, cfg);
-
+  // [修改] 建树与格式化按天分发到线程池；结果按下标回填，
+  // 保证输出与串行执行完全一致
+  std::vector<std::pair<const std::string *, DailyReportData *>> pending;
   for (auto &[date, data] : data_map) {
     if (data.total_duration_ > 0) {
-      build_project_tree_from_ids(data.project_tree_, data.project_stats_,
-                                  name_cache);
-
-      std::string formatted_report = formatter->format_report(data);
-
-      auto [year, month] = parse_year_month(date);
-      grouped_reports[year][month].push_back({date, formatted_report});
+      pending.emplace_back(&date, &data);
     }
   }
 
-  return grouped_reports;
+  // [修改] 每天只建一次树，随后依次交给各格式化器
+  const size_t format_count = formatters.size();
+  std::vector<std::string> formatted(pending.size() * format_count);
+  core::interfaces::ParallelFor(
+      executor_.get(), pending.size(), [&](size_t i) {
+        DailyReportData &data = *pending[i].second;
+        build_project_tree_from_ids(data.project_tree_, data.project_stats_,
+                                    name_cache);
+        for (size_t f = 0; f < format_count; ++f) {
+          formatted[i * format_count + f] = formatters[f]->format_report(data);
+        }
+      });
+
+  std::vector<DailyReportBatch> batches(format_count);
+  for (size_t f = 0; f < format_count; ++f) {
+    batches[f].reserve(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+      batches[f].emplace_back(*pending[i].first,
+                              std::move(formatted[i * format_count + f]));
+    }
+  }
+  return batches;
 }
@@ -4,27 +4,50 @@
 
 #include "common/config/global_report_config.hpp" // [修改] 替换 app_config.hpp
 #include "core/domain/model/query_data_structs.hpp"
+#include "core/domain/ports/i_task_executor.hpp"
 #include "core/domain/types/report_format.hpp"
 #include "reports/domain/model/daily_report_data.hpp"
 #include "reports/domain/repositories/i_report_repository.hpp"
+#include "reports/shared/factories/formatter_cache.hpp"
 
 class DailyReportService {
 public:
   // [修改] 依赖 GlobalReportConfig
-  explicit DailyReportService(IReportRepository &repo,
-                              const GlobalReportConfig &config);
+  // [修改] 可选注入线程池，用于全量导出时并行建树与格式化
+  explicit DailyReportService(
+      IReportRepository &repo, const GlobalReportConfig &config,
+      std::shared_ptr<core::interfaces::ITaskExecutor> executor = nullptr);
 
   // [修改] 移除 custom_config_content，直接使用预加载的配置
   std::string generate_report(const std::string &date, ReportFormat format);
 
   FormattedGroupedReports generate_all_reports(ReportFormat format);
 
+  // [新增] 流式全量生成：按自然月为窗口读取、建树、格式化，
+  // 每个窗口交给 sink 后即释放，不在内存中保留全部日报
+  void stream_all_reports(ReportFormat format,
+                          const DailyReportBatchSink &sink);
+
+  // [新增] 多格式流式生成：每个窗口只读取、建树一次，再分别格式化
+  void stream_all_reports_multi_format(const std::vector<ReportFormat> &formats,
+                                       const MultiFormatDailyBatchSink &sink);
+
 private:
   IReportRepository &repo_;
   const GlobalReportConfig &config_; // [修改] 持有 GlobalReportConfig
+  std::shared_ptr<core::interfaces::ITaskExecutor> executor_;
+
+  // [新增] 按 (格式, 配置) 缓存的格式化器，跨多次报表调用复用
+  FormatterCache<DailyReportData> formatter_cache_;
 
   // [新增] 内部辅助：根据格式获取对应的配置对象
   const DailyReportConfig &get_config_by_format(ReportFormat format) const;
+
+  // [新增] 生成 [start_date, end_date] 内所有有记录日期的报表，按日期升序；
+  // [修改] 每个格式化器各得一批，返回值与 formatters 下标一一对应
+  std::vector<DailyReportBatch> render_window(
+      const std::string &start_date, const std::string &end_date,
+      const std::vector<const IReportFormatter<DailyReportData> *> &formatters);
 };
 
 #endif // REPORTS_APPLICATION_USECASES_DAILY_REPORT_SERVICE_HPP_
@@ -1,104 +1,78 @@
 ﻿// reports/application/usecases/range_report_service.cpp
 #include "reports/application/usecases/range_report_service.hpp"
+#include "common/utils/civil_time.hpp"
+#include "core/domain/ports/parallel_for.hpp"
 #include "reports/data/cache/project_name_cache.hpp"
 #include "reports/data/utils/project_tree_builder.hpp"
-#include "reports/shared/factories/generic_formatter_factory.hpp"
+#include <algorithm>
+#include <format>
 #include <stdexcept>
-
-// [新增辅助函数] (如果项目中没有现成的日期工具)
-// 解析 YYYY-Www 并计算起止日期 (ISO 8601 简化版)
-static std::pair<std::string, std::string>
-calculate_week_range(const std::string &week_str) {
-  int year = 0, week = 0;
-  if (sscanf(week_str.c_str(), "%d-W%d", &year, &week) != 2)
-    return {"", ""};
-
-  std::tm tm = {};
-  tm.tm_year = year - 1900;
-  tm.tm_mon = 0; // Jan
-  tm.tm_mday = 4;
-  mktime(&tm);
-
-  // ISO周以周一为第一天
-  int wday = (tm.tm_wday == 0) ? 7 : tm.tm_wday;
-  int days_shift = 1 - wday;
-
-  tm.tm_mday += days_shift + (week - 1) * 7;
-  std::time_t start_time = mktime(&tm);
-
-  std::tm end_tm = tm;
-  end_tm.tm_mday += 6;
-  std::time_t end_time = mktime(&end_tm);
-
-  char buf[16];
-  std::strftime(buf, sizeof(buf), "%Y-%m-%d", std::localtime(&start_time));
-  std::string s_date = buf;
-  std::strftime(buf, sizeof(buf), "%Y-%m-%d", std::localtime(&end_time));
-  std::string e_date = buf;
-
-  return {s_date, e_date};
+#include <unordered_map>
+
+namespace {
+
+RangeType range_type_of(ReportPeriod period) {
+  switch (period) {
+  case ReportPeriod::Week:
+    return RangeType::Week;
+  case ReportPeriod::BiWeek:
+    return RangeType::BiWeek;
+  case ReportPeriod::Month:
+    return RangeType::Month;
+  case ReportPeriod::Quarter:
+    return RangeType::Quarter;
+  case ReportPeriod::HalfYear:
+    return RangeType::HalfYear;
+  case ReportPeriod::Year:
+  default:
+    return RangeType::Year;
+  }
 }
 
-// [新增方法实现]
-std::map<int, std::map<int, std::string>>
-RangeReportService::generate_all_weekly_history(ReportFormat format) {
-  std::map<int, std::map<int, std::string>> reports;
-
-  // 1. 强制获取 Week 配置 (这修复了之前的配置加载 Bug 导致的空白问题)
-  const auto &cfg = get_config_by_format(format, RangeType::Week);
-
-  // 2. 获取底层数据 (YYYY-Www -> Stats)
-  auto all_project_stats = repo_.get_all_weeks_project_stats();
-  auto all_active_days = repo_.get_all_weeks_active_days();
-
-  auto formatter =
-      GenericFormatterFactory<RangeReportData>::create(format, cfg);
-
-  for (auto &[week_str, stats] : all_project_stats) {
-    RangeReportData data;
-    data.report_name_ = week_str;
-
-    // 计算日期范围
-    auto [start, end] = calculate_week_range(week_str);
-    data.start_date_ = start;
-    data.end_date_ = end;
-    data.covered_days_ = 7;
-
-    data.project_stats_ = stats;
-    data.actual_active_days_ =
-        all_active_days.count(week_str) ? all_active_days[week_str] : 0;
+// 只移走项目统计，周期键与日期留给调用方用作结果的索引
+RangeReportData to_range_data(PeriodBucket &bucket) {
+  RangeReportData data;
+  data.report_name_ = bucket.key_;
+  data.start_date_ = bucket.start_date_;
+  data.end_date_ = bucket.end_date_;
+  data.covered_days_ = bucket.covered_days_;
+  data.actual_active_days_ = bucket.active_days_;
+  data.total_duration_ = bucket.total_duration_;
+  data.project_stats_ = std::move(bucket.project_stats_);
+  return data;
+}
 
-    for (auto &p : stats)
-      data.total_duration_ += p.second;
+} // namespace
 
-    build_project_tree_from_ids(data.project_tree_, data.project_stats_,
-                                ProjectNameCache::instance());
+RangeReportService::RangeReportService(
+    IReportRepository &repo, const GlobalReportConfig &config,
+    std::shared_ptr<core::interfaces::ITaskExecutor> executor)
+    : repo_(repo), config_(config), executor_(std::move(executor)) {}
 
-    // 解析 Year 和 Week 用于 Map 键
-    int year = 0, week = 0;
-    if (sscanf(week_str.c_str(), "%d-W%d", &year, &week) == 2) {
-      reports[year][week] = formatter->format_report(data);
-    }
-  }
-  return reports;
+std::vector<std::string> RangeReportService::render_all(
+    std::vector<RangeReportData> &items,
+    const IReportFormatter<RangeReportData> &formatter) {
+  return std::move(render_all_formats(items, {&formatter}).front());
 }
 
-static std::pair<int, int> parse_year_month(const std::string &ym) {
-  if (ym.size() >= 7 && ym[4] == '-') {
-    try {
-      int y = std::stoi(ym.substr(0, 4));
-      int m = std::stoi(ym.substr(5, 2));
-      return {y, m};
-    } catch (...) {
-    }
-  }
-  return {0, 0};
+std::vector<std::vector<std::string>> RangeReportService::render_all_formats(
+    std::vector<RangeReportData> &items,
+    const std::vector<const IReportFormatter<RangeReportData> *> &formatters) {
+  std::vector<std::vector<std::string>> formatted(
+      formatters.size(), std::vector<std::string>(items.size()));
+  const auto &name_cache = ProjectNameCache::instance();
+  core::interfaces::ParallelFor(
+      executor_.get(), items.size(), [&](size_t i) {
+        RangeReportData &data = items[i];
+        build_project_tree_from_ids(data.project_tree_, data.project_stats_,
+                                    name_cache);
+        for (size_t f = 0; f < formatters.size(); ++f) {
+          formatted[f][i] = formatters[f]->format_report(data);
+        }
+      });
+  return formatted;
 }
 
-RangeReportService::RangeReportService(IReportRepository &repo,
-                                       const GlobalReportConfig &config)
-    : repo_(repo), config_(config) {}
-
 // [关键修改] 根据 type 选择 config.week / config.month / config.recent
 const RangeReportConfig &
 RangeReportService::get_config_by_format(ReportFormat format,
@@ -129,6 +103,9 @@ RangeReportService::get_config_by_format(ReportFormat format,
   case RangeType::Recent: // [修改]
     return fmt_config->recent_;
   case RangeType::Range: // [新增]
+  case RangeType::BiWeek:
+  case RangeType::Quarter:
+  case RangeType::HalfYear:
     return fmt_config->range_;
   default:
     return fmt_config->recent_;
@@ -144,8 +121,7 @@ std::string RangeReportService::generate_report(const RangeRequest &request,
   RangeReportData data = build_data_for_range(request);
 
   // 3. 格式化
-  auto formatter =
-      GenericFormatterFactory<RangeReportData>::create(format, cfg);
+  auto formatter = formatter_cache_.get(format, cfg);
   return formatter->format_report(data);
 }
 
@@ -162,80 +138,388 @@ RangeReportService::generate_batch(const std::vector<RangeRequest> &requests,
   return results;
 }
 
+std::map<ReportPeriod, std::vector<PeriodBucket>>
+RangeReportService::rollup_periods(const std::vector<ReportPeriod> &periods) {
+  // [新增] 数据源只遍历一次，每行同时累加到所有粒度
+  PeriodRollupEngine engine(periods);
+  repo_.for_each_daily_project_stats(
+      [&](const DailyProjectDuration &row) { engine.add(row); });
+
+  std::map<ReportPeriod, std::vector<PeriodBucket>> result;
+  for (ReportPeriod period : periods) {
+    if (!result.contains(period)) {
+      result[period] = engine.take(period);
+    }
+  }
+  return result;
+}
+
+std::vector<std::string>
+RangeReportService::render_buckets(std::vector<PeriodBucket> &buckets,
+                                   ReportFormat format, RangeType type) {
+  const auto &cfg = get_config_by_format(format, type);
+  auto formatter = formatter_cache_.get(format, cfg);
+
+  std::vector<RangeReportData> items;
+  items.reserve(buckets.size());
+  for (auto &bucket : buckets) {
+    items.push_back(to_range_data(bucket));
+  }
+  return render_all(items, *formatter);
+}
+
+std::map<int, std::map<int, std::string>>
+RangeReportService::generate_all_weekly_history(ReportFormat format) {
+  std::map<int, std::map<int, std::string>> reports;
+  auto buckets = rollup_periods({ReportPeriod::Week})[ReportPeriod::Week];
+  std::vector<std::string> formatted =
+      render_buckets(buckets, format, RangeType::Week);
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    reports[buckets[i].year_][buckets[i].index_] = std::move(formatted[i]);
+  }
+  return reports;
+}
+
 std::map<int, std::map<int, std::string>>
 RangeReportService::generate_all_monthly_history(ReportFormat format) {
   std::map<int, std::map<int, std::string>> reports;
+  stream_all_monthly_history(
+      format, [&](int year, const MonthlyReportBatch &batch) {
+        reports[year] = batch;
+      });
+  return reports;
+}
 
+void RangeReportService::stream_all_monthly_history(
+    ReportFormat format, const MonthlyReportBatchSink &sink) {
   // 强制使用 Month 配置
   const auto &cfg = get_config_by_format(format, RangeType::Month);
 
-  auto all_project_stats = repo_.get_all_months_project_stats();
-  auto all_active_days = repo_.get_all_months_active_days();
-
-  auto formatter =
-      GenericFormatterFactory<RangeReportData>::create(format, cfg);
-
-  for (auto &[ym, stats] : all_project_stats) {
-    RangeReportData data;
-    data.report_name_ = ym;
-    data.start_date_ = ym + "-01";
-    data.end_date_ = ym + "-31";
-    data.covered_days_ = 30;
-    data.project_stats_ = stats;
-    data.actual_active_days_ = all_active_days[ym];
+  // 汇总体积只与 (月份 x 项目) 数相关；
+  // 占内存的是格式化后的正文，因此按年为窗口渲染并交付
+  auto buckets = rollup_periods({ReportPeriod::Month})[ReportPeriod::Month];
 
-    for (auto &p : stats)
-      data.total_duration_ += p.second;
+  auto formatter = formatter_cache_.get(format, cfg);
 
-    // 构建树
-    build_project_tree_from_ids(data.project_tree_, data.project_stats_,
-                                ProjectNameCache::instance());
+  std::vector<RangeReportData> items;
+  std::vector<int> months;
+  int window_year = 0;
 
-    auto [y, m] = parse_year_month(ym);
-    if (y > 0) {
-      reports[y][m] = formatter->format_report(data);
+  auto flush = [&]() {
+    if (items.empty()) {
+      return;
     }
+    // [修改] 建树与格式化并行执行，按下标回填保证结果确定
+    std::vector<std::string> formatted = render_all(items, *formatter);
+    MonthlyReportBatch batch;
+    for (size_t i = 0; i < months.size(); ++i) {
+      batch[months[i]] = std::move(formatted[i]);
+    }
+    items.clear();
+    months.clear();
+    sink(window_year, batch);
+  };
+
+  // 周期按时间升序，同一年的月份连续出现
+  for (auto &bucket : buckets) {
+    if (bucket.year_ != window_year) {
+      flush();
+      window_year = bucket.year_;
+    }
+    months.push_back(bucket.index_);
+    items.push_back(to_range_data(bucket));
   }
-  return reports;
+  flush();
 }
 
 std::map<int, std::string>
 RangeReportService::generate_all_yearly_history(ReportFormat format) {
   std::map<int, std::string> reports;
+  auto buckets = rollup_periods({ReportPeriod::Year})[ReportPeriod::Year];
+  std::vector<std::string> formatted =
+      render_buckets(buckets, format, RangeType::Year);
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    reports[buckets[i].year_] = std::move(formatted[i]);
+  }
+  return reports;
+}
 
-  // 1. Config
-  const auto &cfg = get_config_by_format(format, RangeType::Year);
+FormattedPeriodHistory RangeReportService::generate_all_period_history(
+    ReportFormat format, const std::vector<ReportPeriod> &periods) {
+  FormattedPeriodHistory history;
+  for (auto &[period, buckets] : rollup_periods(periods)) {
+    std::vector<std::string> formatted =
+        render_buckets(buckets, format, range_type_of(period));
+    FormattedPeriodReports &reports = history[period];
+    for (size_t i = 0; i < buckets.size(); ++i) {
+      reports[buckets[i].key_] = std::move(formatted[i]);
+    }
+  }
+  return history;
+}
 
-  // 2. Data
-  auto all_project_stats = repo_.get_all_years_project_stats();
-  auto all_active_days = repo_.get_all_years_active_days();
+MultiFormatPeriodHistory
+RangeReportService::generate_all_period_history_multi_format(
+    const std::vector<ReportFormat> &formats,
+    const std::vector<ReportPeriod> &periods) {
+  MultiFormatPeriodHistory history;
+  for (auto &[period, buckets] : rollup_periods(periods)) {
+    const RangeType type = range_type_of(period);
+    std::vector<std::shared_ptr<const IReportFormatter<RangeReportData>>>
+        owned;
+    std::vector<const IReportFormatter<RangeReportData> *> formatters;
+    for (ReportFormat format : formats) {
+      owned.push_back(
+          formatter_cache_.get(format, get_config_by_format(format, type)));
+      formatters.push_back(owned.back().get());
+    }
 
-  auto formatter =
-      GenericFormatterFactory<RangeReportData>::create(format, cfg);
+    std::vector<RangeReportData> items;
+    items.reserve(buckets.size());
+    for (auto &bucket : buckets) {
+      items.push_back(to_range_data(bucket));
+    }
+    auto formatted = render_all_formats(items, formatters);
 
-  for (auto &[year_str, stats] : all_project_stats) {
-    RangeReportData data;
-    data.report_name_ = year_str;
-    data.start_date_ = year_str + "-01-01";
-    data.end_date_ = year_str + "-12-31";
-    data.covered_days_ = 365; // 近似
-    data.project_stats_ = stats;
-    data.actual_active_days_ =
-        all_active_days.count(year_str) ? all_active_days[year_str] : 0;
+    for (size_t f = 0; f < formats.size(); ++f) {
+      FormattedPeriodReports &reports = history[formats[f]][period];
+      for (size_t i = 0; i < buckets.size(); ++i) {
+        reports[buckets[i].key_] = std::move(formatted[f][i]);
+      }
+    }
+  }
+  return history;
+}
+
+// --- 环比 / 同比 ---
+
+namespace {
+
+std::string format_civil_date(const TimeUtils::CivilDate &date) {
+  return std::format("{:04d}-{:02d}-{:02d}", date.year_, date.month_,
+                     date.day_);
+}
+
+std::string format_day_number(long long days) {
+  return format_civil_date(TimeUtils::CivilFromDays(days));
+}
+
+long long days_in_month(int year, int month) {
+  const long long begin = TimeUtils::DaysFromCivil(year, month, 1);
+  return month == 12 ? TimeUtils::DaysFromCivil(year + 1, 1, 1) - begin
+                     : TimeUtils::DaysFromCivil(year, month + 1, 1) - begin;
+}
+
+// 日期按年平移，2 月 29 日落到平年时取 2 月 28 日
+std::string shift_years(const TimeUtils::CivilDate &date, int years) {
+  TimeUtils::CivilDate shifted = date;
+  shifted.year_ += years;
+  shifted.day_ = static_cast<int>(std::min<long long>(
+      shifted.day_, days_in_month(shifted.year_, shifted.month_)));
+  return format_civil_date(shifted);
+}
+
+struct ComparisonWindow {
+  ComparisonKind kind;
+  std::string label;
+  DateWindow window;
+};
+
+// 整月窗口，月末按该月实际天数
+DateWindow month_window(int year, int month) {
+  const std::string prefix = std::format("{:04d}-{:02d}", year, month);
+  return {prefix + "-01",
+          std::format("{}-{:02d}", prefix, days_in_month(year, month))};
+}
 
-    for (auto &p : stats)
-      data.total_duration_ += p.second;
+// 按报表类型派生对照窗口。月报取整月；
+// 年报的上一周期即去年同期，只保留一个
+std::vector<ComparisonWindow>
+derive_comparison_windows(RangeType type, const DateWindow &base) {
+  TimeUtils::CivilDate start;
+  TimeUtils::CivilDate end;
+  if (!TimeUtils::ParseCivilDate(base.start_date_, start) ||
+      !TimeUtils::ParseCivilDate(base.end_date_, end)) {
+    throw std::runtime_error("Invalid date range for comparison report: " +
+                             base.start_date_ + " ~ " + base.end_date_);
+  }
 
-    build_project_tree_from_ids(data.project_tree_, data.project_stats_,
-                                ProjectNameCache::instance());
+  std::vector<ComparisonWindow> windows;
+  switch (type) {
+  case RangeType::Year: {
+    const std::string year = std::format("{:04d}", start.year_ - 1);
+    windows.push_back({ComparisonKind::SamePeriodLastYear, "vs " + year,
+                       {year + "-01-01", year + "-12-31"}});
+    break;
+  }
+  case RangeType::Month: {
+    const int prev_year = start.month_ == 1 ? start.year_ - 1 : start.year_;
+    const int prev_month = start.month_ == 1 ? 12 : start.month_ - 1;
+    const std::string prev =
+        std::format("{:04d}-{:02d}", prev_year, prev_month);
+    const std::string last_year =
+        std::format("{:04d}-{:02d}", start.year_ - 1, start.month_);
+    windows.push_back({ComparisonKind::PreviousPeriod, "vs " + prev,
+                       month_window(prev_year, prev_month)});
+    windows.push_back({ComparisonKind::SamePeriodLastYear, "vs " + last_year,
+                       month_window(start.year_ - 1, start.month_)});
+    break;
+  }
+  default: {
+    const long long first =
+        TimeUtils::DaysFromCivil(start.year_, start.month_, start.day_);
+    const long long last =
+        TimeUtils::DaysFromCivil(end.year_, end.month_, end.day_);
+    const long long length = std::max(1LL, last - first + 1);
+    windows.push_back({ComparisonKind::PreviousPeriod, "vs previous period",
+                       {format_day_number(first - length),
+                        format_day_number(first - 1)}});
+    if (type == RangeType::Week) {
+      // 周报对齐到 52 周前，保持周一至周日
+      const auto week = TimeUtils::IsoWeekFromDays(first - 364);
+      windows.push_back(
+          {ComparisonKind::SamePeriodLastYear,
+           std::format("vs {:04d}-W{:02d}", week.year_, week.week_),
+           {format_day_number(first - 364), format_day_number(last - 364)}});
+    } else {
+      windows.push_back({ComparisonKind::SamePeriodLastYear,
+                         "vs same period last year",
+                         {shift_years(start, -1), shift_years(end, -1)}});
+    }
+    break;
+  }
+  }
+  return windows;
+}
 
-    try {
-      int y = std::stoi(year_str);
-      reports[y] = formatter->format_report(data);
-    } catch (...) {
+// 单个窗口的累加状态；行按日期升序到达，日期变化即新的活跃日
+struct WindowAccumulator {
+  std::unordered_map<long long, long long> project_durations;
+  long long total_duration = 0;
+  int active_days = 0;
+  std::string last_date;
+};
+
+// 叶子项目时长沿祖先链上卷，使每个父项目都带有子树合计
+void accumulate_rolled_up(
+    std::unordered_map<long long, ProjectDelta> &deltas,
+    const std::unordered_map<long long, long long> &durations,
+    const IProjectInfoProvider &provider, bool is_current) {
+  for (const auto &[project_id, duration] : durations) {
+    std::span<const long long> chain = provider.get_ancestor_ids(project_id);
+    if (chain.empty()) {
+      chain = std::span<const long long>(&project_id, 1);
+    }
+    for (size_t depth = 0; depth < chain.size(); ++depth) {
+      ProjectDelta &delta = deltas[chain[depth]];
+      delta.project_id_ = chain[depth];
+      delta.depth_ = static_cast<int>(depth);
+      (is_current ? delta.current_duration_ : delta.baseline_duration_) +=
+          duration;
     }
   }
-  return reports;
+}
+
+std::vector<ProjectDelta>
+build_project_deltas(const std::unordered_map<long long, long long> &current,
+                     const std::unordered_map<long long, long long> &baseline,
+                     const IProjectInfoProvider &provider) {
+  std::unordered_map<long long, ProjectDelta> rolled;
+  accumulate_rolled_up(rolled, current, provider, true);
+  accumulate_rolled_up(rolled, baseline, provider, false);
+
+  std::vector<ProjectDelta> deltas;
+  deltas.reserve(rolled.size());
+  for (auto &[id, delta] : rolled) {
+    delta.name_ = provider.get_project_name(id);
+    if (delta.name_.empty()) {
+      delta.name_ = std::to_string(id);
+    }
+    deltas.push_back(std::move(delta));
+  }
+  // 父项目时长不小于子项目，深度作为最后的比较键保证父在前
+  std::sort(deltas.begin(), deltas.end(),
+            [](const ProjectDelta &a, const ProjectDelta &b) {
+              if (a.current_duration_ != b.current_duration_)
+                return a.current_duration_ > b.current_duration_;
+              if (a.baseline_duration_ != b.baseline_duration_)
+                return a.baseline_duration_ > b.baseline_duration_;
+              if (a.depth_ != b.depth_)
+                return a.depth_ < b.depth_;
+              return a.name_ < b.name_;
+            });
+  return deltas;
+}
+
+} // namespace
+
+std::string
+RangeReportService::generate_comparison_report(const RangeRequest &request,
+                                               ReportFormat format) {
+  const auto &cfg = get_config_by_format(format, request.type);
+  RangeReportData data = build_comparison_data(request);
+  auto formatter = formatter_cache_.get(format, cfg);
+  return formatter->format_report(data);
+}
+
+RangeReportData
+RangeReportService::build_comparison_data(const RangeRequest &request) {
+  const DateWindow base{request.start_date, request.end_date};
+  std::vector<ComparisonWindow> comparisons =
+      derive_comparison_windows(request.type, base);
+
+  // 窗口 0 为本期，其余与 comparisons 一一对应
+  std::vector<DateWindow> windows{base};
+  for (const auto &comparison : comparisons) {
+    windows.push_back(comparison.window);
+  }
+
+  // 一次查询、一次遍历：每行只与各窗口边界比较后累加到命中的窗口
+  std::vector<WindowAccumulator> accumulators(windows.size());
+  for (const auto &row : repo_.get_daily_project_stats_in_windows(windows)) {
+    for (size_t i = 0; i < windows.size(); ++i) {
+      if (row.date_ < windows[i].start_date_ ||
+          row.date_ > windows[i].end_date_) {
+        continue;
+      }
+      WindowAccumulator &acc = accumulators[i];
+      acc.project_durations[row.project_id_] += row.duration_;
+      acc.total_duration += row.duration_;
+      if (row.date_ != acc.last_date) {
+        ++acc.active_days;
+        acc.last_date = row.date_;
+      }
+    }
+  }
+
+  RangeReportData data;
+  data.report_name_ = request.name;
+  data.start_date_ = request.start_date;
+  data.end_date_ = request.end_date;
+  data.covered_days_ = request.covered_days;
+  data.actual_active_days_ = accumulators[0].active_days;
+  data.total_duration_ = accumulators[0].total_duration;
+  data.project_stats_.assign(accumulators[0].project_durations.begin(),
+                             accumulators[0].project_durations.end());
+
+  const auto &name_cache = ProjectNameCache::instance();
+  build_project_tree_from_ids(data.project_tree_, data.project_stats_,
+                              name_cache);
+
+  for (size_t i = 0; i < comparisons.size(); ++i) {
+    const WindowAccumulator &acc = accumulators[i + 1];
+    PeriodComparison comparison;
+    comparison.kind_ = comparisons[i].kind;
+    comparison.label_ = comparisons[i].label;
+    comparison.start_date_ = comparisons[i].window.start_date_;
+    comparison.end_date_ = comparisons[i].window.end_date_;
+    comparison.actual_active_days_ = acc.active_days;
+    comparison.total_duration_ = acc.total_duration;
+    comparison.project_deltas_ = build_project_deltas(
+        accumulators[0].project_durations, acc.project_durations, name_cache);
+    data.comparisons_.push_back(std::move(comparison));
+  }
+  return data;
 }
 
 RangeReportData
@@ -3,10 +3,16 @@
 #define REPORTS_APPLICATION_USECASES_RANGE_REPORT_SERVICE_HPP_
 
 #include "common/config/global_report_config.hpp"
+#include "core/domain/model/query_data_structs.hpp"
+#include "core/domain/ports/i_task_executor.hpp"
 #include "core/domain/types/report_format.hpp"
+#include "core/domain/types/report_period.hpp"
+#include "reports/data/utils/period_rollup_engine.hpp"
 #include "reports/domain/model/range_report_data.hpp"
 #include "reports/domain/repositories/i_report_repository.hpp"
+#include "reports/shared/factories/formatter_cache.hpp"
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -16,7 +22,11 @@ enum class RangeType {
   Month,
   Week,
   Year,
-  Range
+  Range,
+  // [新增] 以下周期没有独立的配置文件，沿用 Range 配置
+  BiWeek,
+  Quarter,
+  HalfYear
 };
 
 struct RangeRequest {
@@ -30,8 +40,10 @@ struct RangeRequest {
 
 class RangeReportService {
 public:
-  explicit RangeReportService(IReportRepository &repo,
-                              const GlobalReportConfig &config);
+  // [修改] 可选注入线程池，用于历史报表的并行建树与格式化
+  explicit RangeReportService(
+      IReportRepository &repo, const GlobalReportConfig &config,
+      std::shared_ptr<core::interfaces::ITaskExecutor> executor = nullptr);
 
   std::string generate_report(const RangeRequest &request, ReportFormat format);
 
@@ -42,15 +54,53 @@ public:
   generate_all_weekly_history(ReportFormat format); // 生成所有历史周报
   std::map<int, std::map<int, std::string>>
   generate_all_monthly_history(ReportFormat format); // 生成所有历史月报
+  // [新增] 流式生成历史月报：每格式化完一年的月报就交给 sink 并释放
+  void stream_all_monthly_history(ReportFormat format,
+                                  const MonthlyReportBatchSink &sink);
   std::map<int, std::string>
   generate_all_yearly_history(ReportFormat format); // 生成所有历史年报
 
+  // [新增] 通用周期历史报表：一次遍历数据同时汇总 periods 中的所有粒度
+  // (含双周 / 季度 / 半年)，结果按粒度分组，组内以周期键索引
+  FormattedPeriodHistory
+  generate_all_period_history(ReportFormat format,
+                              const std::vector<ReportPeriod> &periods);
+  // [新增] 多格式版本：汇总与建树只做一次，每个周期依次交给各格式化器
+  MultiFormatPeriodHistory generate_all_period_history_multi_format(
+      const std::vector<ReportFormat> &formats,
+      const std::vector<ReportPeriod> &periods);
+
+  // [新增] 环比 / 同比报表：request 为本期，自动派生上一周期与去年同期，
+  // 所有窗口共用一次查询，结果附在本期数据上交给同类型的范围格式化器
+  std::string generate_comparison_report(const RangeRequest &request,
+                                         ReportFormat format);
+
 private:
   IReportRepository &repo_;
   const GlobalReportConfig &config_;
+  std::shared_ptr<core::interfaces::ITaskExecutor> executor_;
+
+  // [新增] 按 (格式, 配置) 缓存的格式化器，跨多次报表调用复用
+  FormatterCache<RangeReportData> formatter_cache_;
 
   RangeReportData build_data_for_range(const RangeRequest &request);
 
+  // [新增] 单次遍历数据源，按 periods 中的每个粒度汇总 (见 PeriodRollupEngine)
+  std::map<ReportPeriod, std::vector<PeriodBucket>>
+  rollup_periods(const std::vector<ReportPeriod> &periods);
+  std::vector<std::string> render_buckets(std::vector<PeriodBucket> &buckets,
+                                          ReportFormat format, RangeType type);
+  RangeReportData build_comparison_data(const RangeRequest &request);
+
+  // [新增] 为每份数据建树并格式化 (可并行)，返回值与 items 下标一一对应
+  std::vector<std::string>
+  render_all(std::vector<RangeReportData> &items,
+             const IReportFormatter<RangeReportData> &formatter);
+  // [新增] 每份数据只建一次树，结果为 [格式化器下标][items 下标]
+  std::vector<std::vector<std::string>> render_all_formats(
+      std::vector<RangeReportData> &items,
+      const std::vector<const IReportFormatter<RangeReportData> *> &formatters);
+
   // [修改] 增加 RangeType 参数
   const RangeReportConfig &get_config_by_format(ReportFormat format,
                                                 RangeType type) const;
@@ -4,10 +4,10 @@
 
 #include "reports/data/interfaces/i_project_info_provider.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <sqlite3.h>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 struct ProjectInfo {
@@ -15,7 +15,19 @@ struct ProjectInfo {
   long long parent_id;
 };
 
+// [新增] 加载时物化的项目路径条目，按项目 id 直接下标存放
+struct ProjectPathEntry {
+  std::string joined_path;
+  uint32_t depth = 0; // 0 表示该 id 不存在
+  // ancestor_ids_ 中 [ancestors_begin, ancestors_begin + depth) 为根→自身
+  uint32_t ancestors_begin = 0;
+};
+
 // [修改] 继承 IProjectInfoProvider
+// [修改] 加载时一次性物化每个项目的完整路径、深度与祖先链，
+// 报表按记录解析时只做一次下标访问。加载后只读，可被多线程并发查询；
+// 唯一的写入口 register_project 由组合根注入导入器的回调调用，
+// 导入阶段单线程运行，不与报表查询并发
 class ProjectNameCache : public IProjectInfoProvider {
 public:
   static ProjectNameCache &instance() {
@@ -39,33 +51,140 @@ public:
         if (sqlite3_column_type(stmt, 2) != SQLITE_NULL) {
           parent = sqlite3_column_int64(stmt, 2);
         }
-        cache_[id] = {std::move(name), parent};
+        store_info(id, {std::move(name), parent});
       }
     } else {
       std::cerr << "Failed to load projects: " << sqlite3_errmsg(db)
                 << std::endl;
     }
     sqlite3_finalize(stmt);
+
+    for (size_t id = 1; id < infos_.size(); ++id) {
+      materialize(static_cast<long long>(id));
+    }
     loaded_ = true;
   }
 
-  // [修改] 添加 override 关键字
+  // [新增] 导入器新建项目节点后同步到缓存；缓存尚未加载时无需处理，
+  // 之后的 ensure_loaded 会从数据库读到它
+  void register_project(long long id, const std::string &name,
+                        long long parent_id) {
+    if (!loaded_)
+      return;
+    if (store_info(id, {name, parent_id})) {
+      materialize(id);
+    }
+  }
+
+  // [修改] 由物化的祖先链拼出各段名称
   std::vector<std::string> get_path_parts(long long project_id) const override {
     std::vector<std::string> parts;
-    long long curr = project_id;
-    while (curr != 0 && cache_.count(curr)) {
-      const auto &info = cache_.at(curr);
-      parts.push_back(info.name);
-      curr = info.parent_id;
+    for (long long id : get_ancestor_ids(project_id)) {
+      parts.push_back(infos_[id].name);
     }
-    std::reverse(parts.begin(), parts.end());
     return parts;
   }
 
+  const std::string &get_joined_path(long long project_id) const override {
+    const ProjectPathEntry *entry = find_entry(project_id);
+    return entry ? entry->joined_path : empty_;
+  }
+
+  const std::string &get_project_name(long long project_id) const override {
+    const ProjectPathEntry *entry = find_entry(project_id);
+    return entry ? infos_[project_id].name : empty_;
+  }
+
+  std::span<const long long>
+  get_ancestor_ids(long long project_id) const override {
+    const ProjectPathEntry *entry = find_entry(project_id);
+    if (!entry)
+      return {};
+    return {ancestor_ids_.data() + entry->ancestors_begin, entry->depth};
+  }
+
 private:
+  // id 由 AUTOINCREMENT 分配，基本连续；超出上限的异常 id 不进入下标表
+  static constexpr long long kMaxProjectId = 1LL << 24;
+
   ProjectNameCache() = default;
+
+  bool store_info(long long id, ProjectInfo info) {
+    if (id <= 0 || id >= kMaxProjectId) {
+      std::cerr << "Ignoring project with out-of-range id " << id
+                << std::endl;
+      return false;
+    }
+    size_t slot = static_cast<size_t>(id);
+    if (slot >= infos_.size()) {
+      infos_.resize(slot + 1);
+      present_.resize(slot + 1, false);
+      entries_.resize(slot + 1);
+    }
+    infos_[slot] = std::move(info);
+    present_[slot] = true;
+    entries_[slot] = {};
+    return true;
+  }
+
+  bool has_info(long long id) const {
+    return id > 0 && static_cast<size_t>(id) < present_.size() &&
+           present_[static_cast<size_t>(id)];
+  }
+
+  const ProjectPathEntry *find_entry(long long id) const {
+    if (id <= 0 || static_cast<size_t>(id) >= entries_.size())
+      return nullptr;
+    const ProjectPathEntry &entry = entries_[static_cast<size_t>(id)];
+    return entry.depth > 0 ? &entry : nullptr;
+  }
+
+  // 沿父链向上找到第一个已物化的祖先 (或根)，再自上而下依次物化。
+  // 与原逐级查找语义一致：父 id 不存在时即视为根；出现环时在回到
+  // 链上节点处截断
+  void materialize(long long id) {
+    if (!has_info(id) || find_entry(id))
+      return;
+
+    std::vector<long long> chain;
+    long long curr = id;
+    while (has_info(curr) && !find_entry(curr)) {
+      if (std::find(chain.begin(), chain.end(), curr) != chain.end())
+        break;
+      chain.push_back(curr);
+      curr = infos_[curr].parent_id;
+    }
+
+    const ProjectPathEntry *parent = find_entry(curr);
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      ProjectPathEntry entry;
+      entry.ancestors_begin = static_cast<uint32_t>(ancestor_ids_.size());
+      if (parent) {
+        entry.joined_path = parent->joined_path + "_";
+        entry.depth = parent->depth + 1;
+        // 先复制父链再追加自身；保存偏移而非指针，扩容后仍有效
+        size_t begin = parent->ancestors_begin;
+        for (uint32_t i = 0; i < parent->depth; ++i) {
+          long long ancestor = ancestor_ids_[begin + i];
+          ancestor_ids_.push_back(ancestor);
+        }
+      } else {
+        entry.depth = 1;
+      }
+      entry.joined_path += infos_[*it].name;
+      ancestor_ids_.push_back(*it);
+
+      entries_[static_cast<size_t>(*it)] = std::move(entry);
+      parent = &entries_[static_cast<size_t>(*it)];
+    }
+  }
+
   bool loaded_ = false;
-  std::unordered_map<long long, ProjectInfo> cache_;
+  std::vector<ProjectInfo> infos_;
+  std::vector<bool> present_;
+  std::vector<ProjectPathEntry> entries_;
+  std::vector<long long> ancestor_ids_;
+  const std::string empty_;
 };
 
 #endif // REPORTS_DATA_CACHE_PROJECT_NAME_CACHE_HPP_
@@ -2,6 +2,7 @@
 #ifndef REPORTS_DATA_INTERFACES_I_PROJECT_INFO_PROVIDER_HPP_
 #define REPORTS_DATA_INTERFACES_I_PROJECT_INFO_PROVIDER_HPP_
 
+#include <span>
 #include <sqlite3.h>
 #include <string>
 #include <vector>
@@ -17,6 +18,18 @@ public:
   // 获取项目路径部分
   virtual std::vector<std::string>
   get_path_parts(long long project_id) const = 0;
+
+  // [新增] 以下查询均为下标访问，不分配内存；未知 id 返回空值
+
+  // 以 "_" 拼接的完整路径，如 "study_math"
+  virtual const std::string &get_joined_path(long long project_id) const = 0;
+
+  // 项目自身的名称 (路径最后一段)
+  virtual const std::string &get_project_name(long long project_id) const = 0;
+
+  // 从根到自身的项目 id 序列，长度即深度
+  virtual std::span<const long long>
+  get_ancestor_ids(long long project_id) const = 0;
 };
 
 #endif // REPORTS_DATA_INTERFACES_I_PROJECT_INFO_PROVIDER_HPP_
@@ -1,5 +1,6 @@
 ﻿// reports/data/queriers/daily/batch_day_data_fetcher.cpp
 #include "reports/data/queriers/daily/batch_day_data_fetcher.hpp"
+#include "common/utils/civil_time.hpp"
 #include <iostream>
 #include <stdexcept>
 
@@ -10,16 +11,6 @@ BatchDayDataFetcher::BatchDayDataFetcher(sqlite3 *db,
     throw std::invalid_argument("Database connection cannot be null.");
 }
 
-static std::string join_path_parts(const std::vector<std::string> &parts) {
-  if (parts.empty())
-    return "";
-  std::string path = parts[0];
-  for (size_t i = 1; i < parts.size(); ++i) {
-    path += "_" + parts[i];
-  }
-  return path;
-}
-
 BatchDataResult BatchDayDataFetcher::fetch_all_data() {
   BatchDataResult result;
 
@@ -62,12 +53,11 @@ void BatchDayDataFetcher::fetch_days_metadata(BatchDataResult &result) {
                                               "recreation_douyin_time"};
 
   while (sqlite3_step(stmt) == SQLITE_ROW) {
-    // ... (保持原逻辑不变) ...
-    const char *date_cstr =
-        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-    if (!date_cstr)
+    // [修改] date 列为天数，在此转换为展示用的 "YYYY-MM-DD"
+    if (sqlite3_column_type(stmt, 0) != SQLITE_INTEGER)
       continue;
-    std::string date(date_cstr);
+    std::string date =
+        TimeUtils::FormatDayNumber(sqlite3_column_int64(stmt, 0));
     int year = sqlite3_column_int(stmt, 1);
     int month = sqlite3_column_int(stmt, 2);
     result.date_order.emplace_back(date, year, month);
@@ -103,33 +93,41 @@ void BatchDayDataFetcher::fetch_time_records(BatchDataResult &result) {
   // auto& cache = ProjectNameCache::instance(); -> 移除
   std::map<std::string, std::map<long long, long long>> temp_aggregation;
 
+  // [修改] 记录按 date 排序，同一天只格式化并查找一次
+  long long current_day = 0;
+  std::string date;
+  DailyReportData *data_ptr = nullptr;
+
   while (sqlite3_step(stmt) == SQLITE_ROW) {
-    const char *date_cstr =
-        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-    if (!date_cstr)
+    if (sqlite3_column_type(stmt, 0) != SQLITE_INTEGER)
       continue;
-    std::string date(date_cstr);
-
-    auto it = result.data_map.find(date);
-    if (it == result.data_map.end())
+    const long long day_number = sqlite3_column_int64(stmt, 0);
+    if (date.empty() || day_number != current_day) {
+      current_day = day_number;
+      date = TimeUtils::FormatDayNumber(day_number);
+      auto it = result.data_map.find(date);
+      data_ptr = it == result.data_map.end() ? nullptr : &it->second;
+    }
+    if (!data_ptr)
       continue;
 
-    DailyReportData &data = it->second;
+    DailyReportData &data = *data_ptr;
 
     TimeRecord record;
-    record.start_time_ =
-        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
-    record.end_time_ =
-        reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
+    record.start_minute_ = sqlite3_column_type(stmt, 1) == SQLITE_NULL
+                               ? -1
+                               : sqlite3_column_int(stmt, 1);
+    record.end_minute_ = sqlite3_column_type(stmt, 2) == SQLITE_NULL
+                             ? -1
+                             : sqlite3_column_int(stmt, 2);
     long long project_id = sqlite3_column_int64(stmt, 3);
     record.duration_seconds_ = sqlite3_column_int64(stmt, 4);
     const unsigned char *ar = sqlite3_column_text(stmt, 5);
     if (ar)
       record.activity_remark_ = reinterpret_cast<const char *>(ar);
 
-    // [修改] 使用 provider_.get_path_parts
-    std::vector<std::string> parts = provider_.get_path_parts(project_id);
-    record.project_path_ = join_path_parts(parts);
+    // [修改] 使用 provider_ 的物化路径，不再逐条拆分再拼接
+    record.project_path_ = provider_.get_joined_path(project_id);
 
     data.detailed_records_.push_back(record);
     data.total_duration_ += record.duration_seconds_;
@@ -6,17 +6,6 @@
 #include <string>
 #include <vector>
 
-// 辅助函数：将路径部分拼接为字符串
-static std::string join_path_parts(const std::vector<std::string> &parts) {
-  if (parts.empty())
-    return "";
-  std::string path = parts[0];
-  for (size_t i = 1; i < parts.size(); ++i) {
-    path += "_" + parts[i];
-  }
-  return path;
-}
-
 DayQuerier::DayQuerier(IReportRepository &repo, const std::string &date)
     : BaseQuerier(repo, date) {}
 
@@ -46,8 +35,7 @@ DailyReportData DayQuerier::fetch_data() {
     for (auto &record : raw_records) {
       try {
         long long pid = std::stoll(record.project_path_);
-        std::vector<std::string> parts = name_cache.get_path_parts(pid);
-        record.project_path_ = join_path_parts(parts);
+        record.project_path_ = name_cache.get_joined_path(pid);
       } catch (...) {
         // 转换失败则保留原 ID
       }
@@ -0,0 +1,216 @@
+﻿// reports/data/utils/period_rollup_engine.cpp
+#include "reports/data/utils/period_rollup_engine.hpp"
+#include "common/utils/civil_time.hpp"
+#include <algorithm>
+#include <format>
+
+namespace {
+
+struct PeriodSpan {
+  int year;
+  int index;
+  long long first_day;
+  long long last_day;
+};
+
+// month 可为 13，表示下一年的 1 月
+long long month_begin(int year, int month) {
+  return month > 12 ? TimeUtils::DaysFromCivil(year + 1, month - 12, 1)
+                    : TimeUtils::DaysFromCivil(year, month, 1);
+}
+
+// 连续 months 个月的周期，first_month 为周期的第一个月
+PeriodSpan month_span(int year, int index, int first_month, int months) {
+  return {year, index, month_begin(year, first_month),
+          month_begin(year, first_month + months) - 1};
+}
+
+long long iso_year_first_monday(int iso_year) {
+  return TimeUtils::IsoWeekFromDays(TimeUtils::DaysFromCivil(iso_year, 1, 4))
+      .monday_days_;
+}
+
+// [修改] 由 (年, 序号) 求周期的首末日；历史汇总与单期报表共用
+PeriodSpan span_of_index(ReportPeriod period, int year, int index) {
+  switch (period) {
+  case ReportPeriod::Week: {
+    const long long first = iso_year_first_monday(year) + (index - 1) * 7LL;
+    return {year, index, first, first + 6};
+  }
+  case ReportPeriod::BiWeek: {
+    // 第 2k-1、2k 周为第 k 个双周；53 周年份的最后一个双周只有一周
+    const long long first = iso_year_first_monday(year) + (index - 1) * 14LL;
+    const long long year_last = iso_year_first_monday(year + 1) - 1;
+    return {year, index, first, std::min(first + 13, year_last)};
+  }
+  case ReportPeriod::Month:
+    return month_span(year, index, index, 1);
+  case ReportPeriod::Quarter:
+    return month_span(year, index, index * 3 - 2, 3);
+  case ReportPeriod::HalfYear:
+    return month_span(year, index, index * 6 - 5, 6);
+  case ReportPeriod::Year:
+  default:
+    return month_span(year, 0, 1, 12);
+  }
+}
+
+PeriodSpan span_of(ReportPeriod period, const TimeUtils::CivilDate &date,
+                   const TimeUtils::IsoWeek &iso) {
+  switch (period) {
+  case ReportPeriod::Week:
+    return {iso.year_, iso.week_, iso.monday_days_, iso.monday_days_ + 6};
+  case ReportPeriod::BiWeek:
+    return span_of_index(period, iso.year_, (iso.week_ + 1) / 2);
+  case ReportPeriod::Month:
+    return span_of_index(period, date.year_, date.month_);
+  case ReportPeriod::Quarter:
+    return span_of_index(period, date.year_, (date.month_ - 1) / 3 + 1);
+  case ReportPeriod::HalfYear:
+    return span_of_index(period, date.year_, date.month_ <= 6 ? 1 : 2);
+  case ReportPeriod::Year:
+  default:
+    return span_of_index(period, date.year_, 0);
+  }
+}
+
+// 各粒度序号的上限 (年报为 0)；周 / 双周取决于该 ISO 周年的周数
+int index_count(ReportPeriod period, int year) {
+  switch (period) {
+  case ReportPeriod::Week:
+  case ReportPeriod::BiWeek: {
+    const long long weeks =
+        (iso_year_first_monday(year + 1) - iso_year_first_monday(year)) / 7;
+    return static_cast<int>(period == ReportPeriod::Week ? weeks
+                                                         : (weeks + 1) / 2);
+  }
+  case ReportPeriod::Month:
+    return 12;
+  case ReportPeriod::Quarter:
+    return 4;
+  case ReportPeriod::HalfYear:
+    return 2;
+  case ReportPeriod::Year:
+  default:
+    return 0;
+  }
+}
+
+std::string period_key(ReportPeriod period, int year, int index) {
+  switch (period) {
+  case ReportPeriod::Week:
+    return std::format("{:04d}-W{:02d}", year, index);
+  case ReportPeriod::BiWeek:
+    return std::format("{:04d}-B{:02d}", year, index);
+  case ReportPeriod::Month:
+    return std::format("{:04d}-{:02d}", year, index);
+  case ReportPeriod::Quarter:
+    return std::format("{:04d}-Q{}", year, index);
+  case ReportPeriod::HalfYear:
+    return std::format("{:04d}-H{}", year, index);
+  case ReportPeriod::Year:
+  default:
+    return std::format("{:04d}", year);
+  }
+}
+
+std::string format_day_number(long long days) {
+  const TimeUtils::CivilDate date = TimeUtils::CivilFromDays(days);
+  return std::format("{:04d}-{:02d}-{:02d}", date.year_, date.month_,
+                     date.day_);
+}
+
+void fill_bucket(ReportPeriod period, const PeriodSpan &span,
+                 PeriodBucket &bucket) {
+  bucket.key_ = period_key(period, span.year, span.index);
+  bucket.year_ = span.year;
+  bucket.index_ = span.index;
+  bucket.start_date_ = format_day_number(span.first_day);
+  bucket.end_date_ = format_day_number(span.last_day);
+  bucket.covered_days_ = static_cast<int>(span.last_day - span.first_day + 1);
+}
+
+} // namespace
+
+bool PeriodRollupEngine::describe(ReportPeriod period, int year, int index,
+                                  PeriodBucket &bucket) {
+  if (year < 1 || year > 9999) {
+    return false;
+  }
+  const int count = index_count(period, year);
+  if (count == 0 ? index != 0 : (index < 1 || index > count)) {
+    return false;
+  }
+  fill_bucket(period, span_of_index(period, year, index), bucket);
+  return true;
+}
+
+PeriodRollupEngine::PeriodRollupEngine(
+    const std::vector<ReportPeriod> &periods) {
+  for (ReportPeriod period : periods) {
+    const bool duplicated =
+        std::any_of(slots_.begin(), slots_.end(),
+                    [&](const Slot &slot) { return slot.period == period; });
+    if (!duplicated) {
+      slots_.push_back({period, {}, nullptr});
+    }
+  }
+}
+
+void PeriodRollupEngine::enter_day(const std::string &date) {
+  current_date_ = date;
+  TimeUtils::CivilDate civil;
+  current_date_valid_ = TimeUtils::ParseCivilDate(date, civil);
+  if (!current_date_valid_) {
+    return;
+  }
+
+  const long long days =
+      TimeUtils::DaysFromCivil(civil.year_, civil.month_, civil.day_);
+  const TimeUtils::IsoWeek iso = TimeUtils::IsoWeekFromDays(days);
+
+  for (Slot &slot : slots_) {
+    const PeriodSpan span = span_of(slot.period, civil, iso);
+    auto [it, inserted] =
+        slot.buckets.try_emplace({span.year, span.index}, Accumulator{});
+    Accumulator &acc = it->second;
+    if (inserted) {
+      fill_bucket(slot.period, span, acc.bucket);
+    }
+    // 每个日期只进入一次，故此处即为该周期新增的一个活跃日
+    ++acc.bucket.active_days_;
+    slot.current = &acc;
+  }
+}
+
+void PeriodRollupEngine::add(const DailyProjectDuration &row) {
+  if (row.date_ != current_date_) {
+    enter_day(row.date_);
+  }
+  if (!current_date_valid_) {
+    return;
+  }
+  for (Slot &slot : slots_) {
+    slot.current->durations[row.project_id_] += row.duration_;
+    slot.current->bucket.total_duration_ += row.duration_;
+  }
+}
+
+std::vector<PeriodBucket> PeriodRollupEngine::take(ReportPeriod period) {
+  std::vector<PeriodBucket> result;
+  for (Slot &slot : slots_) {
+    if (slot.period != period) {
+      continue;
+    }
+    result.reserve(slot.buckets.size());
+    for (auto &[key, acc] : slot.buckets) {
+      acc.bucket.project_stats_.assign(acc.durations.begin(),
+                                       acc.durations.end());
+      result.push_back(std::move(acc.bucket));
+    }
+    slot.buckets.clear();
+    slot.current = nullptr;
+    current_date_.clear();
+  }
+  return result;
+}
@@ -0,0 +1,74 @@
+﻿// reports/data/utils/period_rollup_engine.hpp
+#ifndef REPORTS_DATA_UTILS_PERIOD_ROLLUP_ENGINE_HPP_
+#define REPORTS_DATA_UTILS_PERIOD_ROLLUP_ENGINE_HPP_
+
+#include "core/domain/types/report_period.hpp"
+#include "reports/domain/model/period_comparison.hpp"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 一个周期的汇总结果
+struct PeriodBucket {
+  // 周期键，格式见 ReportPeriod
+  std::string key_;
+  // 周 / 双周为 ISO 周年
+  int year_ = 0;
+  // 周序号、双周序号、月、季度或半年 (从 1 开始)；年报为 0
+  int index_ = 0;
+
+  // 闭区间 (YYYY-MM-DD) 及其包含的自然天数
+  std::string start_date_;
+  std::string end_date_;
+  int covered_days_ = 0;
+
+  int active_days_ = 0;
+  long long total_duration_ = 0;
+  std::vector<std::pair<long long, long long>> project_stats_;
+};
+
+/**
+ * @class PeriodRollupEngine
+ * @brief 单次遍历的多粒度汇总。
+ *
+ * 每行 (日期, 项目, 时长) 只解析一次日期，随后同时累加到所有已配置粒度
+ * 的当前周期中。要求行按日期升序到达 (同一天的行连续)，据此统计活跃天数。
+ */
+class PeriodRollupEngine {
+public:
+  explicit PeriodRollupEngine(const std::vector<ReportPeriod> &periods);
+
+  void add(const DailyProjectDuration &row);
+
+  // 取出某一粒度的全部周期，按时间升序；未配置的粒度返回空
+  std::vector<PeriodBucket> take(ReportPeriod period);
+
+  // [新增] 按 (年, 序号) 填写周期键与区间 (不含统计)，与汇总时的划分一致；
+  // 年报序号为 0。序号超出该年范围时返回 false
+  static bool describe(ReportPeriod period, int year, int index,
+                       PeriodBucket &bucket);
+
+private:
+  struct Accumulator {
+    PeriodBucket bucket;
+    std::unordered_map<long long, long long> durations;
+  };
+
+  struct Slot {
+    ReportPeriod period;
+    // (年, 序号) -> 累加器；map 节点地址稳定，current 可长期持有
+    std::map<std::pair<int, int>, Accumulator> buckets;
+    Accumulator *current = nullptr;
+  };
+
+  // 日期变化时为每个粒度定位 (必要时创建) 当前周期
+  void enter_day(const std::string &date);
+
+  std::vector<Slot> slots_;
+  std::string current_date_;
+  bool current_date_valid_ = false;
+};
+
+#endif // REPORTS_DATA_UTILS_PERIOD_ROLLUP_ENGINE_HPP_
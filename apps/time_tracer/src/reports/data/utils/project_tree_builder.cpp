@@ -1,61 +1,111 @@
 ﻿// reports/data/utils/project_tree_builder.cpp
 #include "reports/data/utils/project_tree_builder.hpp"
-#include "common/utils/string_utils.hpp"
+#include <algorithm>
 
-void build_project_tree_from_records(
-    reporting::ProjectTree &tree,
-    const std::vector<std::pair<std::string, long long>> &records) {
-  // ... 保持不变 ...
-  for (const auto &record : records) {
-    const std::string &project_path = record.first;
-    long long duration = record.second;
-
-    // 拆分路径
-    auto parts = SplitString(
-        project_path, '/'); // Assuming full_path was meant to be project_path
-    if (parts.empty())
-      continue; // Corrected typo from return;tinue;
-
-    std::string top_level_category_key = parts[0];
-    tree[top_level_category_key].duration += duration;
-
-    reporting::ProjectNode *current_node = &tree[top_level_category_key];
-
-    for (size_t i = 1; i < parts.size(); ++i) {
-      current_node->children[parts[i]].duration += duration;
-      current_node = &current_node->children[parts[i]];
-    }
+namespace {
+
+constexpr uint32_t kNoSlot = UINT32_MAX;
+
+// 项目 ID -> 节点下标的暂存表，按线程复用；每次构建后只清理用过的槽位，
+// 因此开销与本次树的节点数成正比，而非与项目总数成正比
+thread_local std::vector<uint32_t> t_slot_by_id;
+
+uint32_t &slot_for(long long project_id) {
+  size_t index = static_cast<size_t>(project_id);
+  if (index >= t_slot_by_id.size()) {
+    t_slot_by_id.resize(index + 1, kNoSlot);
   }
+  return t_slot_by_id[index];
+}
+
+void sort_by_duration(std::vector<uint32_t>::iterator first,
+                      std::vector<uint32_t>::iterator last,
+                      const std::vector<reporting::ProjectNode> &nodes) {
+  std::sort(first, last, [&](uint32_t a, uint32_t b) {
+    if (nodes[a].duration != nodes[b].duration) {
+      return nodes[a].duration > nodes[b].duration;
+    }
+    return nodes[a].name < nodes[b].name;
+  });
 }
 
-// [修改] 实现变更
+} // namespace
+
 void build_project_tree_from_ids(
     reporting::ProjectTree &tree,
     const std::vector<std::pair<long long, long long>> &id_records,
-    const IProjectInfoProvider &provider) // [修改] 参数
-{
-  // 1. 移除 ensure_loaded 调用，假设传入的 provider 已经是可用的
-  // 或者由调用者(Service)负责 ensure_loaded
-
-  // 2. 遍历聚合后的 ID 记录
-  for (const auto &record : id_records) {
-    long long project_id = record.first;
-    long long duration = record.second;
-
-    // [修改] 使用 provider 接口调用
-    std::vector<std::string> parts = provider.get_path_parts(project_id);
-    if (parts.empty())
+    const IProjectInfoProvider &provider) {
+  using reporting::ProjectNode;
+  using reporting::ProjectTree;
+
+  tree.nodes.clear();
+  tree.children.clear();
+  tree.roots.clear();
+
+  // 1. 沿祖先链 (根→自身) 建节点，时长只记在记录所属的节点上。
+  //    链上父节点总先于子节点创建，因此父下标 < 子下标
+  for (const auto &[project_id, duration] : id_records) {
+    std::span<const long long> ancestors =
+        provider.get_ancestor_ids(project_id);
+    if (ancestors.empty())
       continue;
 
-    // 3. 构建树
-    std::string top_level_category_key = parts[0];
-    tree[top_level_category_key].duration += duration;
+    uint32_t parent = ProjectTree::kNoParent;
+    for (long long ancestor_id : ancestors) {
+      uint32_t &slot = slot_for(ancestor_id);
+      if (slot == kNoSlot) {
+        slot = static_cast<uint32_t>(tree.nodes.size());
+        ProjectNode node;
+        node.project_id = ancestor_id;
+        node.name = provider.get_project_name(ancestor_id);
+        node.parent = parent;
+        tree.nodes.push_back(std::move(node));
+      }
+      parent = slot;
+    }
+    tree.nodes[parent].duration += duration;
+  }
+
+  for (const ProjectNode &node : tree.nodes) {
+    t_slot_by_id[static_cast<size_t>(node.project_id)] = kNoSlot;
+  }
 
-    reporting::ProjectNode *current_node = &tree[top_level_category_key];
+  // 2. 自底向上一次线性汇总：逆序遍历时子节点总在父节点之前
+  for (size_t i = tree.nodes.size(); i-- > 0;) {
+    const ProjectNode &node = tree.nodes[i];
+    if (node.parent != ProjectTree::kNoParent) {
+      tree.nodes[node.parent].duration += node.duration;
+    }
+  }
 
-    for (size_t i = 1; i < parts.size(); ++i) {
-      current_node->children[parts[i]].duration += duration;
-      current_node = &current_node->children[parts[i]];
+  // 3. 生成 CSR：先计数得到各区间起点，再按下标回填
+  for (ProjectNode &node : tree.nodes) {
+    if (node.parent != ProjectTree::kNoParent) {
+      tree.nodes[node.parent].children_count++;
     }
   }
+  uint32_t offset = 0;
+  for (ProjectNode &node : tree.nodes) {
+    node.children_begin = offset;
+    offset += node.children_count;
+  }
+  tree.children.resize(offset);
+
+  std::vector<uint32_t> filled(tree.nodes.size(), 0);
+  for (uint32_t i = 0; i < tree.nodes.size(); ++i) {
+    uint32_t parent = tree.nodes[i].parent;
+    if (parent == ProjectTree::kNoParent) {
+      tree.roots.push_back(i);
+    } else {
+      ProjectNode &p = tree.nodes[parent];
+      tree.children[p.children_begin + filled[parent]++] = i;
+    }
+  }
+
+  // 4. 一次性排好展示顺序，格式化时直接使用
+  sort_by_duration(tree.roots.begin(), tree.roots.end(), tree.nodes);
+  for (const ProjectNode &node : tree.nodes) {
+    auto first = tree.children.begin() + node.children_begin;
+    sort_by_duration(first, first + node.children_count, tree.nodes);
+  }
 }
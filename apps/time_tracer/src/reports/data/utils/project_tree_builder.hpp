@@ -8,12 +8,8 @@
 #include <string>
 #include <vector>
 
-// [修改] 移除 REPORTS_DATA_API 宏，直接声明函数
-void build_project_tree_from_records(
-    reporting::ProjectTree &tree,
-    const std::vector<std::pair<std::string, long long>> &records);
-
-// [修改] 移除 REPORTS_DATA_API 宏，直接声明函数
+// [修改] 按项目 ID 构建扁平树：沿物化祖先链建节点，自底向上一次线性
+// 汇总时长，最后生成按时长排序的 CSR 子节点数组。tree 会被整体重置
 void build_project_tree_from_ids(
     reporting::ProjectTree &tree,
     const std::vector<std::pair<long long, long long>> &id_records,
@@ -9,8 +9,9 @@
 #include <vector>
 
 struct TimeRecord {
-  std::string start_time_;
-  std::string end_time_;
+  // [修改] 数据库存当日分钟数，格式化时再转 "HH:MM" (-1 表示缺失)
+  int start_minute_ = -1;
+  int end_minute_ = -1;
   std::string project_path_;
   long long duration_seconds_ = 0;
   std::optional<std::string> activity_remark_;
@@ -0,0 +1,57 @@
+﻿// reports/domain/model/period_comparison.hpp
+#ifndef REPORTS_DOMAIN_MODEL_PERIOD_COMPARISON_HPP_
+#define REPORTS_DOMAIN_MODEL_PERIOD_COMPARISON_HPP_
+
+#include <string>
+#include <vector>
+
+// [新增] 环比 / 同比报表使用的数据模型
+
+// 闭区间 [start_date_, end_date_] (YYYY-MM-DD)
+struct DateWindow {
+  std::string start_date_;
+  std::string end_date_;
+};
+
+// 按 (日期, 项目) 汇总的一行时长，供 Service 层一次遍历分桶
+struct DailyProjectDuration {
+  std::string date_;
+  long long project_id_ = 0;
+  long long duration_ = 0;
+};
+
+enum class ComparisonKind {
+  PreviousPeriod,     // 环比：紧邻的上一周期
+  SamePeriodLastYear, // 同比：去年同期
+};
+
+// 单个项目 (含其所有子项目汇总) 在本期与对照期的时长
+struct ProjectDelta {
+  long long project_id_ = 0;
+  std::string name_;
+  // 0 表示顶层项目
+  int depth_ = 0;
+  long long current_duration_ = 0;
+  long long baseline_duration_ = 0;
+
+  long long delta() const { return current_duration_ - baseline_duration_; }
+};
+
+struct PeriodComparison {
+  ComparisonKind kind_ = ComparisonKind::PreviousPeriod;
+
+  // 对照期的标题，例如 "vs 2025-02"
+  std::string label_;
+
+  std::string start_date_;
+  std::string end_date_;
+
+  // 对照期的活跃天数与总时长
+  int actual_active_days_ = 0;
+  long long total_duration_ = 0;
+
+  // 按本期时长降序；父项目在子项目之前
+  std::vector<ProjectDelta> project_deltas_;
+};
+
+#endif // REPORTS_DOMAIN_MODEL_PERIOD_COMPARISON_HPP_
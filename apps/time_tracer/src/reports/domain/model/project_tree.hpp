@@ -2,23 +2,41 @@
 #ifndef REPORTS_DOMAIN_MODEL_PROJECT_TREE_HPP_
 #define REPORTS_DOMAIN_MODEL_PROJECT_TREE_HPP_
 
+#include <cstdint>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace reporting {
 
+// [修改] 扁平化的项目树节点，按项目 ID 建立，不再以名称字符串为键
 struct ProjectNode {
+  long long project_id = 0;
+  std::string name;
   long long duration = 0;
-  // 使用 unordered_map 提升构建速度
-  // 在生成报告时（如 ProjectTreeFormatter），
-  // 程序显式地按 duration（时长）进行了重新排序。
-  // 这意味着 std::map 在构建时的排序工作是完全浪费的。
-  // 改用 std::unordered_map
-  // 插入和查找的平均时间复杂度从 O(log N) 降低到 O(1)。
-  std::unordered_map<std::string, ProjectNode> children;
+  // 父节点在 ProjectTree::nodes 中的下标，顶层节点为 kNoParent
+  uint32_t parent = 0;
+  // 子节点在 ProjectTree::children 中的区间 [children_begin, +count)
+  uint32_t children_begin = 0;
+  uint32_t children_count = 0;
 };
 
-using ProjectTree = std::unordered_map<std::string, ProjectNode>;
+// [修改] 扁平项目树：节点连续存放，父节点下标总小于子节点；
+// 子节点以 CSR 数组排列。构建时已按时长降序 (同时长按名称) 排好，
+// 格式化器直接按此顺序遍历，无需再排序
+struct ProjectTree {
+  static constexpr uint32_t kNoParent = UINT32_MAX;
+
+  std::vector<ProjectNode> nodes;
+  std::vector<uint32_t> children;
+  std::vector<uint32_t> roots;
+
+  bool empty() const { return roots.empty(); }
+
+  std::span<const uint32_t> children_of(const ProjectNode &node) const {
+    return {children.data() + node.children_begin, node.children_count};
+  }
+};
 
 } // namespace reporting
 
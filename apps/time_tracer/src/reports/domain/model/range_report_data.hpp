@@ -2,6 +2,7 @@
 #ifndef REPORTS_DOMAIN_MODEL_RANGE_REPORT_DATA_HPP_
 #define REPORTS_DOMAIN_MODEL_RANGE_REPORT_DATA_HPP_
 
+#include "reports/domain/model/period_comparison.hpp"
 #include "reports/domain/model/project_tree.hpp"
 #include <string>
 #include <vector>
@@ -31,6 +32,9 @@ struct RangeReportData {
   // 构建好的项目树 (包含层级结构和时长)
   // 这是格式化器 (Formatter) 生成报告时的主要数据源
   reporting::ProjectTree project_tree_;
+
+  // [新增] 环比 / 同比对照期；普通范围报表为空，格式化器据此决定是否渲染
+  std::vector<PeriodComparison> comparisons_;
 };
 
 #endif // REPORTS_DOMAIN_MODEL_RANGE_REPORT_DATA_HPP_
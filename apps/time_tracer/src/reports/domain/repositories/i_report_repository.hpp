@@ -3,6 +3,8 @@
 #define REPORTS_DOMAIN_REPOSITORIES_I_REPORT_REPOSITORY_HPP_
 
 #include "reports/domain/model/daily_report_data.hpp"
+#include "reports/domain/model/period_comparison.hpp"
+#include <functional>
 #include <map>
 #include <string>
 #include <tuple>
@@ -28,6 +30,21 @@ public:
   virtual int get_actual_active_days(const std::string &start_date,
                                      const std::string &end_date) = 0;
 
+  // [新增] 前缀和索引上的区间查询，每个项目两次查找。
+  // 索引不可用或日期无法解析时返回 false，调用方改用上面的通用方法
+  virtual bool get_prefix_project_stats(
+      const std::string &start_date, const std::string &end_date,
+      std::vector<std::pair<long long, long long>> &result) = 0;
+  virtual bool get_prefix_active_days(const std::string &start_date,
+                                      const std::string &end_date,
+                                      int &result) = 0;
+
+  // [新增] 对照报表：一次查询取回落在任一窗口内的 (日期, 项目) 时长，
+  // 按日期升序，由调用方分桶
+  virtual std::vector<DailyProjectDuration>
+  get_daily_project_stats_in_windows(
+      const std::vector<DateWindow> &windows) = 0;
+
   // --- 批量导出支持 ---
 
   // Daily Bulk
@@ -35,29 +52,20 @@ public:
   virtual std::vector<std::pair<std::string, TimeRecord>>
   get_all_time_records_with_date() = 0;
 
-  // Monthly Bulk Optimization
-  // 返回 map<"YYYY-MM", vector<pair<projectId, duration>>>
-  virtual std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_months_project_stats() = 0;
-
-  // 返回 map<"YYYY-MM", actual_days>
-  virtual std::map<std::string, int> get_all_months_active_days() = 0;
-
-  // [新增] Weekly Bulk Optimization
-  // 返回 map<"YYYY-Www", vector<pair<projectId, duration>>>
-  virtual std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_weeks_project_stats() = 0;
-
-  // 返回 map<"YYYY-Www", actual_days>
-  virtual std::map<std::string, int> get_all_weeks_active_days() = 0;
-
-  // [新增] Yearly Bulk Optimization
-  // 返回 map<"YYYY", vector<pair<projectId, duration>>>
-  virtual std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_years_project_stats() = 0;
+  // [新增] Daily Windowed (流式导出按窗口读取，闭区间 [start, end])
+  // 返回有时间记录的所有月份 "YYYY-MM"，升序
+  virtual std::vector<std::string> get_all_record_months() = 0;
+  virtual std::map<std::string, DailyReportData>
+  get_days_metadata_in_range(const std::string &start_date,
+                             const std::string &end_date) = 0;
+  virtual std::vector<std::pair<std::string, TimeRecord>>
+  get_time_records_with_date_in_range(const std::string &start_date,
+                                      const std::string &end_date) = 0;
 
-  // 返回 map<"YYYY", actual_days>
-  virtual std::map<std::string, int> get_all_years_active_days() = 0;
+  // [新增] 通用周期汇总的数据源：按日期升序逐行回调全部 (日期, 项目) 时长，
+  // 不在内存中物化结果。历史周 / 月 / 年报表均由此经 PeriodRollupEngine 汇总
+  virtual void for_each_daily_project_stats(
+      const std::function<void(const DailyProjectDuration &)> &visitor) = 0;
 };
 
 #endif // REPORTS_DOMAIN_REPOSITORIES_I_REPORT_REPOSITORY_HPP_
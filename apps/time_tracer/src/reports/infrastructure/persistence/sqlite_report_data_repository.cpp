@@ -4,72 +4,188 @@
 #include <stdexcept>
 #include <vector>
 
+#include "common/utils/civil_time.hpp"
+#include "core/infrastructure/persistence/schema_migrator.hpp"
 #include "reports/data/cache/project_name_cache.hpp"
 
-SqliteReportDataRepository::SqliteReportDataRepository(sqlite3 *db) : db_(db) {
+namespace {
+
+// 引入 project_rollups / period_active_days 的模式版本 (见 SchemaMigrator)
+constexpr int kRollupSchemaVersion = 2;
+// 引入 project_prefix_sums / active_day_prefix 的模式版本
+constexpr int kPrefixSumSchemaVersion = 3;
+
+// "YYYY-MM-DD" -> 1970-01-01 起的天数 (与 RollupStore 的 day_number 一致)
+// 月报以 "YYYY-MM-31" 作结束日，按字符串比较它落在该月末与下月初之间；
+// 为保持同样的区间语义，超出当月天数的日期按月末 (+1 若作为起始日) 处理
+bool to_day_number(const std::string &date, bool is_range_end,
+                   long long &day_number) {
+  TimeUtils::CivilDate civil;
+  if (!TimeUtils::ParseCivilDate(date, civil))
+    return false;
+  const long long month_begin =
+      TimeUtils::DaysFromCivil(civil.year_, civil.month_, 1);
+  const long long next_month_begin =
+      civil.month_ == 12 ? TimeUtils::DaysFromCivil(civil.year_ + 1, 1, 1)
+                         : TimeUtils::DaysFromCivil(civil.year_,
+                                                    civil.month_ + 1, 1);
+  day_number = month_begin + civil.day_ - 1;
+  if (day_number >= next_month_begin) {
+    day_number = is_range_end ? next_month_begin - 1 : next_month_begin;
+  }
+  return true;
+}
+
+// [新增] time_records / days 的 date 列为天数 (v4)，project_rollups.period
+// 仍为文本。等值查询要求合法日期，否则绑定 NULL，不匹配任何行
+void bind_day_key(sqlite3_stmt *stmt, int index, const std::string &date) {
+  long long day_number = 0;
+  if (TimeUtils::ParseDayNumber(date, day_number)) {
+    sqlite3_bind_int64(stmt, index, day_number);
+  } else {
+    sqlite3_bind_null(stmt, index);
+  }
+}
+
+// 闭区间 [start_date, end_date] 绑定到 ?first_index 与 ?first_index + 1；
+// text_keys 为 true 时按 period 文本比较，否则换算为天数
+void bind_date_range(sqlite3_stmt *stmt, int first_index,
+                     const std::string &start_date,
+                     const std::string &end_date, bool text_keys) {
+  if (text_keys) {
+    sqlite3_bind_text(stmt, first_index, start_date.c_str(), -1,
+                      SQLITE_STATIC);
+    sqlite3_bind_text(stmt, first_index + 1, end_date.c_str(), -1,
+                      SQLITE_STATIC);
+    return;
+  }
+  long long start_day = 0;
+  long long end_day = 0;
+  if (to_day_number(start_date, false, start_day) &&
+      to_day_number(end_date, true, end_day)) {
+    sqlite3_bind_int64(stmt, first_index, start_day);
+    sqlite3_bind_int64(stmt, first_index + 1, end_day);
+  } else {
+    sqlite3_bind_null(stmt, first_index);
+    sqlite3_bind_null(stmt, first_index + 1);
+  }
+}
+
+// 读取日期列：天数转为 "YYYY-MM-DD"，period 文本原样返回，NULL 返回空串
+std::string read_date_key(sqlite3_stmt *stmt, int column) {
+  switch (sqlite3_column_type(stmt, column)) {
+  case SQLITE_INTEGER:
+    return TimeUtils::FormatDayNumber(sqlite3_column_int64(stmt, column));
+  case SQLITE_NULL:
+    return {};
+  default:
+    return reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+  }
+}
+
+// 当日分钟数，NULL 记为 -1
+int read_minute(sqlite3_stmt *stmt, int column) {
+  return sqlite3_column_type(stmt, column) == SQLITE_NULL
+             ? -1
+             : sqlite3_column_int(stmt, column);
+}
+
+// days.date 的声明类型；旧版 (v4 之前) 为 TEXT
+bool has_text_date_keys(sqlite3 *db) {
+  sqlite3_stmt *stmt = nullptr;
+  bool text_keys = false;
+  if (sqlite3_prepare_v2(db,
+                         "SELECT upper(type) <> 'INTEGER' "
+                         "FROM pragma_table_info('days') WHERE name = 'date';",
+                         -1, &stmt, nullptr) == SQLITE_OK &&
+      sqlite3_step(stmt) == SQLITE_ROW) {
+    text_keys = sqlite3_column_int(stmt, 0) != 0;
+  }
+  sqlite3_finalize(stmt);
+  return text_keys;
+}
+
+} // namespace
+
+SqliteReportDataRepository::SqliteReportDataRepository(sqlite3 *db)
+    : db_(db), statements_(db, kQueryCount) {
   if (!db_)
     throw std::invalid_argument("Database connection cannot be null.");
 
   // 核心修复：确保项目名称缓存已加载
   ProjectNameCache::instance().ensure_loaded(db_);
+
+  // [新增] 查询均按整数日期编写。旧库在打开时已自动升级 (见 DBManager)，
+  // 仍为 TEXT 日期说明升级未能执行 (例如文件只读)，此时拒绝而不是读错数据
+  if (has_text_date_keys(db_))
+    throw std::runtime_error(
+        "Database uses the legacy text date schema and could not be "
+        "upgraded on open; make the file writable and run the command "
+        "again.");
+
+  const int version = SchemaMigrator::get_version(db_);
+  rollups_ready_ = version >= kRollupSchemaVersion;
+  prefix_sums_ready_ = version >= kPrefixSumSchemaVersion;
+}
+
+StatementCache::Stats
+SqliteReportDataRepository::get_statement_cache_stats() const {
+  return statements_.get_stats();
 }
 
 // --- Single Query Methods ---
+// [修改] 语句由 StatementCache 持有，每次调用只 reset + rebind
 
 DayMetadata
 SqliteReportDataRepository::get_day_metadata(const std::string &date) {
   DayMetadata metadata;
-  sqlite3_stmt *stmt;
-  std::string sql = "SELECT status, sleep, remark, getup_time, exercise FROM "
-                    "days WHERE date = ?;";
-
-  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, date.c_str(), -1, SQLITE_STATIC);
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-      metadata.status_ = std::to_string(sqlite3_column_int(stmt, 0));
-      metadata.sleep_ = std::to_string(sqlite3_column_int(stmt, 1));
-      const unsigned char *r = sqlite3_column_text(stmt, 2);
+  auto stmt = statements_.acquire(
+      kDayMetadata, "SELECT status, sleep, remark, getup_time, exercise FROM "
+                    "days WHERE date = ?;");
+
+  if (stmt) {
+    bind_day_key(stmt.get(), 1, date);
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      metadata.status_ = std::to_string(sqlite3_column_int(stmt.get(), 0));
+      metadata.sleep_ = std::to_string(sqlite3_column_int(stmt.get(), 1));
+      const unsigned char *r = sqlite3_column_text(stmt.get(), 2);
       if (r)
         metadata.remark_ = reinterpret_cast<const char *>(r);
-      const unsigned char *g = sqlite3_column_text(stmt, 3);
+      const unsigned char *g = sqlite3_column_text(stmt.get(), 3);
       if (g)
         metadata.getup_time_ = reinterpret_cast<const char *>(g);
-      metadata.exercise_ = std::to_string(sqlite3_column_int(stmt, 4));
+      metadata.exercise_ = std::to_string(sqlite3_column_int(stmt.get(), 4));
     }
   }
-  sqlite3_finalize(stmt);
   return metadata;
 }
 
 std::vector<TimeRecord>
 SqliteReportDataRepository::get_time_records(const std::string &date) {
   std::vector<TimeRecord> records;
-  sqlite3_stmt *stmt;
-
-  std::string sql = "SELECT start, end, project_id, duration, activity_remark "
-                    "FROM time_records WHERE date = ? ORDER BY logical_id ASC;";
-
-  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, date.c_str(), -1, SQLITE_STATIC);
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
+  auto stmt = statements_.acquire(
+      kTimeRecords,
+      "SELECT start, end, project_id, duration, activity_remark "
+      "FROM time_records WHERE date = ? ORDER BY logical_id ASC;");
+
+  if (stmt) {
+    bind_day_key(stmt.get(), 1, date);
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
       TimeRecord record;
-      record.start_time_ =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      record.end_time_ =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+      record.start_minute_ = read_minute(stmt.get(), 0);
+      record.end_minute_ = read_minute(stmt.get(), 1);
 
-      long long pid = sqlite3_column_int64(stmt, 2);
+      long long pid = sqlite3_column_int64(stmt.get(), 2);
       record.project_path_ = std::to_string(pid);
 
-      record.duration_seconds_ = sqlite3_column_int64(stmt, 3);
-      const unsigned char *rm = sqlite3_column_text(stmt, 4);
+      record.duration_seconds_ = sqlite3_column_int64(stmt.get(), 3);
+      const unsigned char *rm = sqlite3_column_text(stmt.get(), 4);
       if (rm)
         record.activity_remark_ = reinterpret_cast<const char *>(rm);
 
       records.push_back(record);
     }
   }
-  sqlite3_finalize(stmt);
   return records;
 }
 
@@ -77,332 +193,403 @@ std::vector<std::pair<long long, long long>>
 SqliteReportDataRepository::get_aggregated_project_stats(
     const std::string &start_date, const std::string &end_date) {
   std::vector<std::pair<long long, long long>> result;
-  sqlite3_stmt *stmt;
-  std::string sql = "SELECT project_id, SUM(duration) FROM time_records WHERE "
-                    "date >= ? AND date <= ? GROUP BY project_id;";
+  // [新增] 前缀和可用时每个项目只做两次索引查找
+  if (get_prefix_project_stats(start_date, end_date, result)) {
+    return result;
+  }
 
-  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, start_date.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, end_date.c_str(), -1, SQLITE_TRANSIENT);
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      result.emplace_back(sqlite3_column_int64(stmt, 0),
-                          sqlite3_column_int64(stmt, 1));
+  // [修改] 预聚合可用时按日汇总读取，每天每项目只有一行
+  auto stmt = statements_.acquire(
+      kAggregatedProjectStats,
+      rollups_ready_
+          ? "SELECT project_id, SUM(duration) FROM project_rollups WHERE "
+            "granularity = 'day' AND period >= ? AND period <= ? "
+            "GROUP BY project_id;"
+          : "SELECT project_id, SUM(duration) FROM time_records WHERE "
+            "date >= ? AND date <= ? GROUP BY project_id;");
+
+  if (stmt) {
+    bind_date_range(stmt.get(), 1, start_date, end_date, rollups_ready_);
+    while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      result.emplace_back(sqlite3_column_int64(stmt.get(), 0),
+                          sqlite3_column_int64(stmt.get(), 1));
     }
   }
-  sqlite3_finalize(stmt);
   return result;
 }
 
 std::map<std::string, long long>
 SqliteReportDataRepository::get_day_generated_stats(const std::string &date) {
   std::map<std::string, long long> stats;
-  sqlite3_stmt *stmt;
-  std::string sql = "SELECT "
-                    "sleep_total_time, "
-                    "total_exercise_time, anaerobic_time, cardio_time, "
-                    "grooming_time, "
-                    "study_time, "
-                    "recreation_time, recreation_zhihu_time, "
-                    "recreation_bilibili_time, recreation_douyin_time "
-                    "FROM days WHERE date = ?;";
-
-  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, date.c_str(), -1, SQLITE_STATIC);
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-      int col_count = sqlite3_column_count(stmt);
+  auto stmt = statements_.acquire(
+      kDayGeneratedStats, "SELECT "
+                          "sleep_total_time, "
+                          "total_exercise_time, anaerobic_time, cardio_time, "
+                          "grooming_time, "
+                          "study_time, "
+                          "recreation_time, recreation_zhihu_time, "
+                          "recreation_bilibili_time, recreation_douyin_time "
+                          "FROM days WHERE date = ?;");
+
+  if (stmt) {
+    bind_day_key(stmt.get(), 1, date);
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      int col_count = sqlite3_column_count(stmt.get());
       for (int i = 0; i < col_count; ++i) {
-        const char *col_name = sqlite3_column_name(stmt, i);
+        const char *col_name = sqlite3_column_name(stmt.get(), i);
         if (col_name) {
           long long val = 0;
-          if (sqlite3_column_type(stmt, i) != SQLITE_NULL) {
-            val = sqlite3_column_int64(stmt, i);
+          if (sqlite3_column_type(stmt.get(), i) != SQLITE_NULL) {
+            val = sqlite3_column_int64(stmt.get(), i);
           }
           stats[std::string(col_name)] = val;
         }
       }
     }
   }
-  sqlite3_finalize(stmt);
   return stats;
 }
 
 int SqliteReportDataRepository::get_actual_active_days(
     const std::string &start_date, const std::string &end_date) {
   int actual_days = 0;
-  sqlite3_stmt *stmt;
-  std::string sql = "SELECT COUNT(DISTINCT date) FROM time_records WHERE date "
-                    ">= ? AND date <= ?;";
+  if (get_prefix_active_days(start_date, end_date, actual_days)) {
+    return actual_days;
+  }
 
-  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, start_date.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_text(stmt, 2, end_date.c_str(), -1, SQLITE_TRANSIENT);
+  auto stmt = statements_.acquire(
+      kActualActiveDays,
+      rollups_ready_
+          ? "SELECT COUNT(DISTINCT period) FROM project_rollups WHERE "
+            "granularity = 'day' AND period >= ? AND period <= ?;"
+          : "SELECT COUNT(DISTINCT date) FROM time_records WHERE "
+            "date >= ? AND date <= ?;");
+
+  if (stmt) {
+    bind_date_range(stmt.get(), 1, start_date, end_date, rollups_ready_);
 
-    if (sqlite3_step(stmt) == SQLITE_ROW) {
-      actual_days = sqlite3_column_int(stmt, 0);
+    if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+      actual_days = sqlite3_column_int(stmt.get(), 0);
     }
   }
-  sqlite3_finalize(stmt);
   return actual_days;
 }
 
-// --- Bulk Methods Implementation ---
-
-std::map<std::string, DailyReportData>
-SqliteReportDataRepository::get_all_days_metadata() {
-  std::map<std::string, DailyReportData> results;
-  sqlite3_stmt *stmt;
-
-  const char *sql = "SELECT date, status, sleep, remark, getup_time, exercise, "
-                    "sleep_total_time, total_exercise_time, anaerobic_time, "
-                    "cardio_time, grooming_time, "
-                    "study_time, recreation_time, recreation_zhihu_time, "
-                    "recreation_bilibili_time, recreation_douyin_time "
-                    "FROM days ORDER BY date ASC;";
+// [新增] 各窗口以 OR 连接，日期索引只扫描落在窗口内的行；
+// 窗口数随请求变化，因此不进入语句缓存
+std::vector<DailyProjectDuration>
+SqliteReportDataRepository::get_daily_project_stats_in_windows(
+    const std::vector<DateWindow> &windows) {
+  std::vector<DailyProjectDuration> rows;
+  if (windows.empty())
+    return rows;
+
+  const char *date_column = rollups_ready_ ? "period" : "date";
+  std::string window_filter;
+  for (size_t i = 0; i < windows.size(); ++i) {
+    if (i > 0)
+      window_filter += " OR ";
+    window_filter += std::string(date_column) + " BETWEEN ? AND ?";
+  }
 
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    const std::vector<std::string> stat_cols = {"sleep_total_time",
-                                                "total_exercise_time",
-                                                "anaerobic_time",
-                                                "cardio_time",
-                                                "grooming_time",
-                                                "study_time",
-                                                "recreation_time",
-                                                "recreation_zhihu_time",
-                                                "recreation_bilibili_time",
-                                                "recreation_douyin_time"};
+  std::string sql =
+      rollups_ready_
+          ? "SELECT period, project_id, duration FROM project_rollups "
+            "WHERE granularity = 'day' AND (" +
+                window_filter + ") ORDER BY period;"
+          : "SELECT date, project_id, SUM(duration) FROM time_records "
+            "WHERE " +
+                window_filter + " GROUP BY date, project_id ORDER BY date;";
 
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    int index = 1;
+    for (const auto &window : windows) {
+      bind_date_range(stmt, index, window.start_date_, window.end_date_,
+                      rollups_ready_);
+      index += 2;
+    }
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *date_cstr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!date_cstr)
+      std::string date = read_date_key(stmt, 0);
+      if (date.empty())
         continue;
-      std::string date(date_cstr);
-
-      DailyReportData &data = results[date];
-      data.date_ = date;
-
-      // Metadata
-      data.metadata_.status_ = std::to_string(sqlite3_column_int(stmt, 1));
-      data.metadata_.sleep_ = std::to_string(sqlite3_column_int(stmt, 2));
-      const unsigned char *rem = sqlite3_column_text(stmt, 3);
-      if (rem)
-        data.metadata_.remark_ = reinterpret_cast<const char *>(rem);
-      const unsigned char *getup = sqlite3_column_text(stmt, 4);
-      if (getup)
-        data.metadata_.getup_time_ = reinterpret_cast<const char *>(getup);
-      data.metadata_.exercise_ = std::to_string(sqlite3_column_int(stmt, 5));
-
-      // Generated Stats
-      for (size_t i = 0; i < stat_cols.size(); ++i) {
-        // start index 6
-        data.stats_[stat_cols[i]] =
-            sqlite3_column_int64(stmt, 6 + static_cast<int>(i));
-      }
+      rows.push_back({std::move(date), sqlite3_column_int64(stmt, 1),
+                      sqlite3_column_int64(stmt, 2)});
     }
   }
   sqlite3_finalize(stmt);
-  return results;
+  return rows;
 }
 
-std::vector<std::pair<std::string, TimeRecord>>
-SqliteReportDataRepository::get_all_time_records_with_date() {
-  std::vector<std::pair<std::string, TimeRecord>> results;
-  sqlite3_stmt *stmt;
-
+// [新增] 预聚合可用时直接顺序读日汇总；否则按 (日期, 项目) 分组扫描原始记录
+void SqliteReportDataRepository::for_each_daily_project_stats(
+    const std::function<void(const DailyProjectDuration &)> &visitor) {
   const char *sql =
-      "SELECT date, start, end, project_id, duration, activity_remark "
-      "FROM time_records ORDER BY date ASC, logical_id ASC;";
+      rollups_ready_
+          ? "SELECT period, project_id, duration FROM project_rollups "
+            "WHERE granularity = 'day' ORDER BY period;"
+          : "SELECT date, project_id, SUM(duration) FROM time_records "
+            "GROUP BY date, project_id ORDER BY date;";
 
+  sqlite3_stmt *stmt = nullptr;
   if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+    DailyProjectDuration row;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *date_cstr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!date_cstr)
+      row.date_ = read_date_key(stmt, 0);
+      if (row.date_.empty())
         continue;
-
-      TimeRecord record;
-      record.start_time_ =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
-      record.end_time_ =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 2));
-
-      long long pid = sqlite3_column_int64(stmt, 3);
-      record.project_path_ = std::to_string(pid);
-
-      record.duration_seconds_ = sqlite3_column_int64(stmt, 4);
-      const unsigned char *ar =
-          reinterpret_cast<const unsigned char *>(sqlite3_column_text(stmt, 5));
-      if (ar)
-        record.activity_remark_ = reinterpret_cast<const char *>(ar);
-
-      results.emplace_back(std::string(date_cstr), record);
+      row.project_id_ = sqlite3_column_int64(stmt, 1);
+      row.duration_ = sqlite3_column_int64(stmt, 2);
+      visitor(row);
     }
   }
   sqlite3_finalize(stmt);
-  return results;
 }
 
-std::map<std::string, std::vector<std::pair<long long, long long>>>
-SqliteReportDataRepository::get_all_months_project_stats() {
-  std::map<std::string, std::vector<std::pair<long long, long long>>> results;
-  sqlite3_stmt *stmt;
+// --- Prefix Sum Range Methods ---
+// [新增] 区间合计 = 累计(<= end) - 累计(< start)
+
+bool SqliteReportDataRepository::get_prefix_project_stats(
+    const std::string &start_date, const std::string &end_date,
+    std::vector<std::pair<long long, long long>> &result) {
+  long long start_day = 0;
+  long long end_day = 0;
+  if (!prefix_sums_ready_ || !to_day_number(start_date, false, start_day) ||
+      !to_day_number(end_date, true, end_day))
+    return false;
+
+  // [修改] projects 表规模很小。与预聚合 / 原始表路径一致，
+  // 凡区间内有记录的项目都返回 (时长为 0 也保留)，区间内无前缀行的项目跳过
+  auto stmt = statements_.acquire(
+      kPrefixProjectStats,
+      "SELECT p.id, "
+      "  COALESCE((SELECT s.cumulative FROM project_prefix_sums s "
+      "            WHERE s.project_id = p.id AND s.day_number <= ?2 "
+      "            ORDER BY s.day_number DESC LIMIT 1), 0) "
+      "  - COALESCE((SELECT s.cumulative FROM project_prefix_sums s "
+      "              WHERE s.project_id = p.id AND s.day_number < ?1 "
+      "              ORDER BY s.day_number DESC LIMIT 1), 0) "
+      "FROM projects p "
+      "WHERE EXISTS (SELECT 1 FROM project_prefix_sums s "
+      "              WHERE s.project_id = p.id "
+      "                AND s.day_number BETWEEN ?1 AND ?2);");
+
+  if (!stmt)
+    return false;
+  sqlite3_bind_int64(stmt.get(), 1, start_day);
+  sqlite3_bind_int64(stmt.get(), 2, end_day);
+  while (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    result.emplace_back(sqlite3_column_int64(stmt.get(), 0),
+                        sqlite3_column_int64(stmt.get(), 1));
+  }
+  return true;
+}
 
-  const char *sql =
-      "SELECT strftime('%Y-%m', date) as ym, project_id, SUM(duration) "
-      "FROM time_records GROUP BY ym, project_id ORDER BY ym ASC;";
+bool SqliteReportDataRepository::get_prefix_active_days(
+    const std::string &start_date, const std::string &end_date, int &result) {
+  long long start_day = 0;
+  long long end_day = 0;
+  if (!prefix_sums_ready_ || !to_day_number(start_date, false, start_day) ||
+      !to_day_number(end_date, true, end_day))
+    return false;
 
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *ym_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!ym_ptr)
-        continue;
-      std::string ym(ym_ptr);
-      long long pid = sqlite3_column_int64(stmt, 1);
-      long long duration = sqlite3_column_int64(stmt, 2);
+  auto stmt = statements_.acquire(
+      kPrefixActiveDays,
+      "SELECT "
+      "  COALESCE((SELECT cumulative_days FROM active_day_prefix "
+      "            WHERE day_number <= ?2 "
+      "            ORDER BY day_number DESC LIMIT 1), 0) "
+      "  - COALESCE((SELECT cumulative_days FROM active_day_prefix "
+      "              WHERE day_number < ?1 "
+      "              ORDER BY day_number DESC LIMIT 1), 0);");
+
+  if (!stmt)
+    return false;
+  sqlite3_bind_int64(stmt.get(), 1, start_day);
+  sqlite3_bind_int64(stmt.get(), 2, end_day);
+  result = 0;
+  if (sqlite3_step(stmt.get()) == SQLITE_ROW) {
+    result = sqlite3_column_int(stmt.get(), 0);
+  }
+  return true;
+}
 
-      results[ym].emplace_back(pid, duration);
+// --- Bulk Methods Implementation ---
+
+// [修改] 全量与按窗口读取共用同一套列定义和行解析
+namespace {
+
+constexpr const char *kDayMetadataColumns =
+    "SELECT date, status, sleep, remark, getup_time, exercise, "
+    "sleep_total_time, total_exercise_time, anaerobic_time, "
+    "cardio_time, grooming_time, "
+    "study_time, recreation_time, recreation_zhihu_time, "
+    "recreation_bilibili_time, recreation_douyin_time "
+    "FROM days ";
+
+constexpr const char *kTimeRecordColumns =
+    "SELECT date, start, end, project_id, duration, activity_remark "
+    "FROM time_records ";
+
+void read_day_metadata_rows(sqlite3_stmt *stmt,
+                            std::map<std::string, DailyReportData> &results) {
+  static const std::vector<std::string> stat_cols = {"sleep_total_time",
+                                                     "total_exercise_time",
+                                                     "anaerobic_time",
+                                                     "cardio_time",
+                                                     "grooming_time",
+                                                     "study_time",
+                                                     "recreation_time",
+                                                     "recreation_zhihu_time",
+                                                     "recreation_bilibili_time",
+                                                     "recreation_douyin_time"};
+
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    std::string date = read_date_key(stmt, 0);
+    if (date.empty())
+      continue;
+
+    DailyReportData &data = results[date];
+    data.date_ = date;
+
+    // Metadata
+    data.metadata_.status_ = std::to_string(sqlite3_column_int(stmt, 1));
+    data.metadata_.sleep_ = std::to_string(sqlite3_column_int(stmt, 2));
+    const unsigned char *rem = sqlite3_column_text(stmt, 3);
+    if (rem)
+      data.metadata_.remark_ = reinterpret_cast<const char *>(rem);
+    const unsigned char *getup = sqlite3_column_text(stmt, 4);
+    if (getup)
+      data.metadata_.getup_time_ = reinterpret_cast<const char *>(getup);
+    data.metadata_.exercise_ = std::to_string(sqlite3_column_int(stmt, 5));
+
+    // Generated Stats
+    for (size_t i = 0; i < stat_cols.size(); ++i) {
+      // start index 6
+      data.stats_[stat_cols[i]] =
+          sqlite3_column_int64(stmt, 6 + static_cast<int>(i));
     }
   }
-  sqlite3_finalize(stmt);
-  return results;
 }
 
-std::map<std::string, int>
-SqliteReportDataRepository::get_all_months_active_days() {
-  std::map<std::string, int> results;
-  sqlite3_stmt *stmt;
+void read_time_record_rows(
+    sqlite3_stmt *stmt,
+    std::vector<std::pair<std::string, TimeRecord>> &results) {
+  // 记录按 date 排序，同一天只格式化一次日期
+  long long current_day = 0;
+  std::string date;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    if (sqlite3_column_type(stmt, 0) != SQLITE_INTEGER)
+      continue;
+    const long long day_number = sqlite3_column_int64(stmt, 0);
+    if (date.empty() || day_number != current_day) {
+      current_day = day_number;
+      date = TimeUtils::FormatDayNumber(day_number);
+    }
 
-  const char *sql =
-      "SELECT strftime('%Y-%m', date) as ym, COUNT(DISTINCT date) "
-      "FROM time_records GROUP BY ym;";
+    TimeRecord record;
+    record.start_minute_ = read_minute(stmt, 1);
+    record.end_minute_ = read_minute(stmt, 2);
 
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *ym_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!ym_ptr)
-        continue;
-      results[std::string(ym_ptr)] = sqlite3_column_int(stmt, 1);
-    }
+    long long pid = sqlite3_column_int64(stmt, 3);
+    record.project_path_ = std::to_string(pid);
+
+    record.duration_seconds_ = sqlite3_column_int64(stmt, 4);
+    const unsigned char *ar =
+        reinterpret_cast<const unsigned char *>(sqlite3_column_text(stmt, 5));
+    if (ar)
+      record.activity_remark_ = reinterpret_cast<const char *>(ar);
+
+    results.emplace_back(date, record);
   }
-  sqlite3_finalize(stmt);
-  return results;
 }
 
-// [新增] Weekly Bulk Implementation
+} // namespace
 
-std::map<std::string, std::vector<std::pair<long long, long long>>>
-SqliteReportDataRepository::get_all_weeks_project_stats() {
-  std::map<std::string, std::vector<std::pair<long long, long long>>> results;
+std::map<std::string, DailyReportData>
+SqliteReportDataRepository::get_all_days_metadata() {
+  std::map<std::string, DailyReportData> results;
   sqlite3_stmt *stmt;
 
-  // [修复] 使用 ISO 8601 逻辑的 SQL
-  // 逻辑说明：
-  // 1. date(date, 'weekday 0', '-3 days') 找到该周的“周四”
-  // 2. strftime('%Y', ...) 获取周四所在的年份 (ISO Year)
-  // 3. (strftime('%j', ...) - 1) / 7 + 1 计算 ISO Week Number
-  const char *sql =
-      "SELECT "
-      "  strftime('%Y', date(date, '-3 days', 'weekday 4')) || '-W' || "
-      "  printf('%02d', (strftime('%j', date(date, '-3 days', 'weekday 4')) - "
-      "1) / 7 + 1) as iso_week, "
-      "  project_id, "
-      "  SUM(duration) "
-      "FROM time_records "
-      "GROUP BY iso_week, project_id "
-      "ORDER BY iso_week ASC;";
-
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *yw_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!yw_ptr)
-        continue;
-      std::string yw(yw_ptr);
-      long long pid = sqlite3_column_int64(stmt, 1);
-      long long duration = sqlite3_column_int64(stmt, 2);
+  const std::string sql =
+      std::string(kDayMetadataColumns) + "ORDER BY date ASC;";
 
-      results[yw].emplace_back(pid, duration);
-    }
+  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    read_day_metadata_rows(stmt, results);
   }
   sqlite3_finalize(stmt);
   return results;
 }
 
-std::map<std::string, int>
-SqliteReportDataRepository::get_all_weeks_active_days() {
-  std::map<std::string, int> results;
+std::vector<std::pair<std::string, TimeRecord>>
+SqliteReportDataRepository::get_all_time_records_with_date() {
+  std::vector<std::pair<std::string, TimeRecord>> results;
   sqlite3_stmt *stmt;
 
-  // [修复] 同样的 ISO 8601 逻辑
-  const char *sql =
-      "SELECT "
-      "  strftime('%Y', date(date, '-3 days', 'weekday 4')) || '-W' || "
-      "  printf('%02d', (strftime('%j', date(date, '-3 days', 'weekday 4')) - "
-      "1) / 7 + 1) as iso_week, "
-      "  COUNT(DISTINCT date) "
-      "FROM time_records "
-      "GROUP BY iso_week;";
+  const std::string sql =
+      std::string(kTimeRecordColumns) + "ORDER BY date ASC, logical_id ASC;";
 
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *yw_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!yw_ptr)
-        continue;
-      results[std::string(yw_ptr)] = sqlite3_column_int(stmt, 1);
-    }
+  if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    read_time_record_rows(stmt, results);
   }
   sqlite3_finalize(stmt);
   return results;
 }
 
-// [新增] Yearly Bulk Implementation
+// --- Daily Windowed Methods ---
+// [新增] 流式导出每个窗口调用一次，语句走 StatementCache 复用
 
-std::map<std::string, std::vector<std::pair<long long, long long>>>
-SqliteReportDataRepository::get_all_years_project_stats() {
-  std::map<std::string, std::vector<std::pair<long long, long long>>> results;
+std::vector<std::string> SqliteReportDataRepository::get_all_record_months() {
+  std::vector<std::string> months;
   sqlite3_stmt *stmt;
 
+  // 预聚合可用时直接读月度行；否则走 idx_time_records_date 覆盖索引
   const char *sql =
-      "SELECT strftime('%Y', date) as y, project_id, SUM(duration) "
-      "FROM time_records GROUP BY y, project_id ORDER BY y ASC;";
+      rollups_ready_
+          ? "SELECT period FROM period_active_days "
+            "WHERE granularity = 'month' ORDER BY period ASC;"
+          : "SELECT DISTINCT strftime('%Y-%m', 2440587.5 + date) "
+            "FROM time_records ORDER BY 1 ASC;";
 
   if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *y_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!y_ptr)
-        continue;
-      std::string y_str(y_ptr);
-      long long pid = sqlite3_column_int64(stmt, 1);
-      long long duration = sqlite3_column_int64(stmt, 2);
-
-      results[y_str].emplace_back(pid, duration);
+      const unsigned char *ym = sqlite3_column_text(stmt, 0);
+      if (ym)
+        months.emplace_back(reinterpret_cast<const char *>(ym));
     }
   }
   sqlite3_finalize(stmt);
-  return results;
+  return months;
 }
 
-std::map<std::string, int>
-SqliteReportDataRepository::get_all_years_active_days() {
-  std::map<std::string, int> results;
-  sqlite3_stmt *stmt;
-
-  const char *sql = "SELECT strftime('%Y', date) as y, COUNT(DISTINCT date) "
-                    "FROM time_records GROUP BY y;";
+std::map<std::string, DailyReportData>
+SqliteReportDataRepository::get_days_metadata_in_range(
+    const std::string &start_date, const std::string &end_date) {
+  std::map<std::string, DailyReportData> results;
+  static const std::string sql = std::string(kDayMetadataColumns) +
+                                 "WHERE date >= ? AND date <= ? "
+                                 "ORDER BY date ASC;";
+  auto stmt = statements_.acquire(kDaysMetadataInRange, sql.c_str());
+
+  if (stmt) {
+    bind_date_range(stmt.get(), 1, start_date, end_date, false);
+    read_day_metadata_rows(stmt.get(), results);
+  }
+  return results;
+}
 
-  if (sqlite3_prepare_v2(db_, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-      const char *y_ptr =
-          reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-      if (!y_ptr)
-        continue;
-      results[std::string(y_ptr)] = sqlite3_column_int(stmt, 1);
-    }
+std::vector<std::pair<std::string, TimeRecord>>
+SqliteReportDataRepository::get_time_records_with_date_in_range(
+    const std::string &start_date, const std::string &end_date) {
+  std::vector<std::pair<std::string, TimeRecord>> results;
+  static const std::string sql = std::string(kTimeRecordColumns) +
+                                 "WHERE date >= ? AND date <= ? "
+                                 "ORDER BY date ASC, logical_id ASC;";
+  auto stmt = statements_.acquire(kTimeRecordsInRange, sql.c_str());
+
+  if (stmt) {
+    bind_date_range(stmt.get(), 1, start_date, end_date, false);
+    read_time_record_rows(stmt.get(), results);
   }
-  sqlite3_finalize(stmt);
   return results;
 }
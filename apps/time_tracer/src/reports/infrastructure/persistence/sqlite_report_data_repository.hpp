@@ -3,6 +3,7 @@
 #define REPORTS_INFRASTRUCTURE_PERSISTENCE_SQLITE_REPORT_DATA_REPOSITORY_HPP_
 
 #include "reports/domain/repositories/i_report_repository.hpp"
+#include "reports/infrastructure/persistence/statement_cache.hpp"
 #include <sqlite3.h>
 
 class SqliteReportDataRepository : public IReportRepository {
@@ -19,27 +20,57 @@ public:
                                const std::string &end) override;
   int get_actual_active_days(const std::string &start,
                              const std::string &end) override;
+  bool get_prefix_project_stats(
+      const std::string &start_date, const std::string &end_date,
+      std::vector<std::pair<long long, long long>> &result) override;
+  bool get_prefix_active_days(const std::string &start_date,
+                              const std::string &end_date,
+                              int &result) override;
+  std::vector<DailyProjectDuration> get_daily_project_stats_in_windows(
+      const std::vector<DateWindow> &windows) override;
 
   // Bulk Export Methods
   std::map<std::string, DailyReportData> get_all_days_metadata() override;
   std::vector<std::pair<std::string, TimeRecord>>
   get_all_time_records_with_date() override;
-  std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_months_project_stats() override;
-  std::map<std::string, int> get_all_months_active_days() override;
 
-  // [新增] Weekly Bulk Implementation
-  std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_weeks_project_stats() override;
-  std::map<std::string, int> get_all_weeks_active_days() override;
+  // [新增] Daily Windowed Methods
+  std::vector<std::string> get_all_record_months() override;
+  std::map<std::string, DailyReportData>
+  get_days_metadata_in_range(const std::string &start_date,
+                             const std::string &end_date) override;
+  std::vector<std::pair<std::string, TimeRecord>>
+  get_time_records_with_date_in_range(const std::string &start_date,
+                                      const std::string &end_date) override;
+
+  void for_each_daily_project_stats(
+      const std::function<void(const DailyProjectDuration &)> &visitor)
+      override;
 
-  // [新增] Yearly Bulk Implementation
-  std::map<std::string, std::vector<std::pair<long long, long long>>>
-  get_all_years_project_stats() override;
-  std::map<std::string, int> get_all_years_active_days() override;
+  // [新增] 预编译语句缓存命中统计
+  StatementCache::Stats get_statement_cache_stats() const;
 
 private:
+  // 单条查询的缓存键
+  enum QueryId : size_t {
+    kDayMetadata,
+    kTimeRecords,
+    kAggregatedProjectStats,
+    kDayGeneratedStats,
+    kActualActiveDays,
+    kDaysMetadataInRange,
+    kTimeRecordsInRange,
+    kPrefixProjectStats,
+    kPrefixActiveDays,
+    kQueryCount
+  };
+
   sqlite3 *db_;
+  StatementCache statements_;
+  // [新增] 模式版本 >= 2 时预聚合表可用，否则回退到扫描 time_records
+  bool rollups_ready_ = false;
+  // [新增] 模式版本 >= 3 时前缀和索引可用
+  bool prefix_sums_ready_ = false;
 };
 
 #endif // REPORTS_INFRASTRUCTURE_PERSISTENCE_SQLITE_REPORT_DATA_REPOSITORY_HPP_
@@ -0,0 +1,40 @@
+﻿// reports/infrastructure/persistence/statement_cache.cpp
+#include "reports/infrastructure/persistence/statement_cache.hpp"
+#include <stdexcept>
+
+StatementCache::Lease::~Lease() {
+  if (stmt_) {
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+  }
+}
+
+StatementCache::StatementCache(sqlite3 *db, size_t capacity)
+    : db_(db), statements_(capacity, nullptr) {}
+
+StatementCache::~StatementCache() {
+  for (sqlite3_stmt *stmt : statements_) {
+    if (stmt)
+      sqlite3_finalize(stmt);
+  }
+}
+
+StatementCache::Lease StatementCache::acquire(size_t query_id,
+                                              const char *sql) {
+  if (query_id >= statements_.size()) {
+    throw std::out_of_range("Statement cache query id out of range.");
+  }
+
+  sqlite3_stmt *&slot = statements_[query_id];
+  if (slot) {
+    ++stats_.hits;
+    return Lease(slot);
+  }
+
+  ++stats_.misses;
+  if (sqlite3_prepare_v2(db_, sql, -1, &slot, nullptr) != SQLITE_OK) {
+    sqlite3_finalize(slot);
+    slot = nullptr;
+  }
+  return Lease(slot);
+}
@@ -0,0 +1,51 @@
+﻿// reports/infrastructure/persistence/statement_cache.hpp
+#ifndef REPORTS_INFRASTRUCTURE_PERSISTENCE_STATEMENT_CACHE_HPP_
+#define REPORTS_INFRASTRUCTURE_PERSISTENCE_STATEMENT_CACHE_HPP_
+
+#include <cstddef>
+#include <sqlite3.h>
+#include <vector>
+
+// [新增] 单连接的预编译语句缓存
+// 以查询 ID (0..capacity-1) 为键，首次使用时 prepare，之后只 reset/rebind，
+// 避免在循环生成报表时重复编译 SQL。非线程安全：一个连接一个实例。
+class StatementCache {
+public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+  };
+
+  // 借出的语句；析构时 reset 并清空绑定 (SQLITE_STATIC 绑定不会悬空)
+  class Lease {
+  public:
+    explicit Lease(sqlite3_stmt *stmt) : stmt_(stmt) {}
+    ~Lease();
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    sqlite3_stmt *get() const { return stmt_; }
+    explicit operator bool() const { return stmt_ != nullptr; }
+
+  private:
+    sqlite3_stmt *stmt_;
+  };
+
+  StatementCache(sqlite3 *db, size_t capacity);
+  ~StatementCache();
+
+  StatementCache(const StatementCache &) = delete;
+  StatementCache &operator=(const StatementCache &) = delete;
+
+  // prepare 失败时返回空的 Lease
+  Lease acquire(size_t query_id, const char *sql);
+
+  Stats get_stats() const { return stats_; }
+
+private:
+  sqlite3 *db_;
+  std::vector<sqlite3_stmt *> statements_;
+  Stats stats_;
+};
+
+#endif // REPORTS_INFRASTRUCTURE_PERSISTENCE_STATEMENT_CACHE_HPP_
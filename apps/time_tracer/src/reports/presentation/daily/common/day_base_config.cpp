@@ -1,71 +1,64 @@
 ﻿// reports/presentation/daily/common/day_base_config.cpp
 #include "reports/presentation/daily/common/day_base_config.hpp"
-#include <stdexcept>
 
+using FormatterConfigAbi::to_string;
+
+// [修改] 统计项树按 first_child / child_count 从拍平数组中还原
 static std::vector<StatisticItemConfig>
-parse_statistics_items_recursive(const toml::array *arr) {
+unpack_statistics_items(const DailyFormatterConfig &config, uint32_t first,
+                        uint32_t count) {
   std::vector<StatisticItemConfig> items;
-  if (!arr) {
+  if (!config.statistics_items ||
+      first + count > config.statistics_item_count) {
     return items;
   }
 
-  for (const auto &node : *arr) {
-    if (!node.is_table())
-      continue;
-    const auto &item_tbl = *node.as_table();
+  items.reserve(count);
+  for (uint32_t i = first; i < first + count; ++i) {
+    const FormatterStatItem &src = config.statistics_items[i];
 
     StatisticItemConfig item;
-    item.label_ = item_tbl["label"].value_or<std::string>("");
-    item.db_column_ = item_tbl["db_column"].value_or<std::string>("");
-    item.show_ = item_tbl["show"].value_or(true);
-
-    if (const toml::array *sub_arr = item_tbl["sub_items"].as_array()) {
-      item.sub_items_ = parse_statistics_items_recursive(sub_arr);
+    item.label_ = to_string(src.label);
+    item.db_column_ = to_string(src.db_column);
+    item.show_ = src.show != 0;
+    // 子项总是排在父项之后，借此排除环引用
+    if (src.child_count > 0 && src.first_child > i) {
+      item.sub_items_ =
+          unpack_statistics_items(config, src.first_child, src.child_count);
     }
 
-    items.push_back(item);
+    items.push_back(std::move(item));
   }
   return items;
 }
 
 // [修改] 构造函数
-DayBaseConfig::DayBaseConfig(const toml::table &config)
-    : config_table_(config) {
-  load_base_config();
+DayBaseConfig::DayBaseConfig(const DailyFormatterConfig &config) {
+  load_base_config(config);
 }
 
-void DayBaseConfig::load_base_config() {
-  // [修改] 使用 TOML++ API
-  if (auto val = config_table_["title_prefix"].value<std::string>()) {
-    title_prefix_ = *val;
-  } else {
-    // 兼容 report_title
-    title_prefix_ = config_table_["report_title"].value_or("Daily Report for");
-  }
+void DayBaseConfig::load_base_config(const DailyFormatterConfig &config) {
+  // Host 端已经完成默认值填充，这里只做逐字段拷贝
+  title_prefix_ = to_string(config.title_prefix);
+  date_label_ = to_string(config.date_label);
+  total_time_label_ = to_string(config.total_time_label);
+  status_label_ = to_string(config.status_label);
+  sleep_label_ = to_string(config.sleep_label);
+  getup_time_label_ = to_string(config.getup_time_label);
+  remark_label_ = to_string(config.remark_label);
+  exercise_label_ = to_string(config.exercise_label);
 
-  date_label_ = config_table_["date_label"].value_or("");
-  total_time_label_ = config_table_["total_time_label"].value_or("");
-  status_label_ = config_table_["status_label"].value_or("Status");
-  sleep_label_ = config_table_["sleep_label"].value_or("Sleep");
-  getup_time_label_ = config_table_["getup_time_label"].value_or("Getup Time");
-  remark_label_ = config_table_["remark_label"].value_or("Remark");
-  exercise_label_ = config_table_["exercise_label"].value_or("Exercise");
+  no_records_ = to_string(config.no_records_message);
 
-  no_records_ = config_table_["no_records_message"].value_or("No records.");
+  statistics_label_ = to_string(config.statistics_label);
+  all_activities_label_ = to_string(config.all_activities_label);
+  activity_remark_label_ = to_string(config.activity_remark_label);
+  activity_connector_ = to_string(config.activity_connector);
 
-  statistics_label_ = config_table_["statistics_label"].value_or("Statistics");
-  all_activities_label_ =
-      config_table_["all_activities_label"].value_or("All Activities");
-  activity_remark_label_ =
-      config_table_["activity_remark_label"].value_or("Remark");
-  activity_connector_ = config_table_["activity_connector"].value_or("->");
+  project_breakdown_label_ = to_string(config.project_breakdown_label);
 
-  project_breakdown_label_ =
-      config_table_["project_breakdown_label"].value_or("Project Breakdown");
-
-  if (const toml::array *arr = config_table_["statistics_items"].as_array()) {
-    statistics_items_ = parse_statistics_items_recursive(arr);
-  }
+  statistics_items_ =
+      unpack_statistics_items(config, 0, config.statistics_root_count);
 }
 
 // Getters 保持不变
@@ -2,10 +2,10 @@
 #ifndef REPORTS_PRESENTATION_DAILY_COMMON_DAY_BASE_CONFIG_HPP_
 #define REPORTS_PRESENTATION_DAILY_COMMON_DAY_BASE_CONFIG_HPP_
 
+#include "reports/shared/api/formatter_config_abi.hpp"
 #include "reports/shared/api/shared_api.hpp"
 #include <map>
 #include <string>
-#include <toml++/toml.hpp>
 #include <vector>
 
 struct StatisticItemConfig {
@@ -19,8 +19,8 @@ DISABLE_C4251_WARNING
 
 class REPORTS_SHARED_API DayBaseConfig {
 public:
-  // [修改] 构造函数接收 TOML Table
-  explicit DayBaseConfig(const toml::table &config);
+  // [修改] 构造函数直接读取 Host 打包的 C 结构体，不再解析 TOML
+  explicit DayBaseConfig(const DailyFormatterConfig &config);
   virtual ~DayBaseConfig() = default;
 
   const std::string &GetTitlePrefix() const;
@@ -40,11 +40,8 @@ public:
 
   const std::vector<StatisticItemConfig> &GetStatisticsItems() const;
 
-protected:
-  toml::table config_table_;
-
 private:
-  void load_base_config();
+  void load_base_config(const DailyFormatterConfig &config);
 
   std::string title_prefix_;
   std::string date_label_;
@@ -2,6 +2,7 @@
 #include "reports/presentation/daily/formatters/latex/day_tex_formatter.hpp"
 #include "reports/presentation/daily/formatters/statistics/latex_strategy.hpp"
 #include "reports/presentation/daily/formatters/statistics/stat_formatter.hpp"
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/formatters/latex/tex_utils.hpp"
 #include "reports/shared/utils/report_string_utils.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
@@ -9,15 +10,14 @@
 // ==========================================
 // 逻辑块 A: DayTexConfig 实现
 // ==========================================
-DayTexConfig::DayTexConfig(const toml::table &config)
-    : DayBaseConfig(config), style_(config) {
-  report_title_ = config["report_title"].value_or("");
-  if (const toml::table *kw_tbl = config["keyword_colors"].as_table()) {
-    for (const auto &[key, val] : *kw_tbl) {
-      if (auto s = val.value<std::string>()) {
-        keyword_colors_[std::string(key.str())] = *s;
-      }
-    }
+DayTexConfig::DayTexConfig(const DailyFormatterConfig &config)
+    : DayBaseConfig(config), style_(config.fonts, config.layout) {
+  // report_title 在旧的 TOML 协议中就是 title_prefix 的别名
+  report_title_ = FormatterConfigAbi::to_string(config.title_prefix);
+  for (uint32_t i = 0; i < config.keyword_color_count; ++i) {
+    const FormatterKeywordColor &kw = config.keyword_colors[i];
+    keyword_colors_[FormatterConfigAbi::to_string(kw.keyword)] =
+        FormatterConfigAbi::to_string(kw.color);
   }
 }
 
@@ -41,7 +41,7 @@ std::map<std::string, std::string> DayTexFormatter::get_keyword_colors() const {
   return config_->GetKeywordColors();
 }
 
-void DayTexFormatter::format_extra_content(std::stringstream &ss,
+void DayTexFormatter::format_extra_content(std::ostream &ss,
                                            const DailyReportData &data) const {
   // 使用模板化的策略
   auto strategy = std::make_unique<LatexStrategy<DayTexConfig>>(config_.get());
@@ -50,7 +50,7 @@ void DayTexFormatter::format_extra_content(std::stringstream &ss,
   display_detailed_activities(ss, data);
 }
 
-void DayTexFormatter::display_header(std::stringstream &ss,
+void DayTexFormatter::display_header(std::ostream &ss,
                                      const DailyReportData &data) const {
   std::string title_content =
       config_->GetTitlePrefix() + " " + TexUtils::escape_latex(data.date_);
@@ -77,7 +77,7 @@ void DayTexFormatter::display_header(std::stringstream &ss,
 }
 
 void DayTexFormatter::display_detailed_activities(
-    std::stringstream &ss, const DailyReportData &data) const {
+    std::ostream &ss, const DailyReportData &data) const {
   if (data.detailed_records_.empty())
     return;
   TexUtils::render_title(ss, config_->GetAllActivitiesLabel(),
@@ -85,7 +85,7 @@ void DayTexFormatter::display_detailed_activities(
   // ... 详细活动渲染逻辑与之前一致 ...
 }
 
-void DayTexFormatter::format_header_content(std::stringstream &ss,
+void DayTexFormatter::format_header_content(std::ostream &ss,
                                             const DailyReportData &data) const {
   display_header(ss, data);
 }
@@ -94,12 +94,20 @@ void DayTexFormatter::format_header_content(std::stringstream &ss,
 // DLL 导出函数
 // ==========================================
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_content) {
+create_formatter_from_config(const DailyFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_content);
-    auto config = std::make_shared<DayTexConfig>(config_tbl);
-    auto formatter = new DayTexFormatter(config);
+    auto tex_config = std::make_shared<DayTexConfig>(*config);
+    auto formatter = new DayTexFormatter(tex_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
     return nullptr;
@@ -111,14 +119,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
     delete static_cast<DayTexFormatter *>(handle);
 }
 
-static std::string report_buffer;
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const DailyReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<DayTexFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const DailyReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const DayTexFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
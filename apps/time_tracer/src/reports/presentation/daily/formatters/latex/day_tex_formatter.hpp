@@ -8,12 +8,11 @@
 #include "reports/shared/formatters/templates/base_tex_formatter.hpp"
 #include <map>
 #include <string>
-#include <toml++/toml.hpp>
 
 // [合并] 将配置类定义移入此处
 class DayTexConfig : public DayBaseConfig {
 public:
-  explicit DayTexConfig(const toml::table &config);
+  explicit DayTexConfig(const DailyFormatterConfig &config);
 
   const std::string &GetReportTitle() const { return report_title_; }
   const std::map<std::string, std::string> &GetKeywordColors() const {
@@ -50,16 +49,16 @@ public:
 protected:
   bool is_empty_data(const DailyReportData &data) const override;
   int get_avg_days(const DailyReportData &data) const override;
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const DailyReportData &data) const override;
-  void format_extra_content(std::stringstream &ss,
+  void format_extra_content(std::ostream &ss,
                             const DailyReportData &data) const override;
   std::string get_no_records_msg() const override;
   std::map<std::string, std::string> get_keyword_colors() const override;
 
 private:
-  void display_header(std::stringstream &ss, const DailyReportData &data) const;
-  void display_detailed_activities(std::stringstream &ss,
+  void display_header(std::ostream &ss, const DailyReportData &data) const;
+  void display_detailed_activities(std::ostream &ss,
                                    const DailyReportData &data) const;
 };
 
@@ -5,8 +5,8 @@
 #include <format>
 #include <iomanip>
 #include <memory>
-#include <toml++/toml.hpp>
 
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/utils/report_string_utils.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
 
@@ -28,7 +28,7 @@ std::string DayMdFormatter::get_no_records_msg() const {
   return config_->GetNoRecords();
 }
 
-void DayMdFormatter::format_header_content(std::stringstream &ss,
+void DayMdFormatter::format_header_content(std::ostream &ss,
                                            const DailyReportData &data) const {
   ss << std::format("## {0} {1}\n\n", config_->GetTitlePrefix(), data.date_);
   ss << std::format("- **{0}**: {1}\n", config_->GetDateLabel(), data.date_);
@@ -49,7 +49,7 @@ void DayMdFormatter::format_header_content(std::stringstream &ss,
                     formatted_remark);
 }
 
-void DayMdFormatter::format_extra_content(std::stringstream &ss,
+void DayMdFormatter::format_extra_content(std::ostream &ss,
                                           const DailyReportData &data) const {
   auto strategy = std::make_unique<MarkdownStatStrategy>();
   StatFormatter stats_formatter(std::move(strategy));
@@ -59,15 +59,17 @@ void DayMdFormatter::format_extra_content(std::stringstream &ss,
 }
 
 void DayMdFormatter::_display_detailed_activities(
-    std::stringstream &ss, const DailyReportData &data) const {
+    std::ostream &ss, const DailyReportData &data) const {
   if (!data.detailed_records_.empty()) {
     ss << "\n## " << config_->GetAllActivitiesLabel() << "\n\n";
     for (const auto &record : data.detailed_records_) {
       std::string project_path = replace_all(record.project_path_, "_",
                                              config_->GetActivityConnector());
-      ss << std::format(
-          "- {0} - {1} ({2}): {3}\n", record.start_time_, record.end_time_,
-          time_format_duration(record.duration_seconds_, 1), project_path);
+      ss << std::format("- {0} - {1} ({2}): {3}\n",
+                        time_format_clock(record.start_minute_),
+                        time_format_clock(record.end_minute_),
+                        time_format_duration(record.duration_seconds_, 1),
+                        project_path);
       if (record.activity_remark_.has_value()) {
         ss << std::format("  - **{0}**: {1}\n",
                           config_->GetActivityRemarkLabel(),
@@ -79,11 +81,19 @@ void DayMdFormatter::_display_detailed_activities(
 }
 
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_content) {
+create_formatter_from_config(const DailyFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_content);
-    auto md_config = std::make_shared<DayMdConfig>(config_tbl);
+    auto md_config = std::make_shared<DayMdConfig>(*config);
     auto formatter = new DayMdFormatter(md_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
@@ -97,15 +107,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
   }
 }
 
-static std::string report_buffer;
-
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const DailyReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<DayMdFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const DailyReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const DayMdFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
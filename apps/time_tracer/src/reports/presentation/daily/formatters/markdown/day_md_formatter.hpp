@@ -5,13 +5,13 @@
 #include "reports/domain/model/daily_report_data.hpp"
 #include "reports/presentation/daily/common/day_base_config.hpp" // 直接包含基类配置
 #include "reports/shared/formatters/templates/base_md_formatter.hpp"
-#include <toml++/toml.hpp>
 
 // [合并] 将 DayMdConfig 直接定义在此处
 // Markdown 不需要复杂的 ExportStyleConfig，直接继承通用配置即可
 class DayMdConfig : public DayBaseConfig {
 public:
-  explicit DayMdConfig(const toml::table &config) : DayBaseConfig(config) {}
+  explicit DayMdConfig(const DailyFormatterConfig &config)
+      : DayBaseConfig(config) {}
 };
 
 class DayMdFormatter : public BaseMdFormatter<DailyReportData, DayMdConfig> {
@@ -23,15 +23,15 @@ protected:
   bool is_empty_data(const DailyReportData &data) const override;
   int get_avg_days(const DailyReportData &data) const override;
 
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const DailyReportData &data) const override;
-  void format_extra_content(std::stringstream &ss,
+  void format_extra_content(std::ostream &ss,
                             const DailyReportData &data) const override;
 
   std::string get_no_records_msg() const override;
 
 private:
-  void _display_detailed_activities(std::stringstream &ss,
+  void _display_detailed_activities(std::ostream &ss,
                                     const DailyReportData &data) const;
 };
 
@@ -2,6 +2,7 @@
 #include "reports/presentation/daily/formatters/typst/day_typ_formatter.hpp"
 #include "reports/presentation/daily/formatters/statistics/stat_formatter.hpp"
 #include "reports/presentation/daily/formatters/statistics/typst_strategy.hpp"
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/utils/report_string_utils.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
 #include <format>
@@ -9,18 +10,12 @@
 // ==========================================
 // 逻辑块 A: DayTypConfig 实现
 // ==========================================
-DayTypConfig::DayTypConfig(const toml::table &config)
-    : DayBaseConfig(config), style_(config) {
-  statistic_font_size_ = config_table_["statistic_font_size"].value_or(10);
-  statistic_title_font_size_ =
-      config_table_["statistic_title_font_size"].value_or(12);
-
-  if (const toml::table *kw_tbl = config_table_["keyword_colors"].as_table()) {
-    for (const auto &[key, val] : *kw_tbl) {
-      if (auto s = val.value<std::string>()) {
-        keyword_colors_[std::string(key.str())] = *s;
-      }
-    }
+DayTypConfig::DayTypConfig(const DailyFormatterConfig &config)
+    : DayBaseConfig(config), style_(config.fonts, config.layout) {
+  for (uint32_t i = 0; i < config.keyword_color_count; ++i) {
+    const FormatterKeywordColor &kw = config.keyword_colors[i];
+    keyword_colors_[FormatterConfigAbi::to_string(kw.keyword)] =
+        FormatterConfigAbi::to_string(kw.color);
   }
 }
 
@@ -40,12 +35,12 @@ std::string DayTypFormatter::get_no_records_msg() const {
   return config_->GetNoRecords();
 }
 
-void DayTypFormatter::format_header_content(std::stringstream &ss,
+void DayTypFormatter::format_header_content(std::ostream &ss,
                                             const DailyReportData &data) const {
   display_header(ss, data);
 }
 
-void DayTypFormatter::format_extra_content(std::stringstream &ss,
+void DayTypFormatter::format_extra_content(std::ostream &ss,
                                            const DailyReportData &data) const {
   auto strategy = std::make_unique<TypstStrategy<DayTypConfig>>(config_.get());
   StatFormatter stats_formatter(std::move(strategy));
@@ -53,7 +48,7 @@ void DayTypFormatter::format_extra_content(std::stringstream &ss,
   display_detailed_activities(ss, data);
 }
 
-void DayTypFormatter::display_header(std::stringstream &ss,
+void DayTypFormatter::display_header(std::ostream &ss,
                                      const DailyReportData &data) const {
   std::string title = std::format(
       R"(#text(font: "{}", size: {}pt)[= {} {}])", config_->GetTitleFont(),
@@ -77,7 +72,7 @@ void DayTypFormatter::display_header(std::stringstream &ss,
 }
 
 void DayTypFormatter::display_detailed_activities(
-    std::stringstream &ss, const DailyReportData &data) const {
+    std::ostream &ss, const DailyReportData &data) const {
   if (data.detailed_records_.empty())
     return;
 
@@ -97,7 +92,8 @@ DayTypFormatter::format_activity_line(const TimeRecord &record) const {
   std::string project_path =
       replace_all(record.project_path_, "_", config_->GetActivityConnector());
   std::string base_string = std::format(
-      "{} - {} ({}): {}", record.start_time_, record.end_time_,
+      "{} - {} ({}): {}", time_format_clock(record.start_minute_),
+      time_format_clock(record.end_minute_),
       time_format_duration(record.duration_seconds_, 1), project_path);
 
   for (const auto &[kw, color] : config_->GetKeywordColors()) {
@@ -126,12 +122,20 @@ DayTypFormatter::format_activity_line(const TimeRecord &record) const {
 
 // --- DLL 导出接口 ---
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_content) {
+create_formatter_from_config(const DailyFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_content);
-    auto config = std::make_shared<DayTypConfig>(config_tbl);
-    auto formatter = new DayTypFormatter(config);
+    auto typ_config = std::make_shared<DayTypConfig>(*config);
+    auto formatter = new DayTypFormatter(typ_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
     return nullptr;
@@ -143,14 +147,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
     delete static_cast<DayTypFormatter *>(handle);
 }
 
-static std::string report_buffer;
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const DailyReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<DayTypFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const DailyReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const DayTypFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
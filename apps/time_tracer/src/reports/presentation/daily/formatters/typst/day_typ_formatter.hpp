@@ -9,12 +9,11 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <toml++/toml.hpp>
 
 // [合并] 配置类定义
 class DayTypConfig : public DayBaseConfig {
 public:
-  explicit DayTypConfig(const toml::table &config);
+  explicit DayTypConfig(const DailyFormatterConfig &config);
 
   int GetStatisticFontSize() const { return statistic_font_size_; }
   int GetStatisticTitleFontSize() const { return statistic_title_font_size_; }
@@ -42,8 +41,9 @@ public:
 
 private:
   ExportStyleConfig style_;
-  int statistic_font_size_;
-  int statistic_title_font_size_;
+  // 旧 TOML 协议从未传递这两项，沿用其默认值
+  int statistic_font_size_ = 10;
+  int statistic_title_font_size_ = 12;
   std::map<std::string, std::string> keyword_colors_;
 };
 
@@ -55,15 +55,15 @@ public:
 protected:
   bool is_empty_data(const DailyReportData &data) const override;
   int get_avg_days(const DailyReportData &data) const override;
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const DailyReportData &data) const override;
-  void format_extra_content(std::stringstream &ss,
+  void format_extra_content(std::ostream &ss,
                             const DailyReportData &data) const override;
   std::string get_no_records_msg() const override;
 
 private:
-  void display_header(std::stringstream &ss, const DailyReportData &data) const;
-  void display_detailed_activities(std::stringstream &ss,
+  void display_header(std::ostream &ss, const DailyReportData &data) const;
+  void display_detailed_activities(std::ostream &ss,
                                    const DailyReportData &data) const;
   std::string format_activity_line(const TimeRecord &record) const;
 };
@@ -1,33 +1,24 @@
 ﻿// reports/presentation/range/common/range_base_config.cpp
 #include "reports/presentation/range/common/range_base_config.hpp"
 
-RangeBaseConfig::RangeBaseConfig(const toml::table &config)
-    : config_table_(config) {
-  load_base_config();
+using FormatterConfigAbi::to_string;
+
+RangeBaseConfig::RangeBaseConfig(const RangeFormatterConfig &config) {
+  load_base_config(config);
 }
 
-void RangeBaseConfig::load_base_config() {
-  // 使用 toml++ API 获取配置值，提供合理的默认值
-  report_title_label_ =
-      config_table_["report_title_label"].value_or<std::string>("");
-  date_range_separator_ =
-      config_table_["date_range_separator"].value_or<std::string>(" - ");
+void RangeBaseConfig::load_base_config(const RangeFormatterConfig &config) {
+  // Host 端已经完成默认值填充，这里只做逐字段拷贝
+  report_title_label_ = to_string(config.report_title_label);
+  date_range_separator_ = to_string(config.date_range_separator);
 
-  actual_days_label_ =
-      config_table_["actual_days_label"].value_or<std::string>("Active Days");
-  total_time_label_ =
-      config_table_["total_time_label"].value_or<std::string>("Total Duration");
+  actual_days_label_ = to_string(config.actual_days_label);
+  total_time_label_ = to_string(config.total_time_label);
 
-  no_records_message_ =
-      config_table_["no_records_message"].value_or<std::string>(
-          "No records found for this range.");
-  invalid_data_message_ =
-      config_table_["invalid_data_message"].value_or<std::string>(
-          "Invalid data range.");
+  no_records_message_ = to_string(config.no_records_message);
+  invalid_data_message_ = to_string(config.invalid_data_message);
 
-  project_breakdown_label_ =
-      config_table_["project_breakdown_label"].value_or<std::string>(
-          "Project Breakdown");
+  project_breakdown_label_ = to_string(config.project_breakdown_label);
 }
 
 const std::string &RangeBaseConfig::GetReportTitleLabel() const {
@@ -2,15 +2,16 @@
 #ifndef REPORTS_PRESENTATION_RANGE_COMMON_RANGE_BASE_CONFIG_HPP_
 #define REPORTS_PRESENTATION_RANGE_COMMON_RANGE_BASE_CONFIG_HPP_
 
+#include "reports/shared/api/formatter_config_abi.hpp"
 #include "reports/shared/api/shared_api.hpp"
 #include <string>
-#include <toml++/toml.hpp>
 
 DISABLE_C4251_WARNING
 
 class REPORTS_SHARED_API RangeBaseConfig {
 public:
-  explicit RangeBaseConfig(const toml::table &config);
+  // [修改] 直接读取 Host 打包的 C 结构体
+  explicit RangeBaseConfig(const RangeFormatterConfig &config);
   virtual ~RangeBaseConfig() = default;
 
   // 报告标题前缀 (可选，例如 "Report: ")
@@ -30,11 +31,8 @@ public:
   // 章节标题
   const std::string &GetProjectBreakdownLabel() const;
 
-protected:
-  toml::table config_table_;
-
 private:
-  void load_base_config();
+  void load_base_config(const RangeFormatterConfig &config);
 
   std::string report_title_label_;
   std::string date_range_separator_;
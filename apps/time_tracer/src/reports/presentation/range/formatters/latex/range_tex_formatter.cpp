@@ -1,9 +1,9 @@
 ﻿// reports/presentation/range/formatters/latex/range_tex_formatter.cpp
 #include "reports/presentation/range/formatters/latex/range_tex_formatter.hpp"
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/formatters/latex/tex_utils.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
 #include <algorithm>
-#include <toml++/toml.hpp>
 #include <vector>
 
 RangeTexFormatter::RangeTexFormatter(
@@ -32,11 +32,11 @@ std::string RangeTexFormatter::get_no_records_msg() const {
 }
 
 void RangeTexFormatter::format_header_content(
-    std::stringstream &ss, const RangeReportData &data) const {
+    std::ostream &ss, const RangeReportData &data) const {
   display_summary(ss, data);
 }
 
-void RangeTexFormatter::display_summary(std::stringstream &ss,
+void RangeTexFormatter::display_summary(std::ostream &ss,
                                         const RangeReportData &data) const {
   // 1. 标题渲染
   std::string full_title = TexUtils::escape_latex(data.report_name_);
@@ -71,13 +71,56 @@ void RangeTexFormatter::display_summary(std::stringstream &ss,
   }
 }
 
+void RangeTexFormatter::format_extra_content(
+    std::ostream &ss, const RangeReportData &data) const {
+  // 每个对照期：对照期时长 + 本期相对它的变化，项目只列顶层
+  for (const auto &comparison : data.comparisons_) {
+    TexUtils::render_title(ss, TexUtils::escape_latex(comparison.label_),
+                           config_->GetCategoryTitleFontSize());
+
+    ss << "\\textit{" << TexUtils::escape_latex(comparison.start_date_) << " "
+       << TexUtils::escape_latex(config_->GetDateRangeSeparator()) << " "
+       << TexUtils::escape_latex(comparison.end_date_) << "}\n\n";
+
+    std::vector<TexUtils::SummaryItem> items = {
+        {config_->GetTotalTimeLabel(),
+         TexUtils::escape_latex(
+             time_format_duration(comparison.total_duration_, 1) + ", " +
+             time_format_duration_change(data.total_duration_,
+                                         comparison.total_duration_))},
+        {config_->GetActualDaysLabel(),
+         std::to_string(comparison.actual_active_days_)}};
+    for (const auto &delta : comparison.project_deltas_) {
+      if (delta.depth_ != 0)
+        continue;
+      items.push_back(
+          {TexUtils::escape_latex(delta.name_),
+           TexUtils::escape_latex(
+               time_format_duration(delta.baseline_duration_, 1) + ", " +
+               time_format_duration_change(delta.current_duration_,
+                                           delta.baseline_duration_))});
+    }
+
+    TexUtils::render_summary_list(ss, items, config_->GetListTopSepPt(),
+                                  config_->GetListItemSepEx());
+  }
+}
+
 // --- DLL 导出接口 ---
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_toml) {
+create_formatter_from_config(const RangeFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_toml);
-    auto tex_config = std::make_shared<RangeTexFormatterConfig>(config_tbl);
+    auto tex_config = std::make_shared<RangeTexFormatterConfig>(*config);
     auto formatter = new RangeTexFormatter(tex_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
@@ -90,14 +133,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
     delete static_cast<RangeTexFormatter *>(handle);
 }
 
-static std::string report_buffer;
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const RangeReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<RangeTexFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const RangeReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const RangeTexFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
@@ -9,7 +9,6 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <toml++/toml.hpp>
 
 /**
  * @class RangeTexFormatterConfig
@@ -17,8 +16,8 @@
  */
 class RangeTexFormatterConfig : public RangeBaseConfig {
 public:
-  explicit RangeTexFormatterConfig(const toml::table &config)
-      : RangeBaseConfig(config), style_(config) {}
+  explicit RangeTexFormatterConfig(const RangeFormatterConfig &config)
+      : RangeBaseConfig(config), style_(config.fonts, config.layout) {}
 
   // 字体与样式代理方法 (供 BaseTexFormatter 渲染导言区和项目树调用)
   // 字体与样式代理方法 (供 BaseTexFormatter 渲染导言区和项目树调用)
@@ -64,13 +63,15 @@ protected:
   bool is_empty_data(const RangeReportData &data) const override;
   int get_avg_days(const RangeReportData &data) const override;
   std::string get_no_records_msg() const override;
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const RangeReportData &data) const override;
+  // [新增] 环比 / 同比对照期 (comparisons_ 为空时不输出)
+  void format_extra_content(std::ostream &ss,
+                            const RangeReportData &data) const override;
 
 private:
   // 内部渲染逻辑 (原 RangeTexUtils)
-  void display_summary(std::stringstream &ss,
-                       const RangeReportData &data) const;
+  void display_summary(std::ostream &ss, const RangeReportData &data) const;
 };
 
 #endif // REPORTS_PRESENTATION_RANGE_FORMATTERS_LATEX_RANGE_TEX_FORMATTER_HPP_
@@ -1,9 +1,9 @@
 ﻿// reports/presentation/range/formatters/markdown/range_md_formatter.cpp
 #include "reports/presentation/range/formatters/markdown/range_md_formatter.hpp"
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
 #include <algorithm>
 #include <format>
-#include <toml++/toml.hpp>
 
 RangeMdFormatter::RangeMdFormatter(
     std::shared_ptr<RangeMdFormatterConfig> config)
@@ -31,7 +31,7 @@ std::string RangeMdFormatter::get_no_records_msg() const {
 }
 
 void RangeMdFormatter::format_header_content(
-    std::stringstream &ss, const RangeReportData &data) const {
+    std::ostream &ss, const RangeReportData &data) const {
   // 1. 标题渲染
   std::string title = data.report_name_;
   if (!config_->GetReportTitleLabel().empty()) {
@@ -56,14 +56,50 @@ void RangeMdFormatter::format_header_content(
   }
 }
 
+void RangeMdFormatter::format_extra_content(std::ostream &ss,
+                                            const RangeReportData &data) const {
+  // 每个对照期：对照期时长 + 本期相对它的变化，项目只列顶层
+  for (const auto &comparison : data.comparisons_) {
+    ss << "\n## " << comparison.label_ << "\n\n";
+    ss << "**" << comparison.start_date_ << "** "
+       << config_->GetDateRangeSeparator() << " **" << comparison.end_date_
+       << "**\n\n";
+
+    ss << "- **" << config_->GetTotalTimeLabel()
+       << "**: " << time_format_duration(comparison.total_duration_, 1) << ", "
+       << time_format_duration_change(data.total_duration_,
+                                      comparison.total_duration_)
+       << "\n";
+    ss << "- **" << config_->GetActualDaysLabel()
+       << "**: " << comparison.actual_active_days_ << "\n";
+
+    for (const auto &delta : comparison.project_deltas_) {
+      if (delta.depth_ != 0)
+        continue;
+      ss << "- " << delta.name_ << ": "
+         << time_format_duration(delta.baseline_duration_, 1) << ", "
+         << time_format_duration_change(delta.current_duration_,
+                                        delta.baseline_duration_)
+         << "\n";
+    }
+  }
+}
+
 // --- DLL 导出接口 ---
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_toml) {
+create_formatter_from_config(const RangeFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_toml);
-    // 使用本地定义的配置类
-    auto md_config = std::make_shared<RangeMdFormatterConfig>(config_tbl);
+    auto md_config = std::make_shared<RangeMdFormatterConfig>(*config);
     auto formatter = new RangeMdFormatter(md_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
@@ -77,14 +113,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
   }
 }
 
-static std::string report_buffer;
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const RangeReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<RangeMdFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const RangeReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const RangeMdFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
@@ -7,7 +7,6 @@
 #include "reports/shared/formatters/templates/base_md_formatter.hpp"
 #include <memory>
 #include <string>
-#include <toml++/toml.hpp>
 
 /**
  * @class RangeMdFormatterConfig
@@ -15,7 +14,7 @@
  */
 class RangeMdFormatterConfig : public RangeBaseConfig {
 public:
-  explicit RangeMdFormatterConfig(const toml::table &config)
+  explicit RangeMdFormatterConfig(const RangeFormatterConfig &config)
       : RangeBaseConfig(config) {}
 };
 
@@ -36,8 +35,11 @@ protected:
   std::string get_no_records_msg() const override;
 
   // 渲染头部（标题、日期范围、摘要统计）
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const RangeReportData &data) const override;
+  // [新增] 环比 / 同比对照期 (comparisons_ 为空时不输出)
+  void format_extra_content(std::ostream &ss,
+                            const RangeReportData &data) const override;
 };
 
 #endif // REPORTS_PRESENTATION_RANGE_FORMATTERS_MARKDOWN_RANGE_MD_FORMATTER_HPP_
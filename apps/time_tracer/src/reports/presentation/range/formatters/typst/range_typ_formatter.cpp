@@ -1,8 +1,8 @@
 ﻿// reports/presentation/range/formatters/typst/range_typ_formatter.cpp
 #include "reports/presentation/range/formatters/typst/range_typ_formatter.hpp"
+#include "reports/shared/api/formatter_sink_stream.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
 #include <format>
-#include <toml++/toml.hpp>
 
 RangeTypFormatter::RangeTypFormatter(
     std::shared_ptr<RangeTypFormatterConfig> config)
@@ -29,7 +29,7 @@ std::string RangeTypFormatter::get_no_records_msg() const {
   return config_->GetNoRecordsMessage();
 }
 
-void RangeTypFormatter::format_page_setup(std::stringstream &ss) const {
+void RangeTypFormatter::format_page_setup(std::ostream &ss) const {
   ss << std::format(
             R"(#set page(margin: (top: {}cm, bottom: {}cm, left: {}cm, right: {}cm)))",
             config_->GetMarginTopCm(), config_->GetMarginBottomCm(),
@@ -38,7 +38,7 @@ void RangeTypFormatter::format_page_setup(std::stringstream &ss) const {
 }
 
 void RangeTypFormatter::format_header_content(
-    std::stringstream &ss, const RangeReportData &data) const {
+    std::ostream &ss, const RangeReportData &data) const {
   // 1. Title
   std::string full_title = data.report_name_;
   if (!config_->GetReportTitleLabel().empty()) {
@@ -66,14 +66,54 @@ void RangeTypFormatter::format_header_content(
   }
 }
 
+void RangeTypFormatter::format_extra_content(
+    std::ostream &ss, const RangeReportData &data) const {
+  // 每个对照期：对照期时长 + 本期相对它的变化，项目只列顶层
+  for (const auto &comparison : data.comparisons_) {
+    ss << std::format(R"(#text(font: "{}", size: {}pt)[= {}])",
+                      config_->GetCategoryTitleFont(),
+                      config_->GetCategoryTitleFontSize(), comparison.label_)
+       << "\n\n";
+    ss << std::format(R"(#text(style: "italic")[{} {} {}])",
+                      comparison.start_date_, config_->GetDateRangeSeparator(),
+                      comparison.end_date_)
+       << "\n\n";
+
+    ss << std::format(
+        "+ *{}:* {}, {}\n", config_->GetTotalTimeLabel(),
+        time_format_duration(comparison.total_duration_, 1),
+        time_format_duration_change(data.total_duration_,
+                                    comparison.total_duration_));
+    ss << std::format("+ *{}:* {}\n", config_->GetActualDaysLabel(),
+                      comparison.actual_active_days_);
+    for (const auto &delta : comparison.project_deltas_) {
+      if (delta.depth_ != 0)
+        continue;
+      ss << std::format(
+          "+ {}: {}, {}\n", delta.name_,
+          time_format_duration(delta.baseline_duration_, 1),
+          time_format_duration_change(delta.current_duration_,
+                                      delta.baseline_duration_));
+    }
+    ss << "\n";
+  }
+}
+
 // --- DLL Exports ---
 extern "C" {
+// [新增] 报表数据以 C++ 引用传入，Host 据此拒绝布局不一致的插件
+__declspec(dllexport) uint32_t formatter_data_abi_version() {
+  return FORMATTER_DATA_ABI_VERSION;
+}
+
 __declspec(dllexport) FormatterHandle
-create_formatter(const char *config_toml) {
+create_formatter_from_config(const RangeFormatterConfig *config) {
+  // [修改] 直接读取 Host 打包的 C 结构体，版本不符时返回 nullptr
+  if (!FormatterConfigAbi::is_compatible(config)) {
+    return nullptr;
+  }
   try {
-    auto config_tbl = toml::parse(config_toml);
-    // 修改实例化时的类名
-    auto typ_config = std::make_shared<RangeTypFormatterConfig>(config_tbl);
+    auto typ_config = std::make_shared<RangeTypFormatterConfig>(*config);
     auto formatter = new RangeTypFormatter(typ_config);
     return static_cast<FormatterHandle>(formatter);
   } catch (...) {
@@ -86,14 +126,23 @@ __declspec(dllexport) void destroy_formatter(FormatterHandle handle) {
     delete static_cast<RangeTypFormatter *>(handle);
 }
 
-static std::string report_buffer;
-__declspec(dllexport) const char *format_report(FormatterHandle handle,
-                                                const RangeReportData &data) {
-  if (handle) {
-    auto *formatter = static_cast<RangeTypFormatter *>(handle);
-    report_buffer = formatter->format_report(data);
-    return report_buffer.c_str();
+// [修改] v2 协议：经 FormatterSinkStreamBuf 分块写入调用方提供的 sink，
+// 不使用静态缓冲区，也不在插件内拼接完整报表
+__declspec(dllexport) int
+format_report_into(FormatterHandle handle, const RangeReportData &data,
+                   const FormatterOutputSink *sink) {
+  if (!handle || !sink || !sink->append) {
+    return FORMATTER_STATUS_INVALID_ARGUMENT;
+  }
+  try {
+    const auto *formatter = static_cast<const RangeTypFormatter *>(handle);
+    FormatterSinkStreamBuf buffer(*sink);
+    std::ostream out(&buffer);
+    formatter->format_report_to(out, data);
+    out.flush();
+    return out ? FORMATTER_STATUS_OK : FORMATTER_STATUS_FAILED;
+  } catch (...) {
+    return FORMATTER_STATUS_FAILED;
   }
-  return "";
 }
 }
@@ -7,7 +7,6 @@
 #include "reports/shared/formatters/templates/base_typ_formatter.hpp"
 #include <memory>
 #include <string>
-#include <toml++/toml.hpp>
 
 /**
  * @class RangeTypFormatterConfig
@@ -16,32 +15,29 @@
  */
 class RangeTypFormatterConfig : public RangeBaseConfig {
 public:
-  explicit RangeTypFormatterConfig(const toml::table &config)
+  explicit RangeTypFormatterConfig(const RangeFormatterConfig &config)
       : RangeBaseConfig(config) {
-    // [修复] 直接从根节点读取，并不再期待 [typst] 子表
-    // 键名必须与 ConfigTomlSerializer::to_toml_string(RangeReportConfig)
-    // 中保持一致
+    // [修改] 字段与 ConfigAbiPacker::PackedRangeConfig 一一对应
 
     // 1. 标题样式
-    title_font_ = config["title_font"].value_or<std::string>("Noto Serif SC");
-    title_font_size_ = config["report_title_font_size"].value_or<int>(18);
+    title_font_ = FormatterConfigAbi::to_string(config.fonts.title_font);
+    title_font_size_ = config.fonts.report_title_font_size;
 
     // 2. 基础正文样式 (BaseTypFormatter 依赖)
-    base_font_ = config["base_font"].value_or<std::string>("Noto Serif SC");
-    base_font_size_ = config["base_font_size"].value_or<int>(11);
-    line_spacing_em_ = config["line_spacing_em"].value_or<double>(0.65);
+    base_font_ = FormatterConfigAbi::to_string(config.fonts.base_font);
+    base_font_size_ = config.fonts.base_font_size;
+    line_spacing_em_ = config.layout.line_spacing_em;
 
     // 3. 章节/分类标题样式 (BaseTypFormatter 依赖)
     category_title_font_ =
-        config["category_title_font"].value_or<std::string>("Noto Serif SC");
-    category_title_font_size_ =
-        config["category_title_font_size"].value_or<int>(14);
+        FormatterConfigAbi::to_string(config.fonts.category_title_font);
+    category_title_font_size_ = config.fonts.category_title_font_size;
 
     // 4. 页面边距
-    margin_top_ = config["margin_top_cm"].value_or<double>(2.5);
-    margin_bottom_ = config["margin_bottom_cm"].value_or<double>(2.5);
-    margin_left_ = config["margin_left_cm"].value_or<double>(2.5);
-    margin_right_ = config["margin_right_cm"].value_or<double>(2.5);
+    margin_top_ = config.layout.margin_top_cm;
+    margin_bottom_ = config.layout.margin_bottom_cm;
+    margin_left_ = config.layout.margin_left_cm;
+    margin_right_ = config.layout.margin_right_cm;
   }
 
   // --- 供本地 Formatter 使用的接口 ---
@@ -97,9 +93,12 @@ protected:
   int get_avg_days(const RangeReportData &data) const override;
   std::string get_no_records_msg() const override;
 
-  void format_header_content(std::stringstream &ss,
+  void format_header_content(std::ostream &ss,
                              const RangeReportData &data) const override;
-  void format_page_setup(std::stringstream &ss) const override;
+  // [新增] 环比 / 同比对照期 (comparisons_ 为空时不输出)
+  void format_extra_content(std::ostream &ss,
+                            const RangeReportData &data) const override;
+  void format_page_setup(std::ostream &ss) const override;
 };
 
 #endif // REPORTS_PRESENTATION_RANGE_FORMATTERS_TYPST_RANGE_TYP_FORMATTER_HPP_
@@ -0,0 +1,150 @@
+﻿// reports/shared/api/formatter_config_abi.hpp
+#ifndef REPORTS_SHARED_API_FORMATTER_CONFIG_ABI_HPP_
+#define REPORTS_SHARED_API_FORMATTER_CONFIG_ABI_HPP_
+
+#include <stdint.h>
+
+// ----------------------------------------------------------------------
+// [新增] 格式化器插件的二进制配置接口 (C ABI)
+//
+// Host 把 DailyReportConfig / RangeReportConfig 打包成下面的 POD 结构体，
+// 所有字符串都是指向同一块 arena 的 (data, size) 视图 (以 '\0' 结尾)，
+// 插件在 create_formatter_from_config 内直接读取字段，无需再解析 TOML。
+//
+// 版本规则:
+// - abi_version 不一致时插件必须拒绝 (返回 nullptr)，Host 会回退到
+//   旧的 create_formatter(const char *toml) 接口。
+// - 只允许在结构体末尾追加字段；插件用 struct_size 判断新字段是否存在。
+// - 结构体指针及其引用的 arena 只在 create_formatter_from_config
+//   调用期间有效，插件需要自行拷贝。
+// ----------------------------------------------------------------------
+#define FORMATTER_CONFIG_ABI_VERSION 1u
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FormatterStringView {
+  const char *data;
+  uint32_t size;
+} FormatterStringView;
+
+typedef struct FormatterConfigHeader {
+  uint32_t abi_version; // == FORMATTER_CONFIG_ABI_VERSION
+  uint32_t struct_size; // sizeof(DailyFormatterConfig) 等
+} FormatterConfigHeader;
+
+typedef struct FormatterKeywordColor {
+  FormatterStringView keyword;
+  FormatterStringView color;
+} FormatterKeywordColor;
+
+// 统计项树被拍平成一个数组：前 root_count 个元素是顶层项，
+// 子项通过 [first_child, first_child + child_count) 索引同一数组。
+typedef struct FormatterStatItem {
+  FormatterStringView label;
+  FormatterStringView db_column;
+  uint32_t show;
+  uint32_t first_child;
+  uint32_t child_count;
+} FormatterStatItem;
+
+typedef struct FormatterFontConfig {
+  FormatterStringView main_font;
+  FormatterStringView cjk_main_font;
+  FormatterStringView base_font;
+  FormatterStringView title_font;          // 为空时回退到 base_font
+  FormatterStringView category_title_font; // 为空时回退到 base_font
+  int32_t base_font_size;
+  int32_t report_title_font_size;
+  int32_t category_title_font_size;
+} FormatterFontConfig;
+
+typedef struct FormatterLayoutConfig {
+  double margin_in;
+  double margin_top_cm;
+  double margin_bottom_cm;
+  double margin_left_cm;
+  double margin_right_cm;
+  double line_spacing_em;
+  double list_top_sep_pt;
+  double list_item_sep_ex;
+} FormatterLayoutConfig;
+
+// 对应 DailyReportConfig (DayMd/Tex/Typ 插件)
+typedef struct DailyFormatterConfig {
+  FormatterConfigHeader header;
+
+  FormatterStringView title_prefix;
+  FormatterStringView date_label;
+  FormatterStringView total_time_label;
+  FormatterStringView status_label;
+  FormatterStringView sleep_label;
+  FormatterStringView exercise_label;
+  FormatterStringView getup_time_label;
+  FormatterStringView remark_label;
+  FormatterStringView no_records_message;
+  FormatterStringView statistics_label;
+  FormatterStringView all_activities_label;
+  FormatterStringView activity_remark_label;
+  FormatterStringView project_breakdown_label;
+  FormatterStringView activity_connector;
+
+  FormatterFontConfig fonts;
+  FormatterLayoutConfig layout;
+
+  const FormatterKeywordColor *keyword_colors;
+  uint32_t keyword_color_count;
+
+  const FormatterStatItem *statistics_items;
+  uint32_t statistics_item_count;
+  uint32_t statistics_root_count;
+} DailyFormatterConfig;
+
+// 对应 RangeReportConfig (RangeMd/Tex/Typ 插件)
+typedef struct RangeFormatterConfig {
+  FormatterConfigHeader header;
+
+  FormatterStringView report_title_label;
+  FormatterStringView date_range_separator;
+  FormatterStringView total_time_label;
+  FormatterStringView actual_days_label;
+  FormatterStringView no_records_message;
+  FormatterStringView invalid_data_message;
+  FormatterStringView project_breakdown_label;
+
+  FormatterFontConfig fonts;
+  FormatterLayoutConfig layout;
+} RangeFormatterConfig;
+
+typedef void *(*CreateFormatterFromConfigFunc_Day)(
+    const DailyFormatterConfig *config);
+typedef void *(*CreateFormatterFromConfigFunc_Range)(
+    const RangeFormatterConfig *config);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+#include <string_view>
+
+namespace FormatterConfigAbi {
+inline std::string_view view(FormatterStringView sv) {
+  return sv.data ? std::string_view(sv.data, sv.size) : std::string_view();
+}
+
+inline std::string to_string(FormatterStringView sv) {
+  return std::string(view(sv));
+}
+
+// 插件端的版本检查：主版本一致且结构体不小于插件编译时的大小
+template <typename ConfigStruct>
+inline bool is_compatible(const ConfigStruct *config) {
+  return config != nullptr &&
+         config->header.abi_version == FORMATTER_CONFIG_ABI_VERSION &&
+         config->header.struct_size >= sizeof(ConfigStruct);
+}
+} // namespace FormatterConfigAbi
+#endif
+
+#endif // REPORTS_SHARED_API_FORMATTER_CONFIG_ABI_HPP_
@@ -0,0 +1,68 @@
+﻿// reports/shared/api/formatter_sink_stream.hpp
+#ifndef REPORTS_SHARED_API_FORMATTER_SINK_STREAM_HPP_
+#define REPORTS_SHARED_API_FORMATTER_SINK_STREAM_HPP_
+
+#include "reports/shared/interfaces/i_report_formatter.hpp"
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+/**
+ * @class FormatterSinkStreamBuf
+ * @brief 把 FormatterOutputSink 适配为 std::streambuf (插件侧使用)。
+ * @details
+ * 格式化器直接向 std::ostream 写入，内容先落在固定大小的缓冲区，
+ * 满后整块交给 sink->append；不小于缓冲区的单次写入直接转交。
+ * 插件内因此不再拼接完整报表，内存占用与报表大小无关。
+ * sink 须在本对象生存期内有效；未刷新的内容在析构时写出。
+ */
+class FormatterSinkStreamBuf : public std::streambuf {
+public:
+  explicit FormatterSinkStreamBuf(const FormatterOutputSink &sink)
+      : sink_(sink) {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  }
+  ~FormatterSinkStreamBuf() override { flush_buffer(); }
+
+  FormatterSinkStreamBuf(const FormatterSinkStreamBuf &) = delete;
+  FormatterSinkStreamBuf &operator=(const FormatterSinkStreamBuf &) = delete;
+
+protected:
+  int_type overflow(int_type ch) override {
+    flush_buffer();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(const char *data, std::streamsize size) override {
+    if (size < static_cast<std::streamsize>(buffer_.size())) {
+      return std::streambuf::xsputn(data, size);
+    }
+    flush_buffer();
+    sink_.append(sink_.context, data, static_cast<size_t>(size));
+    return size;
+  }
+
+  int sync() override {
+    flush_buffer();
+    return 0;
+  }
+
+private:
+  void flush_buffer() {
+    const std::ptrdiff_t pending = pptr() - pbase();
+    if (pending > 0) {
+      sink_.append(sink_.context, pbase(), static_cast<size_t>(pending));
+    }
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  }
+
+  const FormatterOutputSink &sink_;
+  std::array<char, 4096> buffer_{};
+};
+
+#endif // REPORTS_SHARED_API_FORMATTER_SINK_STREAM_HPP_
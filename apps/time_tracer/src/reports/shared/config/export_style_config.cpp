@@ -1,30 +1,35 @@
 ﻿// reports/shared/config/export_style_config.cpp
 #include "reports/shared/config/export_style_config.hpp"
 
-ExportStyleConfig::ExportStyleConfig(const toml::table &tbl) {
+namespace {
+std::string string_or(FormatterStringView value, const std::string &fallback) {
+  return value.size > 0 ? FormatterConfigAbi::to_string(value) : fallback;
+}
+} // namespace
+
+ExportStyleConfig::ExportStyleConfig(const FormatterFontConfig &fonts,
+                                     const FormatterLayoutConfig &layout) {
   // --- Common Settings ---
-  base_font_size_ = tbl["base_font_size"].value_or(10);
-  report_title_font_size_ = tbl["report_title_font_size"].value_or(14);
-  category_title_font_size_ = tbl["category_title_font_size"].value_or(12);
+  base_font_size_ = fonts.base_font_size;
+  report_title_font_size_ = fonts.report_title_font_size;
+  category_title_font_size_ = fonts.category_title_font_size;
 
   // --- TeX Settings ---
-  // 对应原 TexStyleConfig 逻辑
-  // 移除 value_or 后面的 <std::string> 以利用左值引用推导
-  tex_main_font_ = tbl["main_font"].value_or("");
-  tex_cjk_main_font_ = tbl["cjk_main_font"].value_or(tex_main_font_);
+  // 空字符串视为未配置，保持与原 TOML value_or 相同的回退关系
+  tex_main_font_ = FormatterConfigAbi::to_string(fonts.main_font);
+  tex_cjk_main_font_ = string_or(fonts.cjk_main_font, tex_main_font_);
 
-  tex_margin_in_ = tbl["margin_in"].value_or(1.0);
-  tex_list_top_sep_pt_ = tbl["list_top_sep_pt"].value_or(0.0);
-  tex_list_item_sep_ex_ = tbl["list_item_sep_ex"].value_or(0.0);
+  tex_margin_in_ = layout.margin_in;
+  tex_list_top_sep_pt_ = layout.list_top_sep_pt;
+  tex_list_item_sep_ex_ = layout.list_item_sep_ex;
 
   // --- Typst Settings ---
-  // 对应原 TypstStyleConfig 逻辑
-  typst_base_font_ = tbl["base_font"].value_or("");
-  typst_title_font_ = tbl["title_font"].value_or(typst_base_font_);
+  typst_base_font_ = FormatterConfigAbi::to_string(fonts.base_font);
+  typst_title_font_ = string_or(fonts.title_font, typst_base_font_);
   typst_category_title_font_ =
-      tbl["category_title_font"].value_or(typst_base_font_);
+      string_or(fonts.category_title_font, typst_base_font_);
 
-  typst_line_spacing_em_ = tbl["line_spacing_em"].value_or(0.65);
+  typst_line_spacing_em_ = layout.line_spacing_em;
 }
 
 // --- Common Getters ---
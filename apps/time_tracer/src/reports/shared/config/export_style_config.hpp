@@ -2,15 +2,17 @@
 #ifndef REPORTS_SHARED_CONFIG_EXPORT_STYLE_CONFIG_HPP_
 #define REPORTS_SHARED_CONFIG_EXPORT_STYLE_CONFIG_HPP_
 
+#include "reports/shared/api/formatter_config_abi.hpp"
 #include "reports/shared/api/shared_api.hpp"
 #include <string>
-#include <toml++/toml.hpp>
 
 DISABLE_C4251_WARNING
 
 class REPORTS_SHARED_API ExportStyleConfig {
 public:
-  explicit ExportStyleConfig(const toml::table &config);
+  // [修改] 从 C ABI 配置的字体 / 布局部分构造
+  ExportStyleConfig(const FormatterFontConfig &fonts,
+                    const FormatterLayoutConfig &layout);
 
   // --- Common (通用) ---
   int get_base_font_size() const;
@@ -37,17 +39,17 @@ private:
   int category_title_font_size_;
 
   // TeX
-  std::string tex_main_font_;     // 对应 TOML: main_font
-  std::string tex_cjk_main_font_; // 对应 TOML: cjk_main_font
-  double tex_margin_in_;          // 对应 TOML: margin_in
-  double tex_list_top_sep_pt_;    // 对应 TOML: list_top_sep_pt
-  double tex_list_item_sep_ex_;   // 对应 TOML: list_item_sep_ex
+  std::string tex_main_font_;     // 对应 fonts.main_font
+  std::string tex_cjk_main_font_; // 对应 fonts.cjk_main_font
+  double tex_margin_in_;          // 对应 layout.margin_in
+  double tex_list_top_sep_pt_;    // 对应 layout.list_top_sep_pt
+  double tex_list_item_sep_ex_;   // 对应 layout.list_item_sep_ex
 
   // Typst
-  std::string typst_base_font_;           // 对应 TOML: base_font
-  std::string typst_title_font_;          // 对应 TOML: title_font
-  std::string typst_category_title_font_; // 对应 TOML: category_title_font
-  double typst_line_spacing_em_;          // 对应 TOML: line_spacing_em
+  std::string typst_base_font_;           // 对应 fonts.base_font
+  std::string typst_title_font_;          // 对应 fonts.title_font
+  std::string typst_category_title_font_; // 对应 fonts.category_title_font
+  double typst_line_spacing_em_;          // 对应 layout.line_spacing_em
 };
 
 ENABLE_C4251_WARNING
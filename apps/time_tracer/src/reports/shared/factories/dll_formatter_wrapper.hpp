@@ -2,79 +2,78 @@
 #ifndef REPORTS_SHARED_FACTORIES_DLL_FORMATTER_WRAPPER_HPP_
 #define REPORTS_SHARED_FACTORIES_DLL_FORMATTER_WRAPPER_HPP_
 
+#include "reports/shared/api/formatter_config_abi.hpp"
+#include "reports/shared/factories/plugin_library.hpp"
 #include "reports/shared/interfaces/i_report_formatter.hpp"
+#include "reports/shared/serialization/report_config_packer.hpp"
+#include "reports/shared/serialization/report_config_serializer.hpp"
+#include "reports/shared/traits/report_traits.hpp"
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <dlfcn.h>
-#endif
-
-// 辅助宏：用于消除 -Wcast-function-type 警告
-template <typename Target, typename Source> Target cast_func_ptr(Source src) {
-  return reinterpret_cast<Target>(reinterpret_cast<void (*)()>(src));
-}
-
 template <typename ReportDataType>
 class DllFormatterWrapper : public IReportFormatter<ReportDataType> {
 public:
-  // [重命名] 参数名改为 serialized_config_content，表明这是传输用的序列化数据
-  DllFormatterWrapper(const std::string &dll_path,
-                      const std::string &serialized_config_content) {
-#ifdef _WIN32
-    dll_handle_ = LoadLibraryA(dll_path.c_str());
-    if (!dll_handle_)
-      throw std::runtime_error("Failed to load DLL: " + dll_path);
-
-    create_func_ = cast_func_ptr<CreateFormatterFunc>(
-        GetProcAddress(dll_handle_, "create_formatter"));
-    destroy_func_ = cast_func_ptr<DestroyFormatterFunc>(
-        GetProcAddress(dll_handle_, "destroy_formatter"));
-
-    if constexpr (std::is_same_v<ReportDataType, DailyReportData>) {
-      format_func_day_ = cast_func_ptr<FormatReportFunc_Day>(
-          GetProcAddress(dll_handle_, "format_report"));
-    } else if constexpr (std::is_same_v<ReportDataType, RangeReportData>) {
-      format_func_range_ = cast_func_ptr<FormatReportFunc_Range>(
-          GetProcAddress(dll_handle_, "format_report"));
+  using ConfigType = typename ReportTraits<ReportDataType>::ConfigType;
+
+  // [修改] 插件库由 PluginLibrary 按路径共享 (进程内只加载一次)，
+  // 这里只解析符号并创建格式化器实例
+  DllFormatterWrapper(std::shared_ptr<PluginLibrary> library,
+                      const ConfigType &config)
+      : library_(std::move(library)) {
+    // [新增] 报表数据按 Host 的内存布局直接传入插件。导出了版本号但与
+    // Host 不一致时任何协议都会读错数据，直接拒绝；未导出版本号的是
+    // 引入该符号之前构建的旧插件，按库串行调用并允许下面的旧协议回退
+    auto data_abi_func = cast_func_ptr<FormatterDataAbiVersionFunc>(
+        library_->symbol("formatter_data_abi_version"));
+    if (data_abi_func && data_abi_func() != FORMATTER_DATA_ABI_VERSION) {
+      throw std::runtime_error(
+          "Incompatible report data ABI in plugin: " + library_->path() +
+          " (expected version " + std::to_string(FORMATTER_DATA_ABI_VERSION) +
+          ")");
     }
-#else
-    dll_handle_ = dlopen(dll_path.c_str(), RTLD_LAZY);
-    if (!dll_handle_)
-      throw std::runtime_error("Failed to load library: " + dll_path);
+    legacy_plugin_ = !data_abi_func;
 
-    create_func_ = reinterpret_cast<CreateFormatterFunc>(
-        dlsym(dll_handle_, "create_formatter"));
-    destroy_func_ = reinterpret_cast<DestroyFormatterFunc>(
-        dlsym(dll_handle_, "destroy_formatter"));
+    destroy_func_ = cast_func_ptr<DestroyFormatterFunc>(
+        library_->symbol("destroy_formatter"));
 
+    // [修改] 优先使用可重入的 v2 接口 format_report_into，
+    // 仅在插件未导出时才回退到旧的 format_report
     if constexpr (std::is_same_v<ReportDataType, DailyReportData>) {
-      format_func_day_ = reinterpret_cast<FormatReportFunc_Day>(
-          dlsym(dll_handle_, "format_report"));
+      format_into_func_day_ = cast_func_ptr<FormatReportIntoFunc_Day>(
+          library_->symbol("format_report_into"));
+      if (!format_into_func_day_) {
+        format_func_day_ = cast_func_ptr<FormatReportFunc_Day>(
+            library_->symbol("format_report"));
+      }
     } else if constexpr (std::is_same_v<ReportDataType, RangeReportData>) {
-      format_func_range_ = reinterpret_cast<FormatReportFunc_Range>(
-          dlsym(dll_handle_, "format_report"));
+      format_into_func_range_ = cast_func_ptr<FormatReportIntoFunc_Range>(
+          library_->symbol("format_report_into"));
+      if (!format_into_func_range_) {
+        format_func_range_ = cast_func_ptr<FormatReportFunc_Range>(
+            library_->symbol("format_report"));
+      }
     }
-#endif
 
     bool format_func_loaded = false;
     if constexpr (std::is_same_v<ReportDataType, DailyReportData>) {
-      format_func_loaded = (format_func_day_ != nullptr);
+      format_func_loaded = format_into_func_day_ || format_func_day_;
     } else if constexpr (std::is_same_v<ReportDataType, RangeReportData>) {
-      format_func_loaded = (format_func_range_ != nullptr);
+      format_func_loaded = format_into_func_range_ || format_func_range_;
     }
 
-    if (!create_func_ || !destroy_func_ || !format_func_loaded) {
+    if (!destroy_func_ || !format_func_loaded) {
       throw std::runtime_error("Failed to get function pointers from DLL: " +
-                               dll_path);
+                               library_->path());
     }
 
-    // 传递序列化后的配置字符串
-    formatter_handle_ = create_func_(serialized_config_content.c_str());
+    {
+      std::unique_lock<std::mutex> lock = lock_if_legacy();
+      formatter_handle_ = create_formatter(config);
+    }
     if (!formatter_handle_) {
       throw std::runtime_error("create_formatter from DLL returned null.");
     }
@@ -84,26 +83,25 @@ public:
     if (formatter_handle_ && destroy_func_) {
       destroy_func_(formatter_handle_);
     }
-#ifdef _WIN32
-    if (dll_handle_)
-      FreeLibrary(dll_handle_);
-#else
-    if (dll_handle_)
-      dlclose(dll_handle_);
-#endif
   }
 
+  // v2 插件可被多线程同时调用；旧插件 (含未导出数据 ABI 版本的插件)
+  // 按库加锁串行执行
   std::string format_report(const ReportDataType &data) const override {
     if (formatter_handle_) {
       if constexpr (std::is_same_v<ReportDataType, DailyReportData>) {
+        if (format_into_func_day_) {
+          return format_into(format_into_func_day_, data);
+        }
         if (format_func_day_) {
-          const char *res = format_func_day_(formatter_handle_, data);
-          return res ? std::string(res) : "";
+          return format_legacy(format_func_day_, data);
         }
       } else if constexpr (std::is_same_v<ReportDataType, RangeReportData>) {
+        if (format_into_func_range_) {
+          return format_into(format_into_func_range_, data);
+        }
         if (format_func_range_) {
-          const char *res = format_func_range_(formatter_handle_, data);
-          return res ? std::string(res) : "";
+          return format_legacy(format_func_range_, data);
         }
       }
     }
@@ -111,15 +109,83 @@ public:
   }
 
 private:
-#ifdef _WIN32
-  HINSTANCE dll_handle_ = nullptr;
-#else
-  void *dll_handle_ = nullptr;
-#endif
+  // [新增] 优先使用二进制 C 结构体配置 (create_formatter_from_config)；
+  // 插件不支持该符号或拒绝当前 ABI 版本时，回退到 TOML 字符串协议
+  FormatterHandle create_formatter(const ConfigType &config) const {
+    if (void *from_config = library_->symbol("create_formatter_from_config")) {
+      FormatterHandle handle = nullptr;
+      if constexpr (std::is_same_v<ReportDataType, DailyReportData>) {
+        ConfigAbiPacker::PackedDailyConfig packed(config);
+        handle = cast_func_ptr<CreateFormatterFromConfigFunc_Day>(
+            from_config)(packed.get());
+      } else if constexpr (std::is_same_v<ReportDataType, RangeReportData>) {
+        ConfigAbiPacker::PackedRangeConfig packed(config);
+        handle = cast_func_ptr<CreateFormatterFromConfigFunc_Range>(
+            from_config)(packed.get());
+      }
+      if (handle) {
+        return handle;
+      }
+    }
+
+    auto create_func = cast_func_ptr<CreateFormatterFunc>(
+        library_->symbol("create_formatter"));
+    if (!create_func) {
+      return nullptr;
+    }
+    // 传递序列化后的配置字符串
+    std::string serialized_toml_config =
+        ConfigTomlSerializer::to_toml_string(config);
+    return create_func(serialized_toml_config.c_str());
+  }
+
+  static void append_to_string(void *context, const char *data, size_t size) {
+    static_cast<std::string *>(context)->append(data, size);
+  }
+
+  // 插件经 FormatterSinkStreamBuf 按块 (4 KB) 追加到此 std::string；
+  // 插件侧不再拼接完整报表，报表全文只在这里存在一份
+  template <typename FormatIntoFunc>
+  std::string format_into(FormatIntoFunc func,
+                          const ReportDataType &data) const {
+    std::string output;
+    const FormatterOutputSink sink{&output, &append_to_string};
+    int status = 0;
+    {
+      std::unique_lock<std::mutex> lock = lock_if_legacy();
+      status = func(formatter_handle_, data, &sink);
+    }
+    if (status != FORMATTER_STATUS_OK) {
+      throw std::runtime_error("format_report_into failed in DLL: " +
+                               library_->path() + " (status=" +
+                               std::to_string(status) + ")");
+    }
+    return output;
+  }
+
+  template <typename FormatFunc>
+  std::string format_legacy(FormatFunc func,
+                            const ReportDataType &data) const {
+    std::lock_guard<std::mutex> lock(library_->legacy_call_mutex());
+    const char *res = func(formatter_handle_, data);
+    return res ? std::string(res) : "";
+  }
+
+  // 未导出 formatter_data_abi_version 的旧插件不保证可重入，调用时持库锁
+  std::unique_lock<std::mutex> lock_if_legacy() const {
+    if (!legacy_plugin_) {
+      return {};
+    }
+    return std::unique_lock<std::mutex>(library_->legacy_call_mutex());
+  }
+
+  std::shared_ptr<PluginLibrary> library_;
+  bool legacy_plugin_ = false;
   FormatterHandle formatter_handle_ = nullptr;
-  CreateFormatterFunc create_func_ = nullptr;
   DestroyFormatterFunc destroy_func_ = nullptr;
 
+  FormatReportIntoFunc_Day format_into_func_day_ = nullptr;
+  FormatReportIntoFunc_Range format_into_func_range_ = nullptr;
   FormatReportFunc_Day format_func_day_ = nullptr;
   FormatReportFunc_Range format_func_range_ = nullptr;
 };
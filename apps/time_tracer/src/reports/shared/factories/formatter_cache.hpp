@@ -0,0 +1,49 @@
+﻿// reports/shared/factories/formatter_cache.hpp
+#ifndef REPORTS_SHARED_FACTORIES_FORMATTER_CACHE_HPP_
+#define REPORTS_SHARED_FACTORIES_FORMATTER_CACHE_HPP_
+
+#include "reports/shared/factories/generic_formatter_factory.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// [新增] 格式化器实例缓存
+// 键为 (报表格式, 配置对象地址)，数据类型由模板参数区分。
+// 由持有配置引用的服务对象拥有，因此配置在缓存生命周期内保持有效，
+// 同一服务上的批量 / 最近 N 天 / 全量导出复用同一个已创建的格式化器。
+template <typename ReportDataType> class FormatterCache {
+public:
+  using Factory = GenericFormatterFactory<ReportDataType>;
+  using ConfigType = typename Factory::ConfigType;
+  using FormatterType = typename Factory::FormatterType;
+
+  std::shared_ptr<const FormatterType> get(ReportFormat format,
+                                           const ConfigType &config) {
+    const Key key{format, &config};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = formatters_.find(key);
+    if (it != formatters_.end()) {
+      return it->second;
+    }
+
+    std::shared_ptr<const FormatterType> formatter =
+        Factory::create(format, config);
+    formatters_.emplace(key, formatter);
+    return formatter;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    formatters_.clear();
+  }
+
+private:
+  using Key = std::pair<ReportFormat, const ConfigType *>;
+
+  std::mutex mutex_;
+  std::map<Key, std::shared_ptr<const FormatterType>> formatters_;
+};
+
+#endif // REPORTS_SHARED_FACTORIES_FORMATTER_CACHE_HPP_
@@ -10,11 +10,6 @@
 #include <stdexcept>
 #include <string>
 
-// 引入 toml++ 用于序列化
-#include <toml++/toml.hpp>
-// 引入独立的序列化器头文件
-#include "reports/shared/serialization/report_config_serializer.hpp"
-
 #include "core/domain/types/report_format.hpp"
 #include "reports/shared/factories/dll_formatter_wrapper.hpp"
 #include "reports/shared/interfaces/i_report_formatter.hpp"
@@ -59,15 +54,11 @@ public:
         dll_path += ".so";
 #endif
 
-      // 2. [核心重构] 使用 ConfigTomlSerializer 生成 TOML 字符串
-      // 变量名改为 serialized_toml_config 以消除歧义
-      std::string serialized_toml_config =
-          ConfigTomlSerializer::to_toml_string(config);
-
-      // 3. 创建 Wrapper
+      // 2. 创建 Wrapper ([修改] 插件库句柄按路径在进程内共享；
+      //    配置以 C 结构体传递，旧插件由 Wrapper 回退到 TOML 字符串)
       try {
         auto wrapper = std::make_unique<DllFormatterWrapper<ReportDataType>>(
-            dll_path, serialized_toml_config);
+            PluginLibrary::acquire(dll_path), config);
         if (!wrapper) {
           throw std::runtime_error("Unknown error creating DLL wrapper");
         }
@@ -0,0 +1,92 @@
+﻿// reports/shared/factories/plugin_library.hpp
+#ifndef REPORTS_SHARED_FACTORIES_PLUGIN_LIBRARY_HPP_
+#define REPORTS_SHARED_FACTORIES_PLUGIN_LIBRARY_HPP_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// 辅助宏：用于消除 -Wcast-function-type 警告
+// [修改] 移至此处，PluginLibrary::symbol 与 DllFormatterWrapper 共用
+template <typename Target, typename Source> Target cast_func_ptr(Source src) {
+  return reinterpret_cast<Target>(reinterpret_cast<void (*)()>(src));
+}
+
+// [新增] 格式化器插件的动态库句柄
+// 同一路径在进程内只加载一次 (acquire 返回共享实例)，
+// 句柄在进程结束前保持打开，避免每份报表都 dlopen/dlclose。
+class PluginLibrary {
+public:
+  static std::shared_ptr<PluginLibrary> acquire(const std::string &path) {
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<PluginLibrary>> libraries;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = libraries.find(path);
+    if (it != libraries.end()) {
+      return it->second;
+    }
+    auto library = std::shared_ptr<PluginLibrary>(new PluginLibrary(path));
+    libraries.emplace(path, library);
+    return library;
+  }
+
+  ~PluginLibrary() {
+#ifdef _WIN32
+    if (handle_)
+      FreeLibrary(handle_);
+#else
+    if (handle_)
+      dlclose(handle_);
+#endif
+  }
+
+  PluginLibrary(const PluginLibrary &) = delete;
+  PluginLibrary &operator=(const PluginLibrary &) = delete;
+
+  // 查找导出符号，不存在时返回 nullptr
+  void *symbol(const char *name) const {
+#ifdef _WIN32
+    return cast_func_ptr<void *>(GetProcAddress(handle_, name));
+#else
+    return dlsym(handle_, name);
+#endif
+  }
+
+  const std::string &path() const { return path_; }
+
+  // [新增] 旧版 format_report 把结果写进插件内的静态缓冲区，
+  // 同一个库的所有调用都必须串行化并在解锁前拷贝出结果
+  std::mutex &legacy_call_mutex() const { return legacy_call_mutex_; }
+
+private:
+  explicit PluginLibrary(const std::string &path) : path_(path) {
+#ifdef _WIN32
+    handle_ = LoadLibraryA(path.c_str());
+    if (!handle_)
+      throw std::runtime_error("Failed to load DLL: " + path);
+#else
+    handle_ = dlopen(path.c_str(), RTLD_LAZY);
+    if (!handle_)
+      throw std::runtime_error("Failed to load library: " + path);
+#endif
+  }
+
+  std::string path_;
+  mutable std::mutex legacy_call_mutex_;
+#ifdef _WIN32
+  HINSTANCE handle_ = nullptr;
+#else
+  void *handle_ = nullptr;
+#endif
+};
+
+#endif // REPORTS_SHARED_FACTORIES_PLUGIN_LIBRARY_HPP_
@@ -1,9 +1,9 @@
 ﻿// reports/shared/formatters/base/project_tree_formatter.cpp
 #include "reports/shared/formatters/base/project_tree_formatter.hpp"
 #include "reports/shared/utils/report_time_format.hpp"
-#include <algorithm>
 #include <iomanip>
-#include <stack>
+#include <span>
+#include <stdexcept>
 #include <vector>
 
 namespace reporting {
@@ -11,11 +11,9 @@ namespace reporting {
 // 定义栈帧结构，用于将递归转换为迭代
 namespace {
 struct StackFrame {
-  const ProjectNode *node;
   int indent;
-  // 存储指向子节点的指针，避免拷贝
-  std::vector<const std::pair<const std::string, ProjectNode> *>
-      sorted_children;
+  // [修改] 直接引用树中已排好序的 CSR 子节点区间，无需拷贝或排序
+  std::span<const uint32_t> sorted_children;
   size_t current_child_index = 0;
   bool list_started = false;
 };
@@ -34,24 +32,9 @@ std::string ProjectTreeFormatter::format_project_tree(const ProjectTree &tree,
                                                       int avg_days) const {
   std::stringstream ss;
 
-  // [优化 1]：顶层节点也使用指针，避免深拷贝整个树
-  using NodePair = std::pair<const std::string, ProjectNode>;
-  std::vector<const NodePair *> sorted_top_level;
-  sorted_top_level.reserve(tree.size()); // 预分配内存
-
-  for (const auto &pair : tree) {
-    sorted_top_level.push_back(&pair);
-  }
-
-  // 对指针进行排序
-  std::sort(sorted_top_level.begin(), sorted_top_level.end(),
-            [](const NodePair *a, const NodePair *b) {
-              return a->second.duration > b->second.duration;
-            });
-
-  for (const auto *pair_ptr : sorted_top_level) {
-    const std::string &category_name = pair_ptr->first;
-    const ProjectNode &category_node = pair_ptr->second;
+  // [修改] 顶层节点在建树时已按时长降序排列
+  for (uint32_t root_index : tree.roots) {
+    const ProjectNode &category_node = tree.nodes[root_index];
 
     double percentage = (total_duration > 0)
                             ? (static_cast<double>(category_node.duration) /
@@ -60,11 +43,11 @@ std::string ProjectTreeFormatter::format_project_tree(const ProjectTree &tree,
 
     // 格式化分类标题
     ss << m_strategy->format_category_header(
-        category_name, time_format_duration(category_node.duration, avg_days),
-        percentage);
+        category_node.name,
+        time_format_duration(category_node.duration, avg_days), percentage);
 
     // 调用迭代函数生成子树
-    generate_sorted_output(ss, category_node, 0, avg_days);
+    generate_sorted_output(ss, tree, category_node, 0, avg_days);
   }
 
   return ss.str();
@@ -72,37 +55,20 @@ std::string ProjectTreeFormatter::format_project_tree(const ProjectTree &tree,
 
 // [优化 2]：使用迭代（Stack）替代递归，防止深层级导致的栈溢出
 void ProjectTreeFormatter::generate_sorted_output(std::stringstream &ss,
+                                                  const ProjectTree &tree,
                                                   const ProjectNode &root_node,
                                                   int root_indent,
                                                   int avg_days) const {
   // 如果根节点没有子节点，直接返回，避免建立栈的开销
-  if (root_node.children.empty()) {
+  if (root_node.children_count == 0) {
     return;
   }
 
-  std::stack<StackFrame> stack;
-
-  // 初始化根栈帧
-  StackFrame root_frame;
-  root_frame.node = &root_node;
-  root_frame.indent = root_indent;
-
-  // 预处理根节点的子节点排序
-  using ChildPair = std::pair<const std::string, ProjectNode>;
-  root_frame.sorted_children.reserve(root_node.children.size());
-  for (const auto &pair : root_node.children) {
-    root_frame.sorted_children.push_back(&pair);
-  }
-  std::sort(root_frame.sorted_children.begin(),
-            root_frame.sorted_children.end(),
-            [](const ChildPair *a, const ChildPair *b) {
-              return a->second.duration > b->second.duration;
-            });
-
-  stack.push(std::move(root_frame));
+  std::vector<StackFrame> stack;
+  stack.push_back({root_indent, tree.children_of(root_node)});
 
   while (!stack.empty()) {
-    StackFrame &frame = stack.top();
+    StackFrame &frame = stack.back();
 
     // 1. 处理列表开始钩子 (对应递归前的逻辑)
     if (!frame.list_started) {
@@ -114,37 +80,23 @@ void ProjectTreeFormatter::generate_sorted_output(std::stringstream &ss,
     bool pushed_new_frame = false;
 
     while (frame.current_child_index < frame.sorted_children.size()) {
-      const auto *pair_ptr = frame.sorted_children[frame.current_child_index];
-      const std::string &name = pair_ptr->first;
-      const ProjectNode &child_node = pair_ptr->second;
+      const ProjectNode &child_node =
+          tree.nodes[frame.sorted_children[frame.current_child_index]];
 
       // 移动索引，准备下一次循环处理下一个兄弟节点
       frame.current_child_index++;
 
-      if (child_node.duration > 0 || !child_node.children.empty()) {
+      if (child_node.duration > 0 || child_node.children_count > 0) {
         // 输出当前节点
         ss << m_strategy->format_tree_node(
-            name, time_format_duration(child_node.duration, avg_days),
-            frame.indent);
+            child_node.name,
+            time_format_duration(child_node.duration, avg_days), frame.indent);
 
         // 如果该节点有子节点，则压入新栈帧（模拟递归深入）
-        if (!child_node.children.empty()) {
-          StackFrame child_frame;
-          child_frame.node = &child_node;
-          child_frame.indent = frame.indent + 1;
-
-          // 排序子节点的子节点
-          child_frame.sorted_children.reserve(child_node.children.size());
-          for (const auto &child_pair : child_node.children) {
-            child_frame.sorted_children.push_back(&child_pair);
-          }
-          std::sort(child_frame.sorted_children.begin(),
-                    child_frame.sorted_children.end(),
-                    [](const ChildPair *a, const ChildPair *b) {
-                      return a->second.duration > b->second.duration;
-                    });
-
-          stack.push(std::move(child_frame));
+        if (child_node.children_count > 0) {
+          int child_indent = frame.indent + 1;
+          // 注意：push_back 可能使 frame 引用失效，之后不再使用它
+          stack.push_back({child_indent, tree.children_of(child_node)});
           pushed_new_frame = true;
           break; // 跳出内层循环，回到外层循环处理新的栈顶（即刚刚压入的子节点）
         }
@@ -157,7 +109,7 @@ void ProjectTreeFormatter::generate_sorted_output(std::stringstream &ss,
 
     // 3. 处理列表结束钩子 (对应递归后的逻辑)
     ss << m_strategy->end_children_list();
-    stack.pop(); // 弹出当前帧，回溯到上一层
+    stack.pop_back(); // 弹出当前帧，回溯到上一层
   }
 }
 
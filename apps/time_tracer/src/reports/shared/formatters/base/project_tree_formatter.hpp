@@ -50,8 +50,10 @@ public:
 private:
   std::unique_ptr<IFormattingStrategy> m_strategy;
 
-  void generate_sorted_output(std::stringstream &ss, const ProjectNode &node,
-                              int indent, int avg_days) const;
+  // [修改] 子节点顺序已在建树时按时长排好，这里只做遍历输出
+  void generate_sorted_output(std::stringstream &ss, const ProjectTree &tree,
+                              const ProjectNode &node, int indent,
+                              int avg_days) const;
 };
 
 } // namespace reporting
@@ -62,8 +62,8 @@ private:
 
 // --- Public API Implementation ---
 
-void render_title(std::stringstream &ss, const std::string &content,
-                  int font_size, bool is_subsection) {
+void render_title(std::ostream &ss, const std::string &content, int font_size,
+                  bool is_subsection) {
   ss << "{";
   ss << "\\fontsize{" << font_size << "}{" << font_size * 1.2
      << "}\\selectfont";
@@ -71,7 +71,7 @@ void render_title(std::stringstream &ss, const std::string &content,
   ss << "}\n\n";
 }
 
-void render_summary_list(std::stringstream &ss,
+void render_summary_list(std::ostream &ss,
                          const std::vector<SummaryItem> &items,
                          double top_sep_pt, double item_sep_ex) {
   if (items.empty()) {
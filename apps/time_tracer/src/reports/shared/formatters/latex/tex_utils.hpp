@@ -42,7 +42,7 @@ REPORTS_SHARED_API std::string escape_latex(const std::string &input);
  * 生成: {\fontsize{size}{size*1.2}\selectfont \section*{content}}
  * @param is_subsection 如果为 true，则使用 \subsection*，否则使用 \section*
  */
-REPORTS_SHARED_API void render_title(std::stringstream &ss,
+REPORTS_SHARED_API void render_title(std::ostream &ss,
                                      const std::string &content, int font_size,
                                      bool is_subsection = false);
 
@@ -50,9 +50,8 @@ REPORTS_SHARED_API void render_title(std::stringstream &ss,
  * @brief 渲染紧凑的摘要信息列表 (itemize 环境)
  */
 REPORTS_SHARED_API void
-render_summary_list(std::stringstream &ss,
-                    const std::vector<SummaryItem> &items, double top_sep_pt,
-                    double item_sep_ex);
+render_summary_list(std::ostream &ss, const std::vector<SummaryItem> &items,
+                    double top_sep_pt, double item_sep_ex);
 
 /**
  * @brief 将项目树格式化为 LaTeX 字符串。
@@ -19,13 +19,19 @@ public:
   explicit BaseMdFormatter(std::shared_ptr<ConfigT> config) : config_(config) {}
 
   std::string format_report(const ReportDataT &data) const override {
+    std::ostringstream ss;
+    format_report_to(ss, data);
+    return ss.str();
+  }
+
+  // [新增] 直接写入调用方的输出流 (插件经 FormatterSinkStreamBuf 写入 sink)
+  void format_report_to(std::ostream &ss, const ReportDataT &data) const {
     // 1. 数据有效性检查
     if (std::string err = validate_data(data); !err.empty()) {
-      return err + "\n"; // Markdown 通常多加个换行比较安全
+      ss << err << "\n"; // Markdown 通常多加个换行比较安全
+      return;
     }
 
-    std::stringstream ss;
-
     // 2. 头部 / 摘要
     format_header_content(ss, data);
 
@@ -37,8 +43,6 @@ public:
       format_extra_content(ss, data);
       format_project_tree_section(ss, data);
     }
-
-    return ss.str();
   }
 
 protected:
@@ -52,17 +56,17 @@ protected:
   virtual bool is_empty_data(const ReportDataT &data) const = 0;
   virtual int get_avg_days(const ReportDataT &data) const = 0;
 
-  virtual void format_header_content(std::stringstream &ss,
+  virtual void format_header_content(std::ostream &ss,
                                      const ReportDataT &data) const = 0;
 
   // [修改] 注释掉未使用参数
-  virtual void format_extra_content(std::stringstream & /*ss*/,
+  virtual void format_extra_content(std::ostream & /*ss*/,
                                     const ReportDataT & /*data*/) const {}
 
   // [修改] 改为纯虚函数，移除导致编译错误的默认实现
   virtual std::string get_no_records_msg() const = 0;
 
-  virtual void format_project_tree_section(std::stringstream &ss,
+  virtual void format_project_tree_section(std::ostream &ss,
                                            const ReportDataT &data) const {
     ss << "\n## " << config_->GetProjectBreakdownLabel() << "\n";
     ss << MarkdownFormatter::format_project_tree(
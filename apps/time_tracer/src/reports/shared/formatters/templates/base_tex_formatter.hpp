@@ -20,13 +20,19 @@ public:
       : config_(config) {}
 
   std::string format_report(const ReportDataT &data) const override {
+    std::ostringstream ss;
+    format_report_to(ss, data);
+    return ss.str();
+  }
+
+  // [新增] 直接写入调用方的输出流 (插件经 FormatterSinkStreamBuf 写入 sink)
+  void format_report_to(std::ostream &ss, const ReportDataT &data) const {
     // 1. 数据有效性检查
     if (std::string err = validate_data(data); !err.empty()) {
-      return err;
+      ss << err;
+      return;
     }
 
-    std::stringstream ss;
-
     // 2. Preamble
     ss << generate_preamble();
 
@@ -47,7 +53,6 @@ public:
 
     // 5. Postfix
     ss << generate_postfix();
-    return ss.str();
   }
 
 protected:
@@ -64,11 +69,11 @@ protected:
   // [新增] 纯虚函数，强制子类适配 Config 接口
   virtual std::string get_no_records_msg() const = 0;
 
-  virtual void format_header_content(std::stringstream &ss,
+  virtual void format_header_content(std::ostream &ss,
                                      const ReportDataT &data) const = 0;
 
   // [修改] 注释掉未使用参数
-  virtual void format_extra_content(std::stringstream & /*ss*/,
+  virtual void format_extra_content(std::ostream & /*ss*/,
                                     const ReportDataT & /*data*/) const {}
 
   virtual std::map<std::string, std::string> get_keyword_colors() const {
@@ -82,7 +87,7 @@ protected:
         get_keyword_colors());
   }
 
-  virtual void format_project_tree_section(std::stringstream &ss,
+  virtual void format_project_tree_section(std::ostream &ss,
                                            const ReportDataT &data) const {
     int title_size = config_->GetCategoryTitleFontSize();
     ss << "{";
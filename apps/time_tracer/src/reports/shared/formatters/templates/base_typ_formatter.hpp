@@ -20,8 +20,13 @@ public:
       : config_(config) {}
 
   std::string format_report(const ReportDataT &data) const override {
-    std::stringstream ss;
+    std::ostringstream ss;
+    format_report_to(ss, data);
+    return ss.str();
+  }
 
+  // [新增] 直接写入调用方的输出流 (插件经 FormatterSinkStreamBuf 写入 sink)
+  void format_report_to(std::ostream &ss, const ReportDataT &data) const {
     // 1. 页面和基础文本设置
     format_page_setup(ss);
     format_text_setup(ss);
@@ -29,7 +34,7 @@ public:
     // 2. 数据有效性检查
     if (std::string err = validate_data(data); !err.empty()) {
       ss << err << "\n";
-      return ss.str();
+      return;
     }
 
     // 3. 头部 / 摘要
@@ -43,8 +48,6 @@ public:
       format_extra_content(ss, data);
       format_project_tree_section(ss, data);
     }
-
-    return ss.str();
   }
 
 protected:
@@ -61,17 +64,17 @@ protected:
   // [新增] 纯虚函数
   virtual std::string get_no_records_msg() const = 0;
 
-  virtual void format_header_content(std::stringstream &ss,
+  virtual void format_header_content(std::ostream &ss,
                                      const ReportDataT &data) const = 0;
 
   // [修改] 注释掉未使用参数
-  virtual void format_extra_content(std::stringstream & /*ss*/,
+  virtual void format_extra_content(std::ostream & /*ss*/,
                                     const ReportDataT & /*data*/) const {}
 
   // [修改] 注释掉未使用参数
-  virtual void format_page_setup(std::stringstream & /*ss*/) const {}
+  virtual void format_page_setup(std::ostream & /*ss*/) const {}
 
-  virtual void format_text_setup(std::stringstream &ss) const {
+  virtual void format_text_setup(std::ostream &ss) const {
     std::string spacing_str =
         std::to_string(config_->GetLineSpacingEm()) + "em";
     ss << std::format(R"(#set text(font: "{}", size: {}pt, spacing: {}))",
@@ -80,7 +83,7 @@ protected:
        << "\n\n";
   }
 
-  virtual void format_project_tree_section(std::stringstream &ss,
+  virtual void format_project_tree_section(std::ostream &ss,
                                            const ReportDataT &data) const {
     // 统领性标题
     ss << std::format(R"(#text(font: "{}", size: {}pt)[= {}])",
@@ -4,6 +4,8 @@
 
 #include "reports/domain/model/daily_report_data.hpp"
 #include "reports/domain/model/range_report_data.hpp"
+#include <stddef.h>
+#include <stdint.h>
 #include <string>
 
 template <typename ReportDataType> class IReportFormatter {
@@ -20,15 +22,51 @@ extern "C" {
 typedef void *FormatterHandle;
 
 // [重命名] 显式指明参数是 TOML 格式的配置字符串
+// (旧协议，仅作为未导出 create_formatter_from_config 的插件的回退；
+//  新协议见 reports/shared/api/formatter_config_abi.hpp)
 typedef void *(*CreateFormatterFunc)(const char *toml_config_str);
 
 typedef void (*DestroyFormatterFunc)(FormatterHandle);
 
+// 旧协议：插件写入文件级静态缓冲区并返回其指针，不可重入
 typedef const char *(*FormatReportFunc_Day)(FormatterHandle,
                                             const DailyReportData &);
 typedef const char *(*FormatReportFunc_Range)(FormatterHandle,
                                               const RangeReportData &);
 
+// [新增] v2 协议 (format_report_into)：输出缓冲区由调用方持有，
+// 插件通过 append 回调追加内容，不保留任何全局状态，
+// 因此同一个 handle 可以被多个线程同时调用。
+typedef struct FormatterOutputSink {
+  void *context;
+  void (*append)(void *context, const char *data, size_t size);
+} FormatterOutputSink;
+
+enum FormatterStatus {
+  FORMATTER_STATUS_OK = 0,
+  FORMATTER_STATUS_INVALID_ARGUMENT = 1,
+  FORMATTER_STATUS_FAILED = 2,
+};
+
+// [新增] 报表数据的二进制布局版本。DailyReportData / RangeReportData 及其
+// 成员 (ProjectTree、TimeRecord 等) 以 C++ 引用直接传给插件，任一布局变化
+// 都须递增；插件经 formatter_data_abi_version 导出编译时的值，
+// Host 拒绝版本不一致的插件。未导出该符号的视为引入它之前构建的旧插件：
+// 照常加载并允许 create_formatter / format_report 旧协议回退，调用按库串行，
+// 其数据布局无法校验，须由插件构建方保证与 Host 一致。
+// 版本 2: ProjectTree 节点布局调整、RangeReportData::comparisons_、
+//         TimeRecord 起止时刻改为当日分钟数
+#define FORMATTER_DATA_ABI_VERSION 2u
+
+typedef uint32_t (*FormatterDataAbiVersionFunc)(void);
+
+typedef int (*FormatReportIntoFunc_Day)(FormatterHandle,
+                                        const DailyReportData &,
+                                        const FormatterOutputSink *);
+typedef int (*FormatReportIntoFunc_Range)(FormatterHandle,
+                                          const RangeReportData &,
+                                          const FormatterOutputSink *);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,193 @@
+﻿// reports/shared/serialization/report_config_packer.hpp
+#ifndef REPORTS_SHARED_SERIALIZATION_REPORT_CONFIG_PACKER_HPP_
+#define REPORTS_SHARED_SERIALIZATION_REPORT_CONFIG_PACKER_HPP_
+
+#include "common/config/report_config_models.hpp"
+#include "reports/shared/api/formatter_config_abi.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 将强类型的 Config Struct 打包为 formatter_config_abi.hpp 中的
+ *        POD 结构体 (替代 ConfigTomlSerializer 的 TOML 往返)。
+ *
+ * 所有字符串先写入一块连续 arena，全部写完后再回填指针，
+ * 因此打包结果在对象生命周期内保持有效。对象不可拷贝/移动，
+ * 由调用方在 create_formatter_from_config 调用期间持有。
+ */
+namespace ConfigAbiPacker {
+
+class StringArena {
+public:
+  // 记录一个待回填的视图，字符串以 '\0' 结尾追加到 arena
+  void put(FormatterStringView &dst, const std::string &value) {
+    dst.data = nullptr;
+    dst.size = static_cast<uint32_t>(value.size());
+    fixups_.emplace_back(&dst, bytes_.size());
+    bytes_.append(value);
+    bytes_.push_back('\0');
+  }
+
+  // arena 不再增长后统一回填 data 指针
+  void seal() {
+    for (auto &[dst, offset] : fixups_) {
+      dst->data = bytes_.data() + offset;
+    }
+    fixups_.clear();
+  }
+
+private:
+  std::string bytes_;
+  std::vector<std::pair<FormatterStringView *, size_t>> fixups_;
+};
+
+inline void pack_fonts(StringArena &arena, FormatterFontConfig &dst,
+                       const FontConfig &src) {
+  arena.put(dst.main_font, src.main_font_);
+  arena.put(dst.cjk_main_font, src.cjk_main_font_);
+  arena.put(dst.base_font, src.base_font_);
+  arena.put(dst.title_font, src.title_font_);
+  arena.put(dst.category_title_font, src.category_title_font_);
+  dst.base_font_size = src.base_font_size_;
+  dst.report_title_font_size = src.report_title_font_size_;
+  dst.category_title_font_size = src.category_title_font_size_;
+}
+
+inline FormatterLayoutConfig pack_layout(const LayoutConfig &src) {
+  FormatterLayoutConfig dst{};
+  dst.margin_in = src.margin_in_;
+  dst.margin_top_cm = src.margin_top_cm_;
+  dst.margin_bottom_cm = src.margin_bottom_cm_;
+  dst.margin_left_cm = src.margin_left_cm_;
+  dst.margin_right_cm = src.margin_right_cm_;
+  dst.line_spacing_em = src.line_spacing_em_;
+  dst.list_top_sep_pt = src.list_top_sep_pt_;
+  dst.list_item_sep_ex = src.list_item_sep_ex_;
+  return dst;
+}
+
+inline size_t count_stat_items(const std::vector<ReportStatisticsItem> &items) {
+  size_t count = items.size();
+  for (const auto &item : items) {
+    count += count_stat_items(item.sub_items_);
+  }
+  return count;
+}
+
+class PackedDailyConfig {
+public:
+  explicit PackedDailyConfig(const DailyReportConfig &cfg) : config_{} {
+    config_.header.abi_version = FORMATTER_CONFIG_ABI_VERSION;
+    config_.header.struct_size = sizeof(DailyFormatterConfig);
+
+    const auto &labels = cfg.labels_;
+    arena_.put(config_.title_prefix, labels.report_title_prefix_);
+    arena_.put(config_.date_label, labels.date_label_);
+    arena_.put(config_.total_time_label, labels.total_time_label_);
+    arena_.put(config_.status_label, labels.status_label_);
+    arena_.put(config_.sleep_label, labels.sleep_label_);
+    arena_.put(config_.exercise_label, labels.exercise_label_);
+    arena_.put(config_.getup_time_label, labels.getup_time_label_);
+    arena_.put(config_.remark_label, labels.remark_label_);
+    arena_.put(config_.no_records_message, labels.no_records_message_);
+    arena_.put(config_.statistics_label, labels.statistics_label_);
+    arena_.put(config_.all_activities_label, labels.all_activities_label_);
+    arena_.put(config_.activity_remark_label, labels.activity_remark_label_);
+    arena_.put(config_.project_breakdown_label,
+               labels.project_breakdown_label_);
+    arena_.put(config_.activity_connector, labels.activity_connector_);
+
+    pack_fonts(arena_, config_.fonts, cfg.fonts_);
+    config_.layout = pack_layout(cfg.layout_);
+
+    // 先定长，再写入，保证 arena 回填的目标地址稳定
+    keyword_colors_.resize(cfg.keyword_colors_.size());
+    size_t index = 0;
+    for (const auto &[keyword, color] : cfg.keyword_colors_) {
+      arena_.put(keyword_colors_[index].keyword, keyword);
+      arena_.put(keyword_colors_[index].color, color);
+      ++index;
+    }
+
+    stat_items_.resize(count_stat_items(cfg.statistics_items_));
+    size_t next_free = cfg.statistics_items_.size();
+    pack_stat_level(cfg.statistics_items_, 0, next_free);
+
+    arena_.seal();
+
+    config_.keyword_colors = keyword_colors_.data();
+    config_.keyword_color_count = static_cast<uint32_t>(keyword_colors_.size());
+    config_.statistics_items = stat_items_.data();
+    config_.statistics_item_count = static_cast<uint32_t>(stat_items_.size());
+    config_.statistics_root_count =
+        static_cast<uint32_t>(cfg.statistics_items_.size());
+  }
+
+  PackedDailyConfig(const PackedDailyConfig &) = delete;
+  PackedDailyConfig &operator=(const PackedDailyConfig &) = delete;
+
+  const DailyFormatterConfig *get() const { return &config_; }
+
+private:
+  // 同一层的兄弟节点连续存放在 [first, first + items.size())，
+  // 子层从 next_free 开始分配
+  void pack_stat_level(const std::vector<ReportStatisticsItem> &items,
+                       size_t first, size_t &next_free) {
+    for (size_t i = 0; i < items.size(); ++i) {
+      const auto &item = items[i];
+      FormatterStatItem &dst = stat_items_[first + i];
+      arena_.put(dst.label, item.label_);
+      arena_.put(dst.db_column, item.db_column_);
+      dst.show = item.show_ ? 1U : 0U;
+      dst.first_child = static_cast<uint32_t>(next_free);
+      dst.child_count = static_cast<uint32_t>(item.sub_items_.size());
+
+      size_t child_first = next_free;
+      next_free += item.sub_items_.size();
+      pack_stat_level(item.sub_items_, child_first, next_free);
+    }
+  }
+
+  StringArena arena_;
+  DailyFormatterConfig config_;
+  std::vector<FormatterKeywordColor> keyword_colors_;
+  std::vector<FormatterStatItem> stat_items_;
+};
+
+class PackedRangeConfig {
+public:
+  explicit PackedRangeConfig(const RangeReportConfig &cfg) : config_{} {
+    config_.header.abi_version = FORMATTER_CONFIG_ABI_VERSION;
+    config_.header.struct_size = sizeof(RangeFormatterConfig);
+
+    const auto &labels = cfg.labels_;
+    arena_.put(config_.report_title_label, labels.report_title_label_);
+    arena_.put(config_.date_range_separator, labels.date_range_separator_);
+    arena_.put(config_.total_time_label, labels.total_time_label_);
+    arena_.put(config_.actual_days_label, labels.actual_days_label_);
+    arena_.put(config_.no_records_message, labels.no_records_message_);
+    arena_.put(config_.invalid_data_message, labels.invalid_data_message_);
+    arena_.put(config_.project_breakdown_label,
+               labels.project_breakdown_label_);
+
+    pack_fonts(arena_, config_.fonts, cfg.fonts_);
+    config_.layout = pack_layout(cfg.layout_);
+
+    arena_.seal();
+  }
+
+  PackedRangeConfig(const PackedRangeConfig &) = delete;
+  PackedRangeConfig &operator=(const PackedRangeConfig &) = delete;
+
+  const RangeFormatterConfig *get() const { return &config_; }
+
+private:
+  StringArena arena_;
+  RangeFormatterConfig config_;
+};
+
+} // namespace ConfigAbiPacker
+
+#endif // REPORTS_SHARED_SERIALIZATION_REPORT_CONFIG_PACKER_HPP_
@@ -61,6 +61,30 @@ std::string time_format_duration(long long total_seconds, int avg_days) {
   return main_duration_str;
 }
 
+std::string time_format_duration_change(long long current_seconds,
+                                        long long baseline_seconds) {
+  const long long delta = current_seconds - baseline_seconds;
+  std::string result = (delta >= 0 ? "+" : "-") +
+                       time_format_duration(delta >= 0 ? delta : -delta, 1);
+  if (baseline_seconds > 0) {
+    char ratio[32];
+    std::snprintf(ratio, sizeof(ratio), " (%+.1f%%)",
+                  100.0 * static_cast<double>(delta) /
+                      static_cast<double>(baseline_seconds));
+    result += ratio;
+  }
+  return result;
+}
+
+std::string time_format_clock(int minute_of_day) {
+  if (minute_of_day < 0)
+    return "";
+  char clock[8];
+  std::snprintf(clock, sizeof(clock), "%02d:%02d", minute_of_day / 60,
+                minute_of_day % 60);
+  return clock;
+}
+
 // 内部辅助函数，未暴露在头文件
 std::string add_days_to_date_str(std::string date_str, int days) {
   if (date_str.length() != 10)
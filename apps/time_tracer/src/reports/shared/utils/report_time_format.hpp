@@ -28,6 +28,15 @@ get_recent_dates(int days);
 REPORTS_SHARED_API std::string time_format_duration(long long total_seconds,
                                                     int avg_days);
 
+// [新增] 对照报表的变化量，例如 "+1h 30m (+25.0%)"
+// 对照期为 0 时无法计算比例，只输出变化量
+REPORTS_SHARED_API std::string
+time_format_duration_change(long long current_seconds,
+                            long long baseline_seconds);
+
+// [新增] 当日分钟数 -> "HH:MM"；负数 (缺失) 返回空串
+REPORTS_SHARED_API std::string time_format_clock(int minute_of_day);
+
 // [修复] 添加缺失的声明
 // 获取月份日期范围, 返回 {start_date, end_date, days_in_month}
 REPORTS_SHARED_API std::tuple<std::string, std::string, int>
@@ -1,9 +1,8 @@
 ﻿// validator/txt/facade/text_validator.cpp
 #include "validator/txt/facade/text_validator.hpp"
-#include "common/utils/string_utils.hpp"
+#include "common/utils/log_line_tokenizer.hpp"
 #include "validator/txt/rules/line_rules.hpp"
 #include "validator/txt/rules/structure_rules.hpp"
-#include <sstream>
 
 namespace validator {
 namespace txt {
@@ -11,9 +10,11 @@ namespace txt {
 struct TextValidator::PImpl {
   LineRules line_processor;
   StructureRules structural_validator;
+  std::string remark_prefix;
 
   PImpl(const ConverterConfig &config)
-      : line_processor(config) {} // 将 Config 传递给 LineRules
+      : line_processor(config), // 将 Config 传递给 LineRules
+        remark_prefix(config.parser_config_.remark_prefix_) {}
 };
 
 TextValidator::TextValidator(const ConverterConfig &config)
@@ -24,41 +25,14 @@ TextValidator::~TextValidator() = default;
 bool TextValidator::validate(const std::string & /*filename*/,
                              const std::string &content,
                              std::set<Error> &errors) {
-  pimpl_->structural_validator.reset();
+  begin();
 
-  std::stringstream ss(content);
-  std::string line;
-  int line_number = 0;
+  // [修改] 与 TextParser 共用 LogLineTokenizer，直接在内容缓冲区上切分
+  LogLineTokenizer tokenizer(content, pimpl_->remark_prefix);
+  LogLineToken token;
 
-  while (std::getline(ss, line)) {
-    line_number++;
-    std::string trimmed_line = Trim(line);
-    if (trimmed_line.empty())
-      continue;
-
-    if (pimpl_->line_processor.is_year(trimmed_line)) {
-      pimpl_->structural_validator.process_year_line(line_number, trimmed_line,
-                                                     errors);
-    } else if (pimpl_->line_processor.is_date(trimmed_line)) {
-      pimpl_->structural_validator.process_date_line(line_number, trimmed_line,
-                                                     errors);
-    } else if (pimpl_->line_processor.is_remark(trimmed_line)) {
-      pimpl_->structural_validator.process_remark_line(line_number,
-                                                       trimmed_line, errors);
-    } else if (pimpl_->line_processor.is_valid_event_line(
-                   trimmed_line, line_number, errors)) {
-      pimpl_->structural_validator.process_event_line(line_number, trimmed_line,
-                                                      errors);
-    } else {
-      pimpl_->structural_validator.process_unrecognized_line(
-          line_number, trimmed_line, errors);
-    }
-
-    if (!pimpl_->structural_validator.has_seen_year() &&
-        !pimpl_->line_processor.is_year(trimmed_line)) {
-      errors.insert({line_number,
-                     "The file must start with a year header (e.g., 'y2025').",
-                     ErrorType::Source_MissingYearHeader});
+  while (tokenizer.Next(token)) {
+    if (!process_line(token, errors)) {
       return false;
     }
   }
@@ -66,5 +40,36 @@ bool TextValidator::validate(const std::string & /*filename*/,
   return errors.empty();
 }
 
+void TextValidator::begin() { pimpl_->structural_validator.reset(); }
+
+bool TextValidator::process_line(const LogLineToken &token,
+                                 std::set<Error> &errors) {
+  const int line_number = token.line_number;
+  const std::string_view line = token.text;
+
+  if (pimpl_->line_processor.is_year(token)) {
+    pimpl_->structural_validator.process_year_line(line_number, line, errors);
+  } else if (pimpl_->line_processor.is_date(token)) {
+    pimpl_->structural_validator.process_date_line(line_number, line, errors);
+  } else if (pimpl_->line_processor.is_remark(token)) {
+    pimpl_->structural_validator.process_remark_line(line_number, line,
+                                                     errors);
+  } else if (pimpl_->line_processor.is_valid_event_line(token, errors)) {
+    pimpl_->structural_validator.process_event_line(line_number, line, errors);
+  } else {
+    pimpl_->structural_validator.process_unrecognized_line(line_number, line,
+                                                           errors);
+  }
+
+  if (!pimpl_->structural_validator.has_seen_year() &&
+      !pimpl_->line_processor.is_year(token)) {
+    errors.insert({line_number,
+                   "The file must start with a year header (e.g., 'y2025').",
+                   ErrorType::Source_MissingYearHeader});
+    return false;
+  }
+  return true;
+}
+
 } // namespace txt
 } // namespace validator
@@ -3,6 +3,7 @@
 #define VALIDATOR_TXT_FACADE_TEXT_VALIDATOR_HPP_
 
 #include "common/config/models/converter_config_models.hpp"
+#include "common/utils/log_line_tokenizer.hpp"
 #include "validator/common/validator_utils.hpp"
 
 #include <memory>
@@ -21,6 +22,11 @@ public:
   bool validate(const std::string &filename, const std::string &content,
                 std::set<Error> &errors);
 
+  // [新增] 逐行接口：单遍 (验证+转换) 模式下由解析器喂入已切分的行。
+  // 使用前调用 begin()；process_line 返回 false 表示该文件应停止验证。
+  void begin();
+  bool process_line(const LogLineToken &token, std::set<Error> &errors);
+
 private:
   struct PImpl;
   std::unique_ptr<PImpl> pimpl_;
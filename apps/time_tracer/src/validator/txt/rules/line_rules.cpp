@@ -1,7 +1,5 @@
 ﻿// validator/txt/rules/line_rules.cpp
 #include "validator/txt/rules/line_rules.hpp"
-#include "common/utils/string_utils.hpp"
-#include <algorithm>
 
 namespace validator {
 namespace txt {
@@ -22,62 +20,38 @@ LineRules::LineRules(const ConverterConfig &config) : config_(config) {
     valid_event_keywords_.insert(pair.first);
 }
 
-bool LineRules::is_year(const std::string &line) const {
-  if (line.length() != 5 || line[0] != 'y')
-    return false;
-  return std::all_of(line.begin() + 1, line.end(), ::isdigit);
+bool LineRules::is_year(const LogLineToken &token) const {
+  return token.kind == LogLineKind::Year;
 }
 
-bool LineRules::is_date(const std::string &line) const {
-  return line.length() == 4 && std::all_of(line.begin(), line.end(), ::isdigit);
+bool LineRules::is_date(const LogLineToken &token) const {
+  return token.kind == LogLineKind::Date;
 }
 
-bool LineRules::is_remark(const std::string &line) const {
-  const std::string &prefix = config_.parser_config_.remark_prefix_;
-  if (prefix.empty() || line.rfind(prefix, 0) != 0)
-    return false;
-  return !Trim(line.substr(prefix.length())).empty();
+bool LineRules::is_remark(const LogLineToken &token) const {
+  return token.kind == LogLineKind::Remark &&
+         !TrimView(token.remark_body).empty();
 }
 
-bool LineRules::is_valid_event_line(const std::string &line, int line_number,
+bool LineRules::is_valid_event_line(const LogLineToken &token,
                                     std::set<Error> &errors) const {
-  if (line.length() < 5 ||
-      !std::all_of(line.begin(), line.begin() + 4, ::isdigit)) {
+  if (token.kind != LogLineKind::Event) {
     return false;
   }
-  try {
-    int hh = std::stoi(line.substr(0, 2));
-    int mm = std::stoi(line.substr(2, 2));
-    if (hh > 23 || mm > 59)
-      return false;
-
-    // 简单的解析逻辑，提取描述部分
-    std::string remaining_line = line.substr(4);
-    std::string description;
-    size_t comment_pos = std::string::npos;
-    const char *delimiters[] = {"//", "#", ";"};
-    for (const char *delim : delimiters) {
-      size_t pos = remaining_line.find(delim);
-      if (pos != std::string::npos &&
-          (comment_pos == std::string::npos || pos < comment_pos)) {
-        comment_pos = pos;
-      }
-    }
-    description = Trim(remaining_line.substr(0, comment_pos));
-
-    if (description.empty())
-      return false;
+  if (token.hour > 23 || token.minute > 59)
+    return false;
 
-    if (wake_keywords_.count(description) == 0 &&
-        valid_event_keywords_.count(description) == 0) {
-      errors.insert({line_number,
-                     "Unrecognized activity '" + description + "'.",
-                     ErrorType::UnrecognizedActivity});
-    }
-    return true;
-  } catch (...) {
+  if (token.description.empty())
     return false;
+
+  if (!wake_keywords_.contains(token.description) &&
+      !valid_event_keywords_.contains(token.description)) {
+    errors.insert({token.line_number,
+                   "Unrecognized activity '" + std::string(token.description) +
+                       "'.",
+                   ErrorType::UnrecognizedActivity});
   }
+  return true;
 }
 
 } // namespace txt
@@ -3,9 +3,11 @@
 #define VALIDATOR_TXT_RULES_LINE_RULES_HPP_
 
 #include "common/config/models/converter_config_models.hpp"
+#include "common/utils/log_line_tokenizer.hpp"
 #include "validator/common/validator_utils.hpp"
 #include <set>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 
 namespace validator {
@@ -15,17 +17,28 @@ class LineRules {
 public:
   explicit LineRules(const ConverterConfig &config);
 
-  bool is_year(const std::string &line) const;
-  bool is_date(const std::string &line) const;
-  bool is_remark(const std::string &line) const;
+  // [修改] 输入为共享 LogLineTokenizer 的切分结果，不再自行解析整行
+  bool is_year(const LogLineToken &token) const;
+  bool is_date(const LogLineToken &token) const;
+  bool is_remark(const LogLineToken &token) const;
 
-  bool is_valid_event_line(const std::string &line, int line_number,
+  bool is_valid_event_line(const LogLineToken &token,
                            std::set<Error> &errors) const;
 
 private:
   const ConverterConfig &config_;
-  std::unordered_set<std::string> valid_event_keywords_;
-  std::unordered_set<std::string> wake_keywords_;
+  // 透明哈希，允许直接以 string_view 查找
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+  using KeywordSet =
+      std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+  KeywordSet valid_event_keywords_;
+  KeywordSet wake_keywords_;
 };
 
 } // namespace txt
@@ -1,5 +1,6 @@
 ﻿// validator/txt/rules/structure_rules.cpp
 #include "validator/txt/rules/structure_rules.hpp"
+#include <string>
 
 namespace validator {
 namespace txt {
@@ -12,7 +13,7 @@ void StructureRules::reset() {
   last_seen_year_ = 0;
 }
 
-void StructureRules::process_year_line(int line_number, const std::string &line,
+void StructureRules::process_year_line(int line_number, std::string_view line,
                                        std::set<Error> &errors) {
   // [修复]
   // 防止编译器报未使用参数错误（即便后面使用了，某些分支返回可能导致警告）
@@ -28,7 +29,7 @@ void StructureRules::process_year_line(int line_number, const std::string &line,
 
   int current_year = 0;
   try {
-    current_year = std::stoi(line.substr(1));
+    current_year = std::stoi(std::string(line.substr(1)));
   } catch (const std::exception &) {
     errors.insert({line_number, "Invalid year format.", ErrorType::Structural});
     return;
@@ -39,7 +40,7 @@ void StructureRules::process_year_line(int line_number, const std::string &line,
   has_seen_date_in_block_ = false;
 }
 
-void StructureRules::process_date_line(int line_number, const std::string &line,
+void StructureRules::process_date_line(int line_number, std::string_view line,
                                        std::set<Error> &errors) {
   if (!has_seen_year_) {
     errors.insert({line_number, "Date found before a year header.",
@@ -48,12 +49,12 @@ void StructureRules::process_date_line(int line_number, const std::string &line,
 
   if (!has_seen_any_date_) {
     if (line.length() >= 4) {
-      std::string day_part = line.substr(2, 2);
+      std::string_view day_part = line.substr(2, 2);
       if (day_part != "01") {
         errors.insert({line_number,
                        "The first date in the file must be the 1st day of the "
                        "month (e.g., 0101). Found: " +
-                           line,
+                           std::string(line),
                        ErrorType::DateContinuity});
       }
     }
@@ -65,7 +66,7 @@ void StructureRules::process_date_line(int line_number, const std::string &line,
 }
 
 void StructureRules::process_remark_line(int line_number,
-                                         const std::string & /*line*/,
+                                         std::string_view /*line*/,
                                          std::set<Error> &errors) {
   if (!has_seen_date_in_block_) {
     errors.insert(
@@ -79,7 +80,7 @@ void StructureRules::process_remark_line(int line_number,
 }
 
 void StructureRules::process_event_line(int line_number,
-                                        const std::string & /*line*/,
+                                        std::string_view /*line*/,
                                         std::set<Error> &errors) {
   if (!has_seen_date_in_block_) {
     errors.insert(
@@ -89,9 +90,10 @@ void StructureRules::process_event_line(int line_number,
 }
 
 void StructureRules::process_unrecognized_line(int line_number,
-                                               const std::string &line,
+                                               std::string_view line,
                                                std::set<Error> &errors) {
-  errors.insert({line_number, "Unrecognized line format: " + line,
+  errors.insert({line_number,
+                 "Unrecognized line format: " + std::string(line),
                  ErrorType::Source_InvalidLineFormat});
 }
 
@@ -5,6 +5,7 @@
 #include "validator/common/validator_utils.hpp"
 #include <set>
 #include <string>
+#include <string_view>
 
 namespace validator {
 namespace txt {
@@ -16,15 +17,15 @@ public:
   // 重置状态
   void reset();
 
-  void process_year_line(int line_number, const std::string &line,
+  void process_year_line(int line_number, std::string_view line,
                          std::set<Error> &errors);
-  void process_date_line(int line_number, const std::string &line,
+  void process_date_line(int line_number, std::string_view line,
                          std::set<Error> &errors);
-  void process_remark_line(int line_number, const std::string &line,
+  void process_remark_line(int line_number, std::string_view line,
                            std::set<Error> &errors);
-  void process_event_line(int line_number, const std::string &line,
+  void process_event_line(int line_number, std::string_view line,
                           std::set<Error> &errors);
-  void process_unrecognized_line(int line_number, const std::string &line,
+  void process_unrecognized_line(int line_number, std::string_view line,
                                  std::set<Error> &errors);
 
   bool has_seen_year() const;
@@ -87,6 +87,10 @@ class ExportTester(BaseTester):
         cases.extend(self._make_cases("Bulk Export All Month", ["export", "all-month"], common_args))
         cases.extend(self._make_cases("Bulk Export All Week", ["export", "all-week"], common_args))
         cases.extend(self._make_cases("Bulk Export All Year", ["export", "all-year"], common_args))
+        cases.extend(self._make_cases("Bulk Export All BiWeek", ["export", "all-biweek"], common_args))
+        cases.extend(self._make_cases("Bulk Export All Quarter", ["export", "all-quarter"], common_args))
+        cases.extend(self._make_cases("Bulk Export All Half", ["export", "all-half"], common_args))
+        cases.extend(self._make_cases("Bulk Export All Period", ["export", "all-period"], common_args))
 
         # 2. recent
         if self.specific_recent_days:
@@ -11,7 +11,8 @@ class IngestTester(BaseTester):
         
         source_path_str = str(self.ctx.source_data_path)
         tests_to_run = [
-            {"name": "Ingest (Blink)", "args": ["ingest", source_path_str], "add_output": True}
+            {"name": "Ingest (Blink)", "args": ["ingest", source_path_str], "add_output": True},
+            {"name": "Ingest + Export All Formats", "args": ["ingest-export", source_path_str], "add_output": True}
         ]
         
         for test in tests_to_run: